@@ -2,12 +2,15 @@
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
 #include "framework/typed_rpc.h"
+#include "workstation/rpc_async.h"
 #include "workstation/service.h"
 
 namespace wxz::workstation::arm_control::rpc {
@@ -15,6 +18,11 @@ namespace wxz::workstation::arm_control::rpc {
 inline constexpr std::string_view kService = "arm_control";
 inline constexpr std::string_view kOpPing = "arm.ping";
 inline constexpr std::string_view kOpCommand = "arm.command";
+inline constexpr std::string_view kOpSetTunables = "arm.set_tunables";
+inline constexpr std::string_view kOpBatch = "arm.batch";
+
+/// arm.batch 单次请求的指令条数上限（超出时整个请求失败，不执行任何指令）。
+inline constexpr std::size_t kMaxBatchCommands = 64;
 
 struct PingRequest {};
 
@@ -70,6 +78,74 @@ inline void from_json(const nlohmann::json& j, CommandReply& r) {
     if (it != j.end()) r.kv = *it;
 }
 
+/// 一次请求携带的有序指令列表；服务端在 arm_sdk_strand 上逐条连续执行，一次回复返回全部结果。
+///
+/// - stop_on_error=true：某条指令的 kv.ok 不为 "1" 时停止，其后的指令不执行
+/// - stop_on_error=false：不论成败全部执行
+/// 查询类 op（is_* 等）的 value=0 不算失败。
+struct BatchRequest {
+    std::vector<CommandRequest> commands;
+    bool stop_on_error{true};
+};
+
+/// results 与已执行的指令一一对应（stop_on_error 停止后 results 比 commands 短）。
+struct BatchReply {
+    std::vector<CommandReply> results;
+    int first_error{-1};  // 第一条失败指令的下标；全部成功为 -1
+    bool stopped{false};  // 因 stop_on_error 跳过了其后的指令
+};
+
+inline void to_json(nlohmann::json& j, const BatchRequest& r) {
+    j = nlohmann::json::object();
+    auto& cmds = j["commands"] = nlohmann::json::array();
+    for (const auto& c : r.commands) {
+        nlohmann::json item;
+        to_json(item, c);
+        cmds.push_back(std::move(item));
+    }
+    j["stop_on_error"] = r.stop_on_error;
+}
+
+inline void from_json(const nlohmann::json& j, BatchRequest& r) {
+    r = BatchRequest{};
+    if (!j.is_object()) return;
+    if (auto it = j.find("commands"); it != j.end() && it->is_array()) {
+        r.commands.reserve(it->size());
+        for (const auto& item : *it) {
+            CommandRequest c;
+            from_json(item, c);
+            r.commands.push_back(std::move(c));
+        }
+    }
+    r.stop_on_error = j.value("stop_on_error", true);
+}
+
+inline void to_json(nlohmann::json& j, const BatchReply& r) {
+    j = nlohmann::json::object();
+    auto& results = j["results"] = nlohmann::json::array();
+    for (const auto& res : r.results) {
+        nlohmann::json item;
+        to_json(item, res);
+        results.push_back(std::move(item));
+    }
+    j["first_error"] = r.first_error;
+    j["stopped"] = r.stopped;
+}
+
+inline void from_json(const nlohmann::json& j, BatchReply& r) {
+    r = BatchReply{};
+    if (auto it = j.find("results"); it != j.end() && it->is_array()) {
+        r.results.reserve(it->size());
+        for (const auto& item : *it) {
+            CommandReply c;
+            from_json(item, c);
+            r.results.push_back(std::move(c));
+        }
+    }
+    r.first_error = j.value("first_error", -1);
+    r.stopped = j.value("stopped", false);
+}
+
 // --- 便捷辅助函数（类型化 client 调用） ---
 
 inline wxz::framework::typed_rpc::Result<PingReply> ping(wxz::framework::RpcServiceClient& cli,
@@ -96,4 +172,48 @@ inline wxz::framework::typed_rpc::Result<CommandReply> command(wxz::framework::R
         cli, std::string(kOpCommand), std::move(req));
 }
 
+// 批量指令的超时需覆盖全部指令的执行时间（含运动类指令），默认超时通常不够。
+inline wxz::framework::typed_rpc::Result<BatchReply> batch(wxz::framework::RpcServiceClient& cli,
+                                                           BatchRequest req,
+                                                           std::chrono::milliseconds timeout) {
+    return wxz::framework::typed_rpc::call<BatchRequest, BatchReply>(
+        cli, std::string(kOpBatch), std::move(req), timeout);
+}
+
+inline wxz::framework::typed_rpc::Result<BatchReply> batch(wxz::framework::RpcServiceClient& cli,
+                                                           BatchRequest req) {
+    return wxz::framework::typed_rpc::call<BatchRequest, BatchReply>(
+        cli, std::string(kOpBatch), std::move(req));
+}
+
+// --- 异步辅助函数（同一线程可同时挂起多个请求；截止时间含排队，语义见 workstation/rpc_async.h） ---
+
+template <class Rep>
+using DoneCallback = std::function<void(const wxz::framework::typed_rpc::Result<Rep>&)>;
+
+inline wxz::workstation::AsyncCall<PingReply> ping_async(wxz::workstation::AsyncRpcCaller& caller,
+                                                         wxz::framework::RpcServiceClient& cli,
+                                                         std::chrono::milliseconds timeout,
+                                                         DoneCallback<PingReply> on_done = {}) {
+    return caller.call<PingRequest, PingReply>(cli, std::string(kOpPing), PingRequest{}, timeout, std::move(on_done));
+}
+
+inline wxz::workstation::AsyncCall<CommandReply> command_async(wxz::workstation::AsyncRpcCaller& caller,
+                                                               wxz::framework::RpcServiceClient& cli,
+                                                               CommandRequest req,
+                                                               std::chrono::milliseconds timeout,
+                                                               DoneCallback<CommandReply> on_done = {}) {
+    return caller.call<CommandRequest, CommandReply>(
+        cli, std::string(kOpCommand), std::move(req), timeout, std::move(on_done));
+}
+
+inline wxz::workstation::AsyncCall<BatchReply> batch_async(wxz::workstation::AsyncRpcCaller& caller,
+                                                           wxz::framework::RpcServiceClient& cli,
+                                                           BatchRequest req,
+                                                           std::chrono::milliseconds timeout,
+                                                           DoneCallback<BatchReply> on_done = {}) {
+    return caller.call<BatchRequest, BatchReply>(
+        cli, std::string(kOpBatch), std::move(req), timeout, std::move(on_done));
+}
+
 } // namespace wxz::workstation::arm_control::rpc
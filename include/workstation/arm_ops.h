@@ -0,0 +1,362 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace wxz::workstation::arm_control::ops {
+
+// arm_control 指令的编译期描述表：arm_control 的分发与 bt_service 的 BT 节点都由这张表生成。
+// 新增一个 op：在 kOps 中加一条描述，并在 arm_control 侧为其 ArmOp 绑定 handler。
+
+/// 只读数组视图（C++17 下替代 std::span）。
+template <class T>
+struct Span {
+    const T* data{nullptr};
+    std::size_t size{0};
+
+    constexpr Span() = default;
+
+    template <std::size_t N>
+    constexpr Span(const T (&arr)[N]) : data(arr), size(N) {}
+
+    constexpr const T* begin() const { return data; }
+    constexpr const T* end() const { return data + size; }
+};
+
+/// 参数的线上类型（负载中一律为字符串，类型用于说明与文档生成）。
+enum class ArgType : std::uint8_t {
+    String,
+    Bool,
+    Int,
+    Double,
+    Csv6,
+    Csv6List,  // 以 '|' 分隔的多个 Csv6（';' 已被 KV 负载占用）
+};
+
+/// 指令参数。
+struct ArgDesc {
+    std::string_view key;
+    ArgType type;
+    // arm_control 分发前校验该字段存在；BT 节点在输入缺失/为空时本地失败。
+    bool required;
+    // BT 输入未给出时下发的默认值；为空表示不下发该字段。
+    std::string_view bt_default;
+};
+
+/// BT 节点判定成功的方式。
+enum class ResultKind : std::uint8_t {
+    Status,     // ok/err_code 表示成功即可
+    BoolValue,  // 另外要求 value 为真
+    Fields,     // 读取 result_fields，写到 BT 输出端口
+};
+
+/// 响应中的结果字段。
+struct ResultField {
+    std::string_view key;
+    bool output_port;  // 作为 BT 输出端口
+    bool required;     // 为空时视为失败
+};
+
+/// BT 节点注册名，以及该节点在 /arm/command 上下发的 op 名。
+struct BtNodeName {
+    std::string_view id;
+    std::string_view wire_op;
+};
+
+/// BT 节点失败时发布的 system alert；timeout 为空表示该 op 不发 alert。
+struct AlertCodes {
+    std::string_view timeout;
+    std::string_view fail;
+    std::string_view fail_message;
+};
+
+enum class ArmOp : std::uint8_t {
+    MoveL,
+    MoveJoint,
+    PowerOn,
+    FaultReset,
+    SlowSpeed,
+    QuickStop,
+    EmergencyStop,
+    PathDownload,
+    IsArmReady,
+    IsPowerOn,
+    IsStartSignal,
+    IsStopSignal,
+    IsTrajectoryComplete,
+    IsAllTrajectoriesComplete,
+    WaitForStart,
+    ExecuteTrajectory,
+    GetJointActualPos,
+    RobotMode,
+    DemoEcho,
+    // 新增 op 追加在末尾：ArmOp 数值即 v2 线上编码。
+    MoveLStepwise,
+};
+
+struct OpDesc {
+    ArmOp id;
+    std::string_view name;
+    Span<std::string_view> aliases;
+    Span<ArgDesc> args;
+    ResultKind result;
+    Span<ResultField> result_fields;
+    bool bt_timeout_port;  // BT 节点提供 timeout_ms 输入以覆盖默认超时
+    AlertCodes alerts;
+    Span<BtNodeName> bt_nodes;
+};
+
+namespace detail {
+
+inline constexpr AlertCodes kCommandAlerts{"E_ARM_TIMEOUT", "E_ARM_EXEC_FAIL", "arm command failed"};
+inline constexpr AlertCodes kPowerOnAlerts{"E_ARM_POWER_ON_TIMEOUT", "E_ARM_POWER_ON_FAIL", "arm power_on_enable failed"};
+
+inline constexpr std::string_view kMoveLAliases[] = {"moveLine"};
+inline constexpr ArgDesc kMoveLArgs[] = {
+    {"pose", ArgType::Csv6, true, ""},
+    {"jointpos", ArgType::Csv6, true, ""},
+    {"speed", ArgType::Double, false, "30"},
+    {"acc", ArgType::Double, false, "30"},
+    {"jerk", ArgType::Double, false, "60"},
+};
+inline constexpr BtNodeName kMoveLNodes[] = {{"ArmMoveL", "moveL"}, {"MoveL", "moveL"}, {"moveL", "moveL"}};
+
+inline constexpr std::string_view kMoveJointAliases[] = {"moveJ"};
+inline constexpr ArgDesc kMoveJointArgs[] = {
+    {"jointpos", ArgType::Csv6, true, ""},
+    {"speed", ArgType::Double, false, "3.14"},
+};
+inline constexpr BtNodeName kMoveJointNodes[] = {
+    {"ArmMoveJ", "moveJoint"}, {"MoveJ", "moveJoint"}, {"moveJ", "moveJoint"}, {"moveJoint", "moveJoint"}};
+
+inline constexpr std::string_view kPowerOnAliases[] = {"power_on", "initialize_arm"};
+inline constexpr BtNodeName kPowerOnNodes[] = {{"ArmPowerOn", "power_on_enable"},
+                                               {"PowerOn", "power_on_enable"},
+                                               {"power_on_enable", "power_on_enable"},
+                                               {"InitializeArm", "power_on_enable"}};
+
+// 历史 BT 端口：简单指令节点都接受 enable（仅在给出时下发，arm 侧对不需要它的 op 忽略）。
+inline constexpr ArgDesc kOptionalEnableArgs[] = {{"enable", ArgType::Bool, false, ""}};
+inline constexpr ArgDesc kRequiredEnableArgs[] = {{"enable", ArgType::Bool, true, ""}};
+
+inline constexpr std::string_view kFaultResetAliases[] = {"reset_system"};
+inline constexpr BtNodeName kFaultResetNodes[] = {{"fault_reset", "fault_reset"},
+                                                  {"FaultReset", "fault_reset"},
+                                                  {"reset_system", "reset_system"},
+                                                  {"ResetSystem", "reset_system"}};
+
+inline constexpr std::string_view kSlowSpeedAliases[] = {"slow_speed"};
+inline constexpr BtNodeName kSlowSpeedNodes[] = {{"slow_speed", "slow_speed"}, {"slowSpeed", "slowSpeed"}};
+
+inline constexpr std::string_view kQuickStopAliases[] = {"quick_stop"};
+inline constexpr BtNodeName kQuickStopNodes[] = {{"quick_stop", "quick_stop"}, {"quickStop", "quickStop"}};
+
+inline constexpr BtNodeName kEmergencyStopNodes[] = {{"emergency_stop", "emergency_stop"},
+                                                     {"EmergencyStop", "emergency_stop"}};
+
+inline constexpr ArgDesc kPathDownloadArgs[] = {
+    {"file", ArgType::String, true, ""},
+    {"index", ArgType::Int, false, "1"},
+    {"moveType", ArgType::Int, false, "1"},
+    {"maxPoints", ArgType::Int, false, "10000"},
+};
+inline constexpr BtNodeName kPathDownloadNodes[] = {{"ArmPathDownload", "path_download"},
+                                                    {"path_download", "path_download"}};
+
+inline constexpr BtNodeName kIsArmReadyNodes[] = {{"IsArmReady", "is_arm_ready"}};
+inline constexpr BtNodeName kIsPowerOnNodes[] = {{"IsPowerOn", "is_power_on"}};
+inline constexpr BtNodeName kIsStartSignalNodes[] = {{"IsStartSignal", "is_start_signal"}};
+inline constexpr BtNodeName kIsStopSignalNodes[] = {{"IsStopSignal", "is_stop_signal"}};
+inline constexpr BtNodeName kIsTrajectoryCompleteNodes[] = {{"IsTrajectoryComplete", "is_trajectory_complete"}};
+inline constexpr BtNodeName kIsAllTrajectoriesCompleteNodes[] = {
+    {"IsAllTrajectoriesComplete", "is_all_trajectories_complete"}};
+
+// timeout_ms 同时下发给 arm_control（SDK 侧等待上限）并覆盖 BT 节点自身超时。
+inline constexpr ArgDesc kTimeoutArgs[] = {{"timeout_ms", ArgType::Int, false, ""}};
+inline constexpr BtNodeName kWaitForStartNodes[] = {{"wait_for_start", "wait_for_start"},
+                                                    {"WaitForStart", "wait_for_start"}};
+inline constexpr BtNodeName kExecuteTrajectoryNodes[] = {{"execute_trajectory", "execute_trajectory"},
+                                                         {"ExecuteTrajectory", "execute_trajectory"}};
+
+// jointpos：弧度（用于 MoveJ/MoveL）；jointpos_deg：角度（仅用于调试日志）。
+inline constexpr ResultField kJointPosFields[] = {{"jointpos", true, true}, {"jointpos_deg", false, false}};
+inline constexpr BtNodeName kJointPosNodes[] = {{"get_joint_actual_pos", "get_joint_actual_pos"},
+                                                {"GetJointActualPos", "get_joint_actual_pos"},
+                                                {"ArmGetJointActualPos", "get_joint_actual_pos"}};
+
+inline constexpr ResultField kRobotModeFields[] = {{"mode", true, false}};
+inline constexpr BtNodeName kRobotModeNodes[] = {{"get_robot_mode", "robot_mode"}, {"GetRobotMode", "robot_mode"}};
+
+inline constexpr ArgDesc kDemoEchoArgs[] = {{"msg", ArgType::String, true, ""}};
+
+// 逐点顺序执行的直线运动：每点 pointTransStop、点间停稳，不是融合的连续轨迹（没有 blend 半径参数）。
+// 名称刻意不用 batch/sequence，避免被当作连续运动使用；融合轨迹需走控制器路径（path_download + execute_trajectory）。
+// poses/jointposes 逐点对应（jointposes 只给一组时用于所有点）；速度参数对所有点生效，默认值与 moveL 相同。
+inline constexpr std::string_view kMoveLStepwiseAliases[] = {"moveLineStepwise"};
+inline constexpr ArgDesc kMoveLStepwiseArgs[] = {
+    {"poses", ArgType::Csv6List, true, ""},
+    {"jointposes", ArgType::Csv6List, true, ""},
+    {"speed", ArgType::Double, false, "30"},
+    {"acc", ArgType::Double, false, "30"},
+    {"jerk", ArgType::Double, false, "60"},
+};
+inline constexpr BtNodeName kMoveLStepwiseNodes[] = {{"ArmMoveLStepwise", "moveL_stepwise"},
+                                                     {"moveL_stepwise", "moveL_stepwise"}};
+
+} // namespace detail
+
+// 顺序必须与 ArmOp 一致（见下方 static_assert）。
+inline constexpr OpDesc kOps[] = {
+    {ArmOp::MoveL, "moveL", detail::kMoveLAliases, detail::kMoveLArgs, ResultKind::Status, {}, false,
+     detail::kCommandAlerts, detail::kMoveLNodes},
+    {ArmOp::MoveJoint, "moveJoint", detail::kMoveJointAliases, detail::kMoveJointArgs, ResultKind::Status, {},
+     false, {}, detail::kMoveJointNodes},
+    {ArmOp::PowerOn, "power_on_enable", detail::kPowerOnAliases, {}, ResultKind::Status, {}, false,
+     detail::kPowerOnAlerts, detail::kPowerOnNodes},
+    {ArmOp::FaultReset, "fault_reset", detail::kFaultResetAliases, detail::kOptionalEnableArgs,
+     ResultKind::Status, {}, true, {}, detail::kFaultResetNodes},
+    {ArmOp::SlowSpeed, "slowSpeed", detail::kSlowSpeedAliases, detail::kRequiredEnableArgs, ResultKind::Status,
+     {}, true, {}, detail::kSlowSpeedNodes},
+    {ArmOp::QuickStop, "quickStop", detail::kQuickStopAliases, detail::kRequiredEnableArgs, ResultKind::Status,
+     {}, true, {}, detail::kQuickStopNodes},
+    {ArmOp::EmergencyStop, "emergency_stop", {}, detail::kOptionalEnableArgs, ResultKind::Status, {}, true, {},
+     detail::kEmergencyStopNodes},
+    {ArmOp::PathDownload, "path_download", {}, detail::kPathDownloadArgs, ResultKind::Status, {}, false,
+     detail::kCommandAlerts, detail::kPathDownloadNodes},
+    {ArmOp::IsArmReady, "is_arm_ready", {}, {}, ResultKind::BoolValue, {}, true, {}, detail::kIsArmReadyNodes},
+    {ArmOp::IsPowerOn, "is_power_on", {}, {}, ResultKind::BoolValue, {}, true, {}, detail::kIsPowerOnNodes},
+    {ArmOp::IsStartSignal, "is_start_signal", {}, {}, ResultKind::BoolValue, {}, true, {},
+     detail::kIsStartSignalNodes},
+    {ArmOp::IsStopSignal, "is_stop_signal", {}, {}, ResultKind::BoolValue, {}, true, {},
+     detail::kIsStopSignalNodes},
+    {ArmOp::IsTrajectoryComplete, "is_trajectory_complete", {}, {}, ResultKind::BoolValue, {}, true, {},
+     detail::kIsTrajectoryCompleteNodes},
+    {ArmOp::IsAllTrajectoriesComplete, "is_all_trajectories_complete", {}, {}, ResultKind::BoolValue, {}, true,
+     {}, detail::kIsAllTrajectoriesCompleteNodes},
+    {ArmOp::WaitForStart, "wait_for_start", {}, detail::kTimeoutArgs, ResultKind::BoolValue, {}, true, {},
+     detail::kWaitForStartNodes},
+    {ArmOp::ExecuteTrajectory, "execute_trajectory", {}, detail::kTimeoutArgs, ResultKind::BoolValue, {}, true,
+     {}, detail::kExecuteTrajectoryNodes},
+    {ArmOp::GetJointActualPos, "get_joint_actual_pos", {}, {}, ResultKind::Fields, detail::kJointPosFields, true,
+     {}, detail::kJointPosNodes},
+    {ArmOp::RobotMode, "robot_mode", {}, {}, ResultKind::Fields, detail::kRobotModeFields, true, {},
+     detail::kRobotModeNodes},
+    // 模块扩展 op 的必填字段约定；arm_control 未内置 handler。
+    {ArmOp::DemoEcho, "demo_echo", {}, detail::kDemoEchoArgs, ResultKind::Status, {}, false, {}, {}},
+    {ArmOp::MoveLStepwise, "moveL_stepwise", detail::kMoveLStepwiseAliases, detail::kMoveLStepwiseArgs,
+     ResultKind::Status, {}, true, detail::kCommandAlerts, detail::kMoveLStepwiseNodes},
+};
+
+inline constexpr std::size_t kOpCount = sizeof(kOps) / sizeof(kOps[0]);
+
+namespace detail {
+
+constexpr bool ops_match_enum() {
+    for (std::size_t i = 0; i < kOpCount; ++i) {
+        if (static_cast<std::size_t>(kOps[i].id) != i) return false;
+    }
+    return true;
+}
+
+constexpr std::size_t count_names() {
+    std::size_t n = 0;
+    for (const auto& op : kOps) n += 1 + op.aliases.size;
+    return n;
+}
+
+inline constexpr std::size_t kNameCount = count_names();
+inline constexpr std::size_t kSlotCount = 128;
+inline constexpr std::uint8_t kEmptySlot = 0xFF;
+
+constexpr std::uint32_t fnv1a(std::string_view s, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (const char c : s) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+struct NameRef {
+    std::string_view name;
+    std::uint8_t op{0};
+};
+
+/// 所有 op 名（含别名）的完美哈希：fnv1a(name, seed) & (kSlotCount - 1) 无冲突。
+struct OpIndex {
+    std::uint32_t seed{0};
+    std::array<std::uint8_t, kSlotCount> slots{};
+    std::array<NameRef, kNameCount> names{};
+};
+
+constexpr OpIndex build_op_index() {
+    OpIndex idx{};
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < kOpCount; ++i) {
+        idx.names[n++] = NameRef{kOps[i].name, static_cast<std::uint8_t>(i)};
+        for (const auto& alias : kOps[i].aliases) idx.names[n++] = NameRef{alias, static_cast<std::uint8_t>(i)};
+    }
+
+    // 逐个尝试 seed，直到所有名字落在不同槽位；名字重复时永远找不到，seed 保持 0。
+    for (std::uint32_t seed = 1; seed < 4096; ++seed) {
+        std::array<std::uint8_t, kSlotCount> slots{};
+        for (auto& s : slots) s = kEmptySlot;
+        bool ok = true;
+        for (std::size_t k = 0; k < n && ok; ++k) {
+            auto& slot = slots[fnv1a(idx.names[k].name, seed) & (kSlotCount - 1)];
+            if (slot != kEmptySlot) ok = false;
+            slot = static_cast<std::uint8_t>(k);
+        }
+        if (ok) {
+            idx.seed = seed;
+            idx.slots = slots;
+            return idx;
+        }
+    }
+    return idx;
+}
+
+inline constexpr OpIndex kOpIndex = build_op_index();
+
+static_assert(ops_match_enum(), "kOps order must match ArmOp");
+static_assert(kNameCount < kEmptySlot && kNameCount * 2 <= kSlotCount, "too many op names for the index");
+static_assert(kOpIndex.seed != 0, "op names must be unique (perfect hash not found)");
+
+} // namespace detail
+
+/// 按 op 名（含别名）查找描述；一次哈希 + 一次字符串比较。未知 op 返回 nullptr。
+constexpr const OpDesc* find_op(std::string_view name) {
+    const auto& idx = detail::kOpIndex;
+    const std::uint8_t slot = idx.slots[detail::fnv1a(name, idx.seed) & (detail::kSlotCount - 1)];
+    if (slot == detail::kEmptySlot) return nullptr;
+    const auto& ref = idx.names[slot];
+    if (ref.name != name) return nullptr;
+    return &kOps[ref.op];
+}
+
+constexpr const OpDesc& op_desc(ArmOp op) {
+    return kOps[static_cast<std::size_t>(op)];
+}
+
+/// 走优先通道的 op：不排在普通指令之后，由独立会话立即执行（见 arm_control 的 ArmPriorityLane）。
+constexpr bool op_is_priority(ArmOp op) {
+    return op == ArmOp::EmergencyStop || op == ArmOp::QuickStop || op == ArmOp::FaultReset;
+}
+
+/// 只读查询类 op：重复执行没有副作用（bt_service 在 arm_control 未声明去重时只重发这类指令）。
+/// 模块扩展 op（如 demo_echo）没有内置 handler，副作用未知，不算查询。
+constexpr bool op_is_query(ArmOp op) {
+    return op == ArmOp::IsArmReady || op == ArmOp::IsPowerOn || op == ArmOp::IsStartSignal ||
+           op == ArmOp::IsStopSignal || op == ArmOp::IsTrajectoryComplete || op == ArmOp::IsAllTrajectoriesComplete ||
+           op == ArmOp::GetJointActualPos || op == ArmOp::RobotMode;
+}
+
+/// 会驱动机械臂运动的 op：同一时刻只允许一个在执行（非阻塞运动进行中到达的此类指令延后执行）。
+constexpr bool op_moves_arm(ArmOp op) {
+    return op == ArmOp::MoveL || op == ArmOp::MoveJoint || op == ArmOp::ExecuteTrajectory ||
+           op == ArmOp::MoveLStepwise;
+}
+
+} // namespace wxz::workstation::arm_control::ops
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "workstation/arm_ops.h"
+
+namespace wxz::workstation::arm_control::wire {
+
+/// /arm/command 与 /arm/status 的负载 schema（EventDTO.schema_id）。
+///
+/// - v1：payload 为 KV 文本（`k=v;...`），数值以十进制文本传输。
+/// - v2：payload 为定长头部 + 按标志位出现的类型化尾部，全部字段小端编码（布局见 encode 注释）。
+///
+/// 二进制帧（v2 指令/status 与 /arm/state 样本）在写入 payload 前经 COBS 填充，payload 中不含 0x00：
+/// EventDTO.payload 是 CDR string，Fast-CDR 会拒绝含 NUL 的字符串，按 strlen 处理的编解码也会截断。
+/// encode/decode 内部完成填充与还原，下面各 encode 注释中的布局均指还原后的字节。
+///
+/// 协商：发送方逐条选择 schema_id；arm_control 同时接受两种指令，并以与指令相同的版本回复 status。
+/// v2 无法表达的指令（字符串参数、超长 id、描述表外的 op、文本解析失败）由发送方回退为 v1。
+inline constexpr std::string_view kCmdSchemaV1 = "ws.arm_command.v1";
+inline constexpr std::string_view kCmdSchemaV2 = "ws.arm_command.v2";
+inline constexpr std::string_view kStatusSchemaV1 = "ws.arm_status.v1";
+inline constexpr std::string_view kStatusSchemaV2 = "ws.arm_status.v2";
+
+/// /arm/state 周期状态样本（arm_control 主动发布，定长二进制经 COBS 填充，布局见 encode(StateV1)）。
+inline constexpr std::string_view kStateSchemaV1 = "ws.arm_state.v1";
+
+inline constexpr std::uint32_t kCmdMagic = 0x32434157u;     // "WAC2"
+inline constexpr std::uint32_t kStatusMagic = 0x32534157u;  // "WAS2"
+inline constexpr std::uint32_t kStateMagic = 0x31544157u;   // "WAT1"
+
+/// id 最大字节数（头部以 u8 记录长度）；更长的 id 只能走 v1。
+inline constexpr std::size_t kMaxIdLen = 64;
+/// err token 最大字节数；更长的 token 编码时截断。
+inline constexpr std::size_t kMaxErrLen = 48;
+
+/// 定长内联文本（不分配堆内存）。
+template <std::size_t N>
+class FixedText {
+public:
+    static_assert(N <= 255, "length is encoded as u8");
+
+    std::string_view view() const { return {buf_.data(), len_}; }
+
+    /// 写入 s；超过容量时 truncate=true 则截断，否则返回 false 且不修改。
+    bool assign(std::string_view s, bool truncate = false) {
+        if (s.size() > N) {
+            if (!truncate) return false;
+            s = s.substr(0, N);
+        }
+        std::memcpy(buf_.data(), s.data(), s.size());
+        len_ = static_cast<std::uint8_t>(s.size());
+        return true;
+    }
+
+private:
+    std::array<char, N> buf_{};
+    std::uint8_t len_{0};
+};
+
+/// v2 指令参数标志位（CommandV2::fields）。
+enum CmdField : std::uint16_t {
+    kFieldPose = 1u << 0,
+    kFieldJointpos = 1u << 1,
+    kFieldSpeed = 1u << 2,
+    kFieldAcc = 1u << 3,
+    kFieldJerk = 1u << 4,
+    kFieldTimeoutMs = 1u << 5,
+    kFieldEnable = 1u << 6,
+};
+inline constexpr std::uint16_t kCmdFieldMask = 0x7F;
+
+/// 参数 key → v2 标志位；v2 没有类型化槽位的参数返回 0。
+constexpr std::uint16_t cmd_field_for(std::string_view key) {
+    if (key == "pose") return kFieldPose;
+    if (key == "jointpos") return kFieldJointpos;
+    if (key == "speed") return kFieldSpeed;
+    if (key == "acc") return kFieldAcc;
+    if (key == "jerk") return kFieldJerk;
+    if (key == "timeout_ms") return kFieldTimeoutMs;
+    if (key == "enable") return kFieldEnable;
+    return 0;
+}
+
+/// op 的参数与结果字段是否都能用 v2 完整表达。
+constexpr bool op_supports_v2(const ops::OpDesc& op) {
+    for (const auto& a : op.args) {
+        if (cmd_field_for(a.key) == 0) return false;
+    }
+    for (const auto& f : op.result_fields) {
+        if (f.key != "jointpos" && f.key != "jointpos_deg") return false;
+    }
+    return true;
+}
+
+/// v2 指令的类型化表示。只有 fields 中置位的参数有意义。
+struct CommandV2 {
+    ops::ArmOp op{};
+    std::uint16_t fields{0};
+    FixedText<kMaxIdLen> id;
+
+    std::array<double, 6> pose{};
+    std::array<double, 6> jointpos{};
+    double speed{0.0};
+    double acc{0.0};
+    double jerk{0.0};
+    std::int32_t timeout_ms{0};
+    bool enable{false};
+
+    bool has(CmdField f) const { return (fields & f) != 0; }
+};
+
+/// v2 status 的类型化表示。
+struct StatusV2 {
+    enum Flag : std::uint8_t {
+        kOk = 1u << 0,
+        kHasOp = 1u << 1,
+        kHasCode = 1u << 2,
+        kHasSdkCode = 1u << 3,
+        kHasValue = 1u << 4,
+        kValue = 1u << 5,
+        kHasJoints = 1u << 6,
+        kDedup = 1u << 7,  // 发送方对 /arm/command 按 id 去重（同一 id 重发不会再次执行），对应 v1 的 dedup=1
+    };
+
+    std::uint8_t flags{0};
+    ops::ArmOp op{};
+    FixedText<kMaxIdLen> id;
+    FixedText<kMaxErrLen> err;
+    std::int32_t err_code{0};
+    std::int32_t code{0};      // 历史字段 code（仅 kHasCode 时有意义）
+    std::int32_t sdk_code{0};  // 仅 kHasSdkCode 时有意义
+
+    // jointpos：弧度；jointpos_deg：角度（仅 kHasJoints 时有意义）。
+    std::array<double, 6> jointpos{};
+    std::array<double, 6> jointpos_deg{};
+
+    bool has(Flag f) const { return (flags & f) != 0; }
+    void set(Flag f, bool on = true) { flags = static_cast<std::uint8_t>(on ? (flags | f) : (flags & ~f)); }
+};
+
+/// /arm/state 的一条状态样本。
+struct StateV1 {
+    enum Flag : std::uint8_t {
+        kMoving = 1u << 0,
+        kReady = 1u << 1,    // robot mode 属于 ProgramStop/Jog/JointIdle
+        kPowered = 1u << 2,  // robot mode 非 JointPowerOff/Closed
+        kStartDi = 1u << 3,
+        kStopDi = 1u << 4,
+        kPathRunning = 1u << 5,
+    };
+
+    std::uint8_t flags{0};
+    std::uint64_t seq{0};    // 发布序号（进程内单调递增，重启后从 1 开始）
+    std::uint64_t ts_ms{0};  // 采样时刻（epoch ms）
+    std::int32_t mode{0};    // SDK robot mode 原值
+    std::int32_t control_mode{-1};
+    std::uint32_t speed_percent{0};
+    std::int32_t path_run_status{0};
+    std::array<double, 6> jointpos{};  // 弧度
+
+    bool has(Flag f) const { return (flags & f) != 0; }
+    void set(Flag f, bool on = true) { flags = static_cast<std::uint8_t>(on ? (flags | f) : (flags & ~f)); }
+};
+
+namespace detail {
+
+/// 编解码共用的帧缓冲（每线程一个，跨调用复用容量）。encode/decode 不互相嵌套，可共用。
+inline std::string& frame_scratch() {
+    thread_local std::string buf;
+    return buf;
+}
+
+/// COBS 编码：把 raw 写成不含 0x00 的字节序列（覆盖 out），开销至多 1 + size/254 字节。
+inline void cobs_encode(std::string_view raw, std::string& out) {
+    out.clear();
+    std::size_t code_pos = 0;
+    std::uint8_t code = 1;
+    out.push_back('\x01');
+    for (const char c : raw) {
+        if (c != '\0') {
+            out.push_back(c);
+            ++code;
+        }
+        if (c == '\0' || code == 0xFF) {
+            out[code_pos] = static_cast<char>(code);
+            code_pos = out.size();
+            out.push_back('\x01');
+            code = 1;
+        }
+    }
+    out[code_pos] = static_cast<char>(code);
+}
+
+/// COBS 解码（覆盖 out）；输入含 0x00 或块长度越界时返回 false。
+inline bool cobs_decode(std::string_view in, std::string& out) {
+    out.clear();
+    if (in.empty() || in.find('\0') != std::string_view::npos) return false;
+    std::size_t i = 0;
+    while (i < in.size()) {
+        const std::size_t code = static_cast<unsigned char>(in[i++]);
+        if (in.size() - i < code - 1) return false;
+        out.append(in.data() + i, code - 1);
+        i += code - 1;
+        if (code != 0xFF && i < in.size()) out.push_back('\0');
+    }
+    return true;
+}
+
+inline void put_u8(std::string& out, std::uint8_t v) { out.push_back(static_cast<char>(v)); }
+
+inline void put_u16(std::string& out, std::uint16_t v) {
+    put_u8(out, static_cast<std::uint8_t>(v));
+    put_u8(out, static_cast<std::uint8_t>(v >> 8));
+}
+
+inline void put_u32(std::string& out, std::uint32_t v) {
+    put_u16(out, static_cast<std::uint16_t>(v));
+    put_u16(out, static_cast<std::uint16_t>(v >> 16));
+}
+
+inline void put_u64(std::string& out, std::uint64_t v) {
+    put_u32(out, static_cast<std::uint32_t>(v));
+    put_u32(out, static_cast<std::uint32_t>(v >> 32));
+}
+
+inline void put_f64(std::string& out, double v) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &v, sizeof(bits));
+    put_u64(out, bits);
+}
+
+inline void put_f64x6(std::string& out, const std::array<double, 6>& v) {
+    for (const double d : v) put_f64(out, d);
+}
+
+/// 顺序读取器；越界时 ok 置为 false，后续读取均返回 0。
+struct Reader {
+    std::string_view in;
+    std::size_t pos{0};
+    bool ok{true};
+
+    const unsigned char* take(std::size_t n) {
+        if (!ok || in.size() - pos < n) {
+            ok = false;
+            return nullptr;
+        }
+        const auto* p = reinterpret_cast<const unsigned char*>(in.data() + pos);
+        pos += n;
+        return p;
+    }
+
+    std::uint8_t u8() {
+        const auto* p = take(1);
+        return p ? p[0] : 0;
+    }
+
+    std::uint16_t u16() {
+        const auto* p = take(2);
+        return p ? static_cast<std::uint16_t>(p[0] | (p[1] << 8)) : 0;
+    }
+
+    std::uint32_t u32() {
+        const std::uint32_t lo = u16();
+        const std::uint32_t hi = u16();
+        return lo | (hi << 16);
+    }
+
+    std::uint64_t u64() {
+        const std::uint64_t lo = u32();
+        const std::uint64_t hi = u32();
+        return lo | (hi << 32);
+    }
+
+    double f64() {
+        const std::uint64_t bits = u64();
+        double v = 0.0;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    void f64x6(std::array<double, 6>& v) {
+        for (double& d : v) d = f64();
+    }
+
+    std::string_view text(std::size_t n) {
+        const auto* p = take(n);
+        return p ? std::string_view(reinterpret_cast<const char*>(p), n) : std::string_view{};
+    }
+
+    bool done() const { return ok && pos == in.size(); }
+};
+
+} // namespace detail
+
+/// 编码 v2 指令（覆盖 out，复用其容量）。
+///
+/// 布局：
+///   u32 magic | u8 op | u8 id_len | u16 fields | id[id_len]
+///   [f64 pose[6]] [f64 jointpos[6]] [f64 speed] [f64 acc] [f64 jerk] [i32 timeout_ms] [u8 enable]
+/// 方括号内的字段按 fields 置位依次出现。
+inline void encode(const CommandV2& cmd, std::string& out) {
+    const std::string_view id = cmd.id.view();
+    std::string& raw = detail::frame_scratch();
+    raw.clear();
+    detail::put_u32(raw, kCmdMagic);
+    detail::put_u8(raw, static_cast<std::uint8_t>(cmd.op));
+    detail::put_u8(raw, static_cast<std::uint8_t>(id.size()));
+    detail::put_u16(raw, static_cast<std::uint16_t>(cmd.fields & kCmdFieldMask));
+    raw.append(id.data(), id.size());
+    if (cmd.has(kFieldPose)) detail::put_f64x6(raw, cmd.pose);
+    if (cmd.has(kFieldJointpos)) detail::put_f64x6(raw, cmd.jointpos);
+    if (cmd.has(kFieldSpeed)) detail::put_f64(raw, cmd.speed);
+    if (cmd.has(kFieldAcc)) detail::put_f64(raw, cmd.acc);
+    if (cmd.has(kFieldJerk)) detail::put_f64(raw, cmd.jerk);
+    if (cmd.has(kFieldTimeoutMs)) detail::put_u32(raw, static_cast<std::uint32_t>(cmd.timeout_ms));
+    if (cmd.has(kFieldEnable)) detail::put_u8(raw, cmd.enable ? 1 : 0);
+    detail::cobs_encode(raw, out);
+}
+
+/// 解码 v2 指令；COBS 还原失败或 magic/op/长度任一不符返回 false。
+inline bool decode(std::string_view in, CommandV2& cmd) {
+    std::string& raw = detail::frame_scratch();
+    if (!detail::cobs_decode(in, raw)) return false;
+    detail::Reader r{raw};
+    if (r.u32() != kCmdMagic) return false;
+    const std::uint8_t op = r.u8();
+    const std::uint8_t id_len = r.u8();
+    const std::uint16_t fields = r.u16();
+    if (!r.ok || op >= ops::kOpCount || id_len > kMaxIdLen || (fields & ~kCmdFieldMask) != 0) return false;
+
+    cmd = CommandV2{};
+    cmd.op = static_cast<ops::ArmOp>(op);
+    cmd.fields = fields;
+    cmd.id.assign(r.text(id_len));
+    if (cmd.has(kFieldPose)) r.f64x6(cmd.pose);
+    if (cmd.has(kFieldJointpos)) r.f64x6(cmd.jointpos);
+    if (cmd.has(kFieldSpeed)) cmd.speed = r.f64();
+    if (cmd.has(kFieldAcc)) cmd.acc = r.f64();
+    if (cmd.has(kFieldJerk)) cmd.jerk = r.f64();
+    if (cmd.has(kFieldTimeoutMs)) cmd.timeout_ms = static_cast<std::int32_t>(r.u32());
+    if (cmd.has(kFieldEnable)) cmd.enable = r.u8() != 0;
+    return r.done();
+}
+
+/// 编码 v2 status（覆盖 out，复用其容量）。
+///
+/// 布局：
+///   u32 magic | u8 flags | u8 op | u8 id_len | u8 err_len | i32 err_code | i32 code | i32 sdk_code
+///   id[id_len] | err[err_len] | [f64 jointpos[6] f64 jointpos_deg[6]]
+/// 方括号内的字段仅在 kHasJoints 置位时出现。
+inline void encode(const StatusV2& st, std::string& out) {
+    const std::string_view id = st.id.view();
+    const std::string_view err = st.err.view();
+    std::string& raw = detail::frame_scratch();
+    raw.clear();
+    detail::put_u32(raw, kStatusMagic);
+    detail::put_u8(raw, st.flags);
+    detail::put_u8(raw, static_cast<std::uint8_t>(st.op));
+    detail::put_u8(raw, static_cast<std::uint8_t>(id.size()));
+    detail::put_u8(raw, static_cast<std::uint8_t>(err.size()));
+    detail::put_u32(raw, static_cast<std::uint32_t>(st.err_code));
+    detail::put_u32(raw, static_cast<std::uint32_t>(st.code));
+    detail::put_u32(raw, static_cast<std::uint32_t>(st.sdk_code));
+    raw.append(id.data(), id.size());
+    raw.append(err.data(), err.size());
+    if (st.has(StatusV2::kHasJoints)) {
+        detail::put_f64x6(raw, st.jointpos);
+        detail::put_f64x6(raw, st.jointpos_deg);
+    }
+    detail::cobs_encode(raw, out);
+}
+
+/// 解码 v2 status；COBS 还原失败或 magic/op/长度任一不符返回 false。
+inline bool decode(std::string_view in, StatusV2& st) {
+    std::string& raw = detail::frame_scratch();
+    if (!detail::cobs_decode(in, raw)) return false;
+    detail::Reader r{raw};
+    if (r.u32() != kStatusMagic) return false;
+    const std::uint8_t flags = r.u8();
+    const std::uint8_t op = r.u8();
+    const std::uint8_t id_len = r.u8();
+    const std::uint8_t err_len = r.u8();
+    if (!r.ok || id_len > kMaxIdLen || err_len > kMaxErrLen) return false;
+    if ((flags & StatusV2::kHasOp) && op >= ops::kOpCount) return false;
+
+    st = StatusV2{};
+    st.flags = flags;
+    st.op = static_cast<ops::ArmOp>(op);
+    st.err_code = static_cast<std::int32_t>(r.u32());
+    st.code = static_cast<std::int32_t>(r.u32());
+    st.sdk_code = static_cast<std::int32_t>(r.u32());
+    st.id.assign(r.text(id_len));
+    st.err.assign(r.text(err_len));
+    if (st.has(StatusV2::kHasJoints)) {
+        r.f64x6(st.jointpos);
+        r.f64x6(st.jointpos_deg);
+    }
+    return r.done();
+}
+
+/// 编码 /arm/state 样本（覆盖 out，复用其容量）。
+///
+/// 布局（还原后定长 85 字节）：
+///   u32 magic | u8 flags | u64 seq | u64 ts_ms | i32 mode | i32 control_mode | u32 speed_percent
+///   i32 path_run_status | f64 jointpos[6]
+inline void encode(const StateV1& st, std::string& out) {
+    std::string& raw = detail::frame_scratch();
+    raw.clear();
+    detail::put_u32(raw, kStateMagic);
+    detail::put_u8(raw, st.flags);
+    detail::put_u64(raw, st.seq);
+    detail::put_u64(raw, st.ts_ms);
+    detail::put_u32(raw, static_cast<std::uint32_t>(st.mode));
+    detail::put_u32(raw, static_cast<std::uint32_t>(st.control_mode));
+    detail::put_u32(raw, st.speed_percent);
+    detail::put_u32(raw, static_cast<std::uint32_t>(st.path_run_status));
+    detail::put_f64x6(raw, st.jointpos);
+    detail::cobs_encode(raw, out);
+}
+
+/// 解码 /arm/state 样本；COBS 还原失败或 magic/长度不符返回 false。
+inline bool decode(std::string_view in, StateV1& st) {
+    std::string& raw = detail::frame_scratch();
+    if (!detail::cobs_decode(in, raw)) return false;
+    detail::Reader r{raw};
+    if (r.u32() != kStateMagic) return false;
+    st = StateV1{};
+    st.flags = r.u8();
+    st.seq = r.u64();
+    st.ts_ms = r.u64();
+    st.mode = static_cast<std::int32_t>(r.u32());
+    st.control_mode = static_cast<std::int32_t>(r.u32());
+    st.speed_percent = r.u32();
+    st.path_run_status = static_cast<std::int32_t>(r.u32());
+    r.f64x6(st.jointpos);
+    return r.done();
+}
+
+/// 以定点格式输出 6 个数（`a,b,c,d,e,f`），与 v1 status 中 jointpos 的文本格式一致。
+inline std::string format_csv6_fixed(const std::array<double, 6>& v, int precision = 6) {
+    std::array<char, 6 * 32> buf{};
+    char* p = buf.data();
+    char* const end = buf.data() + buf.size();
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (i > 0) *p++ = ',';
+        const auto res = std::to_chars(p, end - 1, v[i], std::chars_format::fixed, precision);
+        if (res.ec != std::errc{}) return {};
+        p = res.ptr;
+    }
+    return std::string(buf.data(), p);
+}
+
+} // namespace wxz::workstation::arm_control::wire
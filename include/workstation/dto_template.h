@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "dto/event_dto.h"
+#include "metrics.h"
+#include "service_common.h"
+
+#include "workstation/node.h"
+
+namespace wxz::workstation {
+
+/// 发布端 EventDTO 模板：常量字段只写一次，payload/event_id 缓冲跨发布复用。
+///
+/// - version/topic/schema_id/source 在构造时写入（fillMeta 只调用一次），每次发布只刷新 ts_ms；
+/// - payload 直接写入模板内的复用缓冲（clear 保留容量），稳态下本路径不分配堆内存；
+/// - allocs 统计“复用缓冲容量不足、发生了堆分配”的发布次数，稳态应保持不变；
+/// - 非线程安全：每个模板只应由一个发布线程使用（stats 可由其它线程读取）。
+class EventDtoTemplate {
+public:
+    struct Stats {
+        std::uint64_t published{0};
+        std::uint64_t failed{0};
+        std::uint64_t allocs{0};
+    };
+
+    EventDtoTemplate(EventDtoPublisher& pub,
+                     std::string topic,
+                     std::string schema_id,
+                     const std::string& source,
+                     std::size_t payload_reserve = 1024)
+        : pub_(pub), default_schema_(std::move(schema_id)) {
+        dto_.version = 1;
+        dto_.topic = std::move(topic);
+        dto_.schema_id = default_schema_;
+        EventDTOUtil::fillMeta(dto_, source);
+        dto_.payload.reserve(payload_reserve);
+        dto_.event_id.reserve(64);
+    }
+
+    EventDtoTemplate(const EventDtoTemplate&) = delete;
+    EventDtoTemplate& operator=(const EventDtoTemplate&) = delete;
+
+    /// 开始一条消息：返回已清空的 payload 缓冲；schema_id 为空时使用构造时的默认值。
+    std::string& begin(std::string_view schema_id = {}) {
+        capacity_mark_ = capacity_sum();
+        const std::string_view schema = schema_id.empty() ? std::string_view(default_schema_) : schema_id;
+        if (dto_.schema_id != schema) dto_.schema_id.assign(schema.data(), schema.size());
+        dto_.payload.clear();
+        return dto_.payload;
+    }
+
+    /// 把 KV 写成 `k=v;...` 到 payload。含分隔符的 key/value 交给 buildPayloadKv 处理。
+    void write_kv(const EventDTOUtil::KvMap& kv) {
+        std::string& out = dto_.payload;
+        for (const auto& [k, v] : kv) {
+            if (k.find_first_of(";=") != std::string::npos || v.find(';') != std::string::npos) {
+                out = EventDTOUtil::buildPayloadKv(kv);
+                return;
+            }
+        }
+        for (const auto& [k, v] : kv) {
+            if (!out.empty()) out.push_back(';');
+            out.append(k);
+            out.push_back('=');
+            out.append(v);
+        }
+    }
+
+    /// 发布当前消息（event_id 为空时沿用空值）。
+    bool publish(std::string_view event_id) {
+        dto_.event_id.assign(event_id.data(), event_id.size());
+        dto_.ts_ms = wxz::core::now_epoch_ms();
+        if (capacity_sum() != capacity_mark_) bump(allocs_);
+        const bool ok = pub_.publish(dto_);
+        bump(ok ? published_ : failed_);
+        return ok;
+    }
+
+    Stats stats() const {
+        return Stats{published_.load(std::memory_order_relaxed),
+                     failed_.load(std::memory_order_relaxed),
+                     allocs_.load(std::memory_order_relaxed)};
+    }
+
+    /// 以增量方式上报 `<prefix>.published_total/failed_total/alloc_total`（由周期任务调用，不在发布路径上）。
+    void report_metrics(const std::string& prefix, const std::string& scope) {
+        const Stats now = stats();
+        auto add = [&](const char* name, std::uint64_t cur, std::uint64_t prev) {
+            if (cur > prev) {
+                wxz::core::metrics().counter_add(prefix + name, static_cast<double>(cur - prev), {{"scope", scope}});
+            }
+        };
+        add(".published_total", now.published, reported_.published);
+        add(".failed_total", now.failed, reported_.failed);
+        add(".alloc_total", now.allocs, reported_.allocs);
+        reported_ = now;
+    }
+
+private:
+    std::size_t capacity_sum() const {
+        return dto_.payload.capacity() + dto_.event_id.capacity() + dto_.schema_id.capacity();
+    }
+
+    static void bump(std::atomic<std::uint64_t>& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    EventDtoPublisher& pub_;
+    const std::string default_schema_;
+    ::EventDTO dto_;
+    std::size_t capacity_mark_{0};
+
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> failed_{0};
+    std::atomic<std::uint64_t> allocs_{0};
+    Stats reported_;
+};
+
+} // namespace wxz::workstation
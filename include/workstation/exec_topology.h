@@ -0,0 +1,125 @@
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "executor.h"
+#include "logger.h"
+#include "service_common.h"
+#include "strand.h"
+
+namespace wxz::workstation {
+
+/// 一个执行角色（ingress / SDK / RPC / 主循环）的线程放置。
+struct ExecThreadSpec {
+    bool dedicated{false};  // true：独占一个 executor 线程；false：跑在主循环驱动的 executor 上
+    int cpu{-1};            // 绑定的 CPU 编号；<0 表示不绑核
+    std::string name;       // 线程名（pthread 限 15 字节，超出部分截断）
+};
+
+/// 从环境变量读取 `<prefix>_THREAD`（0/1，缺省为 def_dedicated）与 `<prefix>_CPU`（缺省 -1）。
+inline ExecThreadSpec exec_thread_spec_from_env(const std::string& prefix, std::string name, bool def_dedicated = false) {
+    ExecThreadSpec spec;
+    spec.dedicated = wxz::core::getenv_int((prefix + "_THREAD").c_str(), def_dedicated ? 1 : 0) != 0;
+    spec.cpu = wxz::core::getenv_int((prefix + "_CPU").c_str(), -1);
+    spec.name = std::move(name);
+    return spec;
+}
+
+/// 解析逗号分隔的 CPU 列表（如 "2,3"）；无法解析的项记为 -1（不绑核）。
+inline std::vector<int> parse_cpu_list(const std::string& s) {
+    std::vector<int> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        try {
+            out.push_back(item.empty() ? -1 : std::stoi(item));
+        } catch (...) {
+            out.push_back(-1);
+        }
+    }
+    return out;
+}
+
+/// 把调用线程绑到 cpu（<0 时不绑）并设置线程名。绑核失败时返回 false 并写 err，线程照常运行。
+inline bool place_current_thread(int cpu, const std::string& name, std::string* err = nullptr) {
+    if (!name.empty()) (void)pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+    if (cpu < 0) return true;
+    if (cpu >= CPU_SETSIZE) {
+        if (err) *err = "cpu " + std::to_string(cpu) + " out of range";
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); rc != 0) {
+        if (err) *err = "pthread_setaffinity_np(cpu=" + std::to_string(cpu) + "): " + std::strerror(rc);
+        return false;
+    }
+    return true;
+}
+
+/// 一个执行角色的 Strand：dedicated 时建在独占的 executor（threads=1）上，线程启动后按 spec 绑核/命名；
+/// 否则建在 fallback（主循环驱动的 executor）上，行为与单线程布局相同。
+///
+/// 跨线程移交仍走 Strand::post / executor 的任务队列，调用方无需额外加锁。
+class ExecLane {
+public:
+    ExecLane(wxz::core::Executor& fallback, ExecThreadSpec spec, wxz::core::Logger& logger) : spec_(std::move(spec)) {
+        if (!spec_.dedicated) {
+            strand_ = std::make_unique<wxz::core::Strand>(fallback);
+            return;
+        }
+        wxz::core::Executor::Options o;
+        o.threads = 1;
+        exec_ = std::make_unique<wxz::core::Executor>(o);
+        (void)exec_->start();
+        strand_ = std::make_unique<wxz::core::Strand>(*exec_);
+
+        // 绑核/命名必须在 worker 线程内执行：投递一个启动任务。
+        (void)exec_->post([spec = spec_, &logger] {
+            std::string err;
+            if (!place_current_thread(spec.cpu, spec.name, &err)) {
+                logger.log(wxz::core::LogLevel::Warn, "thread '" + spec.name + "' placement failed: " + err);
+            }
+        });
+    }
+
+    ~ExecLane() { stop(); }
+
+    ExecLane(const ExecLane&) = delete;
+    ExecLane& operator=(const ExecLane&) = delete;
+
+    wxz::core::Strand& strand() { return *strand_; }
+    bool dedicated() const { return exec_ != nullptr; }
+    const ExecThreadSpec& spec() const { return spec_; }
+
+    /// 停止独占的 executor 并等待线程退出（可重复调用）；非独占时无操作。
+    void stop() {
+        if (exec_ && !stopped_) {
+            exec_->stop();
+            stopped_ = true;
+        }
+    }
+
+    /// 日志用的简短描述，如 "own(cpu=2)" / "main"。
+    std::string describe() const {
+        if (!dedicated()) return "main";
+        return spec_.cpu >= 0 ? "own(cpu=" + std::to_string(spec_.cpu) + ")" : "own";
+    }
+
+private:
+    ExecThreadSpec spec_;
+    std::unique_ptr<wxz::core::Executor> exec_;  // 声明在 strand_ 之前：strand_ 先析构
+    std::unique_ptr<wxz::core::Strand> strand_;
+    bool stopped_{false};
+};
+
+}  // namespace wxz::workstation
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wxz::workstation {
+
+/// EventDTO KV 负载（`k=v;k=v;...`）的非拥有视图。
+///
+/// - 只切分不拷贝：key/value 均为指向原始缓冲区的 string_view。
+/// - 不超过 kInlineCapacity 个字段时完全不分配堆内存；超出部分才退化到 vector。
+/// - 切分规则与 buildPayloadKv 对齐：以 ';' 分段、以首个 '=' 分隔 key/value；
+///   空段与不含 '=' 的段被忽略；同名 key 以最后一次出现为准。
+///
+/// 生命周期：视图仅在原始缓冲区存活且未被修改期间有效。
+/// 需要让值活得比缓冲区更久时，使用 to_map()/std::string(...) 转成拥有型数据。
+class KvView {
+public:
+    using Entry = std::pair<std::string_view, std::string_view>;
+
+    static constexpr std::size_t kInlineCapacity = 32;
+
+    KvView() = default;
+
+    explicit KvView(std::string_view payload) { parse(payload); }
+
+    /// 重新切分 payload（丢弃之前的内容）。
+    void parse(std::string_view payload) {
+        inline_size_ = 0;
+        spill_.clear();
+
+        std::size_t pos = 0;
+        while (pos <= payload.size()) {
+            std::size_t end = payload.find(';', pos);
+            if (end == std::string_view::npos) end = payload.size();
+            const std::string_view seg = payload.substr(pos, end - pos);
+            const std::size_t eq = seg.find('=');
+            if (eq != std::string_view::npos && eq > 0) {
+                append(Entry{seg.substr(0, eq), seg.substr(eq + 1)});
+            }
+            pos = end + 1;
+        }
+    }
+
+    /// 查找 key；不存在返回 std::nullopt。
+    std::optional<std::string_view> find(std::string_view key) const {
+        for (auto it = spill_.rbegin(); it != spill_.rend(); ++it) {
+            if (it->first == key) return it->second;
+        }
+        for (std::size_t i = inline_size_; i > 0; --i) {
+            if (inline_[i - 1].first == key) return inline_[i - 1].second;
+        }
+        return std::nullopt;
+    }
+
+    bool contains(std::string_view key) const { return find(key).has_value(); }
+
+    /// 读取 key；不存在返回 def。
+    std::string_view get(std::string_view key, std::string_view def = {}) const {
+        auto v = find(key);
+        return v ? *v : def;
+    }
+
+    std::size_t size() const { return inline_size_ + spill_.size(); }
+
+    bool empty() const { return size() == 0; }
+
+    /// 按出现顺序遍历所有字段（含同名重复项）。
+    template <class F>
+    void for_each(F&& fn) const {
+        for (std::size_t i = 0; i < inline_size_; ++i) fn(inline_[i].first, inline_[i].second);
+        for (const auto& e : spill_) fn(e.first, e.second);
+    }
+
+    /// 拥有型回退：转成 map（如 EventDTOUtil::KvMap），后出现的同名 key 覆盖先出现的。
+    template <class Map>
+    Map to_map() const {
+        Map out;
+        for_each([&](std::string_view k, std::string_view v) { out[std::string(k)] = std::string(v); });
+        return out;
+    }
+
+private:
+    void append(Entry e) {
+        if (inline_size_ < kInlineCapacity) {
+            inline_[inline_size_++] = e;
+        } else {
+            spill_.push_back(e);
+        }
+    }
+
+    std::array<Entry, kInlineCapacity> inline_{};
+    std::size_t inline_size_{0};
+    std::vector<Entry> spill_;
+};
+
+} // namespace wxz::workstation
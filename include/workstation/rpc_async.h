@@ -0,0 +1,271 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "executor.h"
+#include "framework/typed_rpc.h"
+#include "workstation/service.h"
+
+namespace wxz::workstation {
+
+/// 异步调用被本地终止时 Status::message 的取值（code 均为 1）。
+inline constexpr const char* kRpcCancelled = "cancelled";
+inline constexpr const char* kRpcDeadlineExceeded = "deadline_exceeded";
+inline constexpr const char* kRpcCallerStopped = "caller_stopped";
+
+namespace detail {
+
+/// 一次异步调用的共享状态：结果只交付一次（回复、取消、截止、停止中先到者生效）。
+///
+/// 在途调用占用调用器的一个并发名额；结果交付（含取消）时立即归还，不必等 framework 调用返回。
+template <class Rep>
+class AsyncCallState {
+public:
+    using Result = wxz::framework::typed_rpc::Result<Rep>;
+    using Callback = std::function<void(const Result&)>;
+
+    AsyncCallState(std::uint64_t id,
+                   std::chrono::steady_clock::time_point deadline,
+                   Callback cb,
+                   std::function<void()> release_slot)
+        : id_(id), deadline_(deadline), cb_(std::move(cb)), release_slot_(std::move(release_slot)) {}
+
+    std::uint64_t id() const { return id_; }
+    std::chrono::steady_clock::time_point deadline() const { return deadline_; }
+    std::future<Result> future() { return promise_.get_future(); }
+    bool done() const { return done_.load(std::memory_order_acquire); }
+
+    /// 交付结果；已交付过时丢弃并返回 false。回调在调用 complete 的线程上执行。
+    bool complete(Result r) {
+        Callback cb;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (done_.load(std::memory_order_relaxed)) return false;
+            done_.store(true, std::memory_order_release);
+            cb = std::move(cb_);
+        }
+        release_slot();
+        if (cb) cb(r);
+        promise_.set_value(std::move(r));
+        return true;
+    }
+
+    /// 标记已占用并发名额（worker 开始发出请求前调用）。
+    void hold_slot() { slot_held_.store(true, std::memory_order_release); }
+
+    /// 归还并发名额（至多一次）。
+    void release_slot() {
+        if (slot_held_.exchange(false, std::memory_order_acq_rel) && release_slot_) release_slot_();
+    }
+
+    bool fail(const char* reason) {
+        Result r;
+        r.status = wxz::workstation::Status::error(1, reason);
+        return complete(std::move(r));
+    }
+
+private:
+    const std::uint64_t id_;
+    const std::chrono::steady_clock::time_point deadline_;
+    std::mutex mu_;
+    std::atomic<bool> done_{false};
+    std::atomic<bool> slot_held_{false};
+    Callback cb_;
+    const std::function<void()> release_slot_;
+    std::promise<Result> promise_;
+};
+
+}  // namespace detail
+
+/// 一次异步调用的句柄：按 id 关联，可取 future 或取消。句柄可丢弃，调用照常完成。
+template <class Rep>
+class AsyncCall {
+public:
+    using Result = wxz::framework::typed_rpc::Result<Rep>;
+
+    AsyncCall() = default;
+    AsyncCall(std::shared_ptr<detail::AsyncCallState<Rep>> st) : st_(std::move(st)), fut_(st_->future()) {}
+
+    std::uint64_t id() const { return st_ ? st_->id() : 0; }
+    bool valid() const { return fut_.valid(); }
+
+    std::future<Result>& future() { return fut_; }
+
+    /// 阻塞等待结果（至多一次）。
+    Result get() { return fut_.get(); }
+
+    /// 取消：尚未发出的请求不再发出；已发出的请求其回复被丢弃。结果立即以 "cancelled" 交付。
+    /// 已发出的请求无法从 framework 客户端撤回，其 worker 仍阻塞到回复或超时（见 AsyncRpcCaller）。
+    /// 已完成时返回 false。
+    bool cancel() { return st_ && st_->fail(kRpcCancelled); }
+
+private:
+    std::shared_ptr<detail::AsyncCallState<Rep>> st_;
+    std::future<Result> fut_;
+};
+
+/// RpcServiceClient 的异步/流水线调用器：同一线程可同时挂起多个请求，结果经 future 或回调交付。
+///
+/// - 请求由内部 worker（Executor，max_in_flight + spare_workers 个线程）发出，最多 max_in_flight 个同时在途，其余排队；
+///   回复与请求的关联由 framework 客户端按 request id 完成，这里以本地 call id 标识每次调用（用于取消/排障）。
+/// - 截止时间从提交时刻算起（含排队时间）：出队时已过期的请求不再发出，直接以 "deadline_exceeded" 失败；
+///   否则以剩余时间作为该次调用的超时。
+/// - framework 客户端只有阻塞调用：已发出的请求被取消后，其 worker 仍阻塞在 typed_rpc::call 中直到回复或超时。
+///   取消时立即归还该调用的并发名额，由备用 worker（spare_workers）接着发出排队的请求；
+///   同时“已取消仍阻塞”的调用多于 spare_workers 个时，并发度暂时下降，直到它们超时返回。
+///   stop() 同样要等这些 worker 返回，最长为其剩余超时。
+/// - 一个调用器可同时服务多个 client（例如扇出查询多个 arm_control 实例）；client 须存活到其调用全部完成或 stop()。
+/// - 回调在 worker 线程（或调用 cancel/stop 的线程）上执行，应尽快返回，不要在回调里同步等待其它异步调用。
+class AsyncRpcCaller {
+    using FailFn = std::function<bool(const char*)>;
+
+public:
+    struct Options {
+        std::size_t max_in_flight{8};
+        std::size_t spare_workers{2};  // 接替“已取消但仍阻塞在调用中”的 worker 的备用线程数
+        std::string name{"rpc-async"};
+    };
+
+    AsyncRpcCaller() : AsyncRpcCaller(Options{}) {}
+
+    explicit AsyncRpcCaller(Options opts) : max_in_flight_(opts.max_in_flight > 0 ? opts.max_in_flight : 1) {
+        wxz::core::Executor::Options o;
+        o.threads = max_in_flight_ + opts.spare_workers;
+        o.name = std::move(opts.name);
+        exec_ = std::make_unique<wxz::core::Executor>(o);
+        (void)exec_->start();
+    }
+
+    ~AsyncRpcCaller() { stop(); }
+
+    AsyncRpcCaller(const AsyncRpcCaller&) = delete;
+    AsyncRpcCaller& operator=(const AsyncRpcCaller&) = delete;
+
+    /// 提交一次类型化调用；on_done 可为空（只用 future）。
+    template <class Req, class Rep>
+    AsyncCall<Rep> call(RpcServiceClient& cli,
+                        std::string op,
+                        Req req,
+                        std::chrono::milliseconds timeout,
+                        std::function<void(const wxz::framework::typed_rpc::Result<Rep>&)> on_done = {}) {
+        auto st = std::make_shared<detail::AsyncCallState<Rep>>(
+            next_id_.fetch_add(1, std::memory_order_relaxed), std::chrono::steady_clock::now() + timeout,
+            std::move(on_done), [this] { release_slot(); });
+        AsyncCall<Rep> handle(st);
+        track(st->id(), [st](const char* reason) { return st->fail(reason); });
+
+        const bool posted = !stopping_.load(std::memory_order_acquire) &&
+                            exec_->post([this, &cli, op = std::move(op), req = std::move(req), st]() mutable {
+                                run(cli, op, std::move(req), *st);
+                                st->release_slot();
+                                untrack(st->id());
+                            });
+        if (!posted) {
+            st->fail(kRpcCallerStopped);
+            untrack(st->id());
+        }
+        return handle;
+    }
+
+    /// 按 call id 取消（句柄不在手边时使用）；id 未知或已完成返回 false。
+    bool cancel(std::uint64_t id) {
+        FailFn fail;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            auto it = cancel_.find(id);
+            if (it == cancel_.end()) return false;
+            fail = it->second;
+        }
+        return fail(kRpcCancelled);
+    }
+
+    /// 当前未完成（排队或在途）的调用数。
+    std::size_t in_flight() const {
+        std::lock_guard<std::mutex> lock(mu_);
+        return cancel_.size();
+    }
+
+    /// 以 "caller_stopped" 结束所有未完成调用并等待 worker 退出（可重复调用）。
+    void stop() {
+        if (stopping_.exchange(true, std::memory_order_acq_rel)) return;
+        std::unordered_map<std::uint64_t, FailFn> pending;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            pending = cancel_;
+        }
+        for (auto& [id, fail] : pending) (void)fail(kRpcCallerStopped);
+        slot_cv_.notify_all();
+        exec_->stop();
+    }
+
+private:
+    template <class Req, class Rep>
+    void run(RpcServiceClient& cli, const std::string& op, Req req, detail::AsyncCallState<Rep>& st) {
+        if (st.done()) return;  // 排队期间已取消
+        if (!acquire_slot(st)) return;
+        st.hold_slot();
+        if (st.done()) return;  // 等名额期间已取消（名额由调用方 release_slot 归还）
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            st.deadline() - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            st.fail(kRpcDeadlineExceeded);
+            return;
+        }
+        st.complete(wxz::framework::typed_rpc::call<Req, Rep>(cli, op, std::move(req), remaining));
+    }
+
+    // 等待一个并发名额；期间调用已结束或调用器停止时返回 false（不占名额）。
+    template <class Rep>
+    bool acquire_slot(const detail::AsyncCallState<Rep>& st) {
+        std::unique_lock<std::mutex> lock(slot_mu_);
+        slot_cv_.wait(lock, [&] {
+            return active_ < max_in_flight_ || st.done() || stopping_.load(std::memory_order_acquire);
+        });
+        if (st.done() || active_ >= max_in_flight_) return false;
+        ++active_;
+        return true;
+    }
+
+    void release_slot() {
+        {
+            std::lock_guard<std::mutex> lock(slot_mu_);
+            --active_;
+        }
+        slot_cv_.notify_all();  // 等待者中可能有已取消的调用，它们醒来后不占名额
+    }
+
+    // 未完成调用的登记表：取消与停止共用同一入口，按 reason 交付失败结果。
+    void track(std::uint64_t id, FailFn fail) {
+        std::lock_guard<std::mutex> lock(mu_);
+        cancel_.emplace(id, std::move(fail));
+    }
+
+    void untrack(std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(mu_);
+        cancel_.erase(id);
+    }
+
+    const std::size_t max_in_flight_;
+    std::mutex slot_mu_;
+    std::condition_variable slot_cv_;
+    std::size_t active_{0};  // 占用并发名额的调用数（已取消的在途调用不计）
+
+    std::unique_ptr<wxz::core::Executor> exec_;
+    std::atomic<std::uint64_t> next_id_{1};
+    std::atomic<bool> stopping_{false};
+    mutable std::mutex mu_;
+    std::unordered_map<std::uint64_t, FailFn> cancel_;
+};
+
+}  // namespace wxz::workstation
@@ -1,31 +1,43 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "internal/arm_control_internal.h"
+#include "workstation/arm_wire.h"
+#include "workstation/kv_view.h"
 
 namespace wxz::workstation::arm_control::internal {
 
-/// 机械臂指令（从 EventDTO.payload 的 KV 解析得到）。
+/// 机械臂指令（v1 为 EventDTO.payload 的 KV 视图；v2 为解码后的类型化参数）。
+///
+/// 不拥有数据：raw/kv/op/id/v2 均指向构造时传入的缓冲区或对象，
+/// 仅在其存活期间有效；需要保留的值请显式拷贝成 std::string。
 struct ArmCommand {
-    std::string raw;
-    EventDTOUtil::KvMap kv;
-    std::string op;
-    std::string id;
+    std::string_view raw;
+    wxz::workstation::KvView kv;
+    std::string_view op;
+    std::string_view id;
+
+    /// v2 指令的类型化参数；v1 指令为 nullptr（此时参数只在 kv 中）。
+    const wire::CommandV2* v2{nullptr};
 };
 
-/// 解析原始 KV 字符串为 ArmCommand。
-ArmCommand parse_arm_command(const std::string& raw);
+/// 解析原始 KV 字符串为 ArmCommand（不分配堆内存）。
+ArmCommand parse_arm_command(std::string_view raw);
+
+/// 以解码后的 v2 指令构造 ArmCommand（op 取描述表中的规范名，kv 为空）。
+ArmCommand make_arm_command(const wire::CommandV2& cmd);
 
 /// 指令处理函数签名。
 using ArmCommandHandler = EventDTOUtil::KvMap (*)(const ArmCommand& cmd, IArmClient& arm, const Logger& logger);
 
-/// 为指定操作名注册 handler（例如 "moveL"）。
+/// 为指定操作名注册扩展 handler（例如模块提供的 "demo_echo"）。
+///
+/// 内置 op（见 workstation/arm_ops.h）在编译期绑定；同名注册会覆盖内置实现。
+/// 覆盖 v2 可表达的 op 时，handler 需同时处理 cmd.v2（v2 指令的 cmd.kv 为空）。
 void register_arm_handler(const std::string& op, ArmCommandHandler fn);
 
-/// 初始化内置操作的默认 handlers。
-void init_default_arm_handlers();
-
 /// 处理一条指令并返回 KV 响应负载（将被封装到 DTO 后发布到 /arm/status）。
 EventDTOUtil::KvMap handle_arm_command(const ArmCommand& cmd, IArmClient& arm, const Logger& logger);
 
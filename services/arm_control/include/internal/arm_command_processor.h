@@ -1,24 +1,51 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "dto/event_dto.h"
 #include "logger.h"
 
+#include "internal/arm_error_codes.h"
+#include "workstation/arm_ops.h"
+#include "workstation/arm_wire.h"
+
 namespace wxz::workstation::arm_control::internal {
 
 class IArmClient;
 
-/// arm_control 的业务入口：负责将输入指令（raw KV）处理为输出状态（KV map）。
+/// arm_control 的业务入口：负责将输入指令（raw KV / v2 二进制）处理为输出状态（KV map）。
 ///
-/// - 输入：raw KV 字符串（来自 EventDTO.payload）
-/// - 输出：用于发布到 /arm/status 的 KV map
+/// - 输入：EventDTO.payload（schema ws.arm_command.v1 的 KV 文本，或 ws.arm_command.v2 的二进制）
+/// - 输出：用于发布到 /arm/status 的 KV map（由发布端按指令版本编码）
 class ArmCommandProcessor {
 public:
     /// 处理一条原始指令。
     EventDTOUtil::KvMap handle_raw_command(const std::string& raw,
                                           IArmClient& arm,
                                           const wxz::core::Logger& logger) const;
+
+    /// 处理一条 v2 二进制指令；解码失败时返回 bad_request 响应。
+    EventDTOUtil::KvMap handle_v2_command(const std::string& raw,
+                                         IArmClient& arm,
+                                         const wxz::core::Logger& logger) const;
+
+    /// 处理一条已类型化的指令（RPC 由 JSON 直接构造，不经 KV 文本）。
+    /// op_name 为调用方给出的 op 文本（可为别名），原样写入响应，与 KV 路径一致。
+    EventDTOUtil::KvMap handle_typed_command(const wire::CommandV2& cmd,
+                                            std::string_view op_name,
+                                            IArmClient& arm,
+                                            const wxz::core::Logger& logger) const;
+
+    /// 只解析 op（不执行）；未知 op 或无法解码时返回 nullptr。
+    const ops::OpDesc* peek_op(const std::string& raw, bool v2) const;
+
+    /// 只解析 id 与 op（不执行），用于重复指令判定；无 id 或无法解码时返回 false。
+    /// v2 指令的 op 为描述表中的规范名，v1 为负载中的原文。
+    bool peek_key(const std::string& raw, bool v2, std::string& id, std::string& op) const;
+
+    /// 不执行指令，直接构造带 id/op 的失败响应。
+    EventDTOUtil::KvMap reject_command(const std::string& raw, bool v2, ArmErrc code, std::string_view err) const;
 };
 
 }  // namespace wxz::workstation::arm_control::internal
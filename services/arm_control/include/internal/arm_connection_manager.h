@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "logger.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+class ArmSdkClient;
+
+/// SDK 会话的连接管理：启动时预连接，断线后在后台按指数退避重连。
+///
+/// - 启用后客户端进入 fail-fast：断线期间内置 op 立即回 sdk_unavailable（err_code 2002），
+///   不再在 arm_sdk_strand 上同步重连、逐条等待连接超时。
+/// - 指令执行中 SDK 出错导致的断开由本线程发现（每 check_period 检查一次）并立即重连。
+/// - 连接状态经 state() 与 `wxz.arm.conn.*` 指标对外暴露。
+class ArmConnectionManager {
+public:
+    enum class State : std::uint8_t { Connecting, Connected, Down };
+
+    struct Options {
+        std::chrono::milliseconds backoff_min{200};
+        std::chrono::milliseconds backoff_max{10000};
+        std::chrono::milliseconds check_period{100};
+        std::string name{"primary"};  // 日志与指标中区分会话（primary / priority）
+        std::string metrics_scope{"workstation_arm_control_service"};
+    };
+
+    ArmConnectionManager(ArmSdkClient& arm, Options opts, wxz::core::Logger& logger);
+    ~ArmConnectionManager();
+
+    ArmConnectionManager(const ArmConnectionManager&) = delete;
+    ArmConnectionManager& operator=(const ArmConnectionManager&) = delete;
+
+    /// 同步尝试一次连接（预连接，结果写日志），然后启动后台线程并打开客户端的 fail-fast。
+    void start();
+
+    /// 停止后台线程并关闭 fail-fast（可重复调用）。
+    void stop();
+
+    State state() const { return state_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+    bool attempt();
+    void set_state(State s);
+
+    ArmSdkClient& arm_;
+    Options opts_;
+    wxz::core::Logger& logger_;
+
+    std::atomic<State> state_{State::Connecting};
+    std::chrono::milliseconds backoff_{0};
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool stop_{false};
+    std::thread thread_;
+};
+
+const char* connection_state_name(ArmConnectionManager::State s);
+
+} // namespace wxz::workstation::arm_control::internal
@@ -2,14 +2,39 @@
 
 #include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "internal/arm_control_internal.h"
+#include "internal/arm_rt.h"
+#include "workstation/exec_topology.h"
 
 namespace wxz::workstation::arm_control::internal {
 
+/// 多臂配置（WXZ_ARMS）中的一台机械臂。
+struct ArmInstanceConfig {
+    std::string id;  // 字母/数字/下划线/连字符；用作 topic 后缀与 metrics scope 后缀
+    ArmConn conn;
+};
+
 struct ArmControlConfig {
     ArmConn conn;
 
+    // 多臂：每臂独立的 SDK 会话、命令队列、SDK strand 与 topic（见 arm_lane_name）；为空表示单臂（使用 conn）。
+    std::vector<ArmInstanceConfig> arms;
+    std::string arms_error;  // WXZ_ARMS 解析失败的原因；非空时服务拒绝启动
+
+    // 执行线程布局（见 workstation/exec_topology.h）；RPC handler 跟随所属臂的 SDK strand。
+    wxz::workstation::ExecThreadSpec ingress_thread;  // /arm/command 等订阅回调
+    int sdk_thread{-1};         // 1/0：各臂 SDK strand 独占线程；-1：多臂时独占、单臂时跑在主循环线程上
+    std::vector<int> sdk_cpus;  // 第 i 个臂的 SDK 线程绑到 sdk_cpus[i]；缺项或 <0 不绑核
+    int main_cpu{-1};           // 主循环线程绑核；<0 不绑
+
+    // SDK 线程实时化（SCHED_FIFO / mlockall / 预触摸），默认关闭；启用时 SDK strand 默认独占线程。
+    ArmRtOptions rt;
+    int rt_probe_ms{0};            // 派发抖动探针的探测周期；0 表示关闭
+    int rt_probe_report_ms{10000};  // 探针分位数的输出周期
+
     int domain{0};
 
     // 仅 DTO（FastDDS 负载为 EventDTO 的 CDR 字节流）
@@ -19,6 +44,9 @@ struct ArmControlConfig {
     std::string status_dto_schema{"ws.arm_status.v1"};
     std::string dto_source{"workstation_arm_control_service"};
     std::size_t dto_max_payload{8192};
+    bool wire_v2{false};  // 同时接受 ws.arm_command.v2 二进制指令（按指令版本回复 status）
+    std::string state_topic{"/arm/state"};
+    int state_pub_ms{100};  // /arm/state 发布周期；0 表示不发布
 
     // NodeBase / 健康检查 / 故障
     std::string capability_topic{"capability/status"};
@@ -31,6 +59,19 @@ struct ArmControlConfig {
     std::string health_file;
 
     std::size_t queue_max{64};
+    std::size_t strand_in_flight_max{2};  // 每臂投递到 SDK strand 未执行完的指令上限（其余留在队列里受 queue_max 约束）
+    int loop_idle_ms{50};
+    int state_poll_ms{100};  // 后台状态采样周期；0 表示关闭（查询类 op 全部走实时 SDK 查询）
+    bool async_motion{false};  // /arm/command 的 moveL/moveJ 非阻塞下发，完成后再回复 status
+    bool priority_lane{true};  // emergency_stop/quickStop/fault_reset 经独立会话与线程执行，不排队
+    std::size_t replay_cache_max{0};  // /arm/command 按 id 去重的响应缓存条数（每臂）；0 表示关闭
+    int replay_ttl_ms{60000};         // 已完成响应的保留时长
+    std::size_t path_cache_max{8};   // path_download 解析缓存条数；0 表示关闭缓存
+    std::string path_preload_dir;    // 启动时后台预加载的路径目录；为空不预加载
+    int path_preload_threads{2};
+    bool conn_manager{true};  // 启动预连接 + 后台重连；断线期间指令立即回 sdk_unavailable
+    int reconnect_min_ms{200};
+    int reconnect_max_ms{10000};
     std::string sw_version{"dev"};
 
     // RPC 控制面
@@ -48,4 +89,12 @@ struct ArmControlConfig {
 
 ArmControlConfig load_arm_control_config_from_env();
 
+/// 解析 WXZ_ARMS：逗号分隔的 `id@ip[:port]`，未给出的 port/密码取 defaults。失败时返回原因，out 不完整。
+std::string parse_arm_instances(std::string_view spec, const ArmConn& defaults, std::vector<ArmInstanceConfig>& out);
+
+/// 多臂时各臂的 topic / 服务名 / metrics scope：在单臂名称后追加 `/<arm_id>`；arm_id 为空时原样返回。
+inline std::string arm_lane_name(const std::string& base, const std::string& arm_id) {
+    return arm_id.empty() ? base : base + "/" + arm_id;
+}
+
 } // namespace wxz::workstation::arm_control::internal
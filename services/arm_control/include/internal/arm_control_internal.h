@@ -3,20 +3,25 @@
 #include <array>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include "dto/event_dto.h"
 #include "fastdds_channel.h"
 #include "logger.h"
 
+#include "internal/arm_runtime_tunables.h"
+#include "internal/lockfree_queue.h"
+#include "internal/seqlock.h"
+#include "internal/wakeup_fd.h"
+
 extern "C" {
 #include "robotapi.h"
 }
@@ -48,48 +53,34 @@ struct Env {
     static std::size_t get_size(const char* key, std::size_t def);
 };
 
-/// 解析形如 "a,b,c,d,e,f" 的 6 维 CSV。
-std::optional<std::array<double, 6>> parse_csv6(const std::string& s);
+// 以下数值解析均基于 std::from_chars：不抛异常、不分配；
+// 与 std::stod/stoi 一样接受前导空白与 '+'，但要求整串（CSV 中为整个 token）被完整消费。
+
+/// 解析形如 "a,b,c,d,e,f" 的 6 维 CSV（token 两侧空格会被忽略）。
+std::optional<std::array<double, 6>> parse_csv6(std::string_view s);
+
+/// 解析以 '|' 分隔的多个 6 维 CSV（如 moveL_stepwise 的 poses）；空串、任一段非法或超过 max_points 段返回 std::nullopt。
+std::optional<std::vector<std::array<double, 6>>> parse_csv6_list(std::string_view s, std::size_t max_points);
 
 /// 解析 double；失败返回 std::nullopt。
-std::optional<double> parse_double(const std::string& s);
+std::optional<double> parse_double(std::string_view s);
 
 /// 解析 int；失败返回 std::nullopt。
-std::optional<int> parse_int(const std::string& s);
+std::optional<int> parse_int(std::string_view s);
 
-/// 解析 size_t；失败返回 std::nullopt。
-std::optional<std::size_t> parse_size(const std::string& s);
+/// 解析 size_t（不接受负数）；失败返回 std::nullopt。
+std::optional<std::size_t> parse_size(std::string_view s);
 
 struct Cmd {
     std::string raw;
+    bool v2{false};        // raw 为 ws.arm_command.v2 二进制负载
+    std::int64_t rx_ns{0};  // 入队时刻（steady_clock ns，仅用于观测）
 };
 
-template <class T>
-class MpscQueue {
-public:
-    void push(T v) {
-        std::lock_guard<std::mutex> lock(mu_);
-        q_.push(std::move(v));
-    }
-
-    bool try_pop(T& out) {
-        std::lock_guard<std::mutex> lock(mu_);
-        if (q_.empty()) return false;
-        out = std::move(q_.front());
-        q_.pop();
-        return true;
-    }
-
-    std::size_t size() const {
-        std::lock_guard<std::mutex> lock(mu_);
-        return q_.size();
-    }
-
-private:
-    mutable std::mutex mu_;
-    std::queue<T> q_;
-};
-
+/// 命令入队队列：预分配的有界无锁环（容量取 WXZ_ARM_QUEUE_MAX）。
+///
+/// - push/try_pop 不加锁、不分配；DDS 回调线程与主循环之间无锁竞争。
+/// - pop_for 的阻塞等待基于 eventfd；仅当存在等待方时 push 才会触发 write 系统调用。
 class CmdQueue {
 public:
     /// 创建一个带容量上限的队列（超限时 push 失败）。
@@ -107,11 +98,13 @@ public:
     /// 在 timeout 内等待出队；running() 为 false 时提前返回。
     std::optional<Cmd> pop_for(std::chrono::milliseconds timeout, const std::function<bool()>& running);
 
+    /// 近似队列长度（仅用于观测）。
+    std::size_t size_approx() const { return ring_.size_approx(); }
+
 private:
-    std::mutex mu_;
-    std::condition_variable cv_;
-    std::queue<Cmd> q_;
-    std::size_t max_size_{64};
+    BoundedMpmcQueue<Cmd> ring_;
+    WakeupFd wake_;
+    std::atomic<int> waiters_{0};
 };
 
 struct ArmConn {
@@ -174,10 +167,44 @@ public:
     /// 急停开关。
     virtual CRresult quick_stop(bool enable) = 0;
 
+    /// 立即停止当前运动（emergency_stop）。
+    virtual CRresult emergency_stop(Logger const& logger) = 0;
+
     /// 下载轨迹文件。
     virtual CRresult path_download(const std::string& file, int index, int move_type, std::size_t max_points) = 0;
+
+    /// 当前能否执行 SDK 指令；返回 false 时内置 op 直接以 sdk_unavailable 失败。
+    virtual bool available() const { return true; }
+
+    /// 是否持有已建立的会话（优先通道据此决定是否回退到主客户端）；无会话概念的实现始终为 true。
+    virtual bool connected() const { return true; }
+};
+
+/// 机器人状态采样（由 ArmStatePoller 周期写入，查询类 op 优先读取）。
+///
+/// 平凡可拷贝：经 Seqlock 在采样线程与查询线程之间传递。
+struct ArmStateSample {
+    std::int64_t ts_ns{0};  // 采样开始时刻（steady_clock）
+    int mode{0};            // enum RobotModes
+    bool moving{false};
+    int control_mode{-1};
+    unsigned int speed_percent{0};
+    std::array<double, 6> joint_deg{};
+    int start_di_index{-1};  // 采样时使用的 DI 序号（与当前 tunables 不一致时视为无效）
+    int stop_di_index{-1};
+    bool start_di{false};
+    bool stop_di{false};
+    int path_run_status{0};  // SDK pathrunstatus：1=running
 };
 
+/// robot mode 是否视为“就绪”（ProgramStop/Jog/JointIdle）。
+bool robot_mode_is_ready(int mode);
+
+/// robot mode 是否视为“已上电”（非 JointPowerOff/Closed）。
+bool robot_mode_is_powered(int mode);
+
+class ArmPathCache;
+
 /// 基于 SDK 的机械臂客户端实现。
 class ArmSdkClient final : public IArmClient {
 public:
@@ -186,7 +213,7 @@ public:
     ~ArmSdkClient() override;
 
     // --- 高层辅助函数（行为/PLC 集成）---
-    // 注意：DI 映射可通过环境变量配置：
+    // 注意：DI 映射来自本臂的 ArmRuntimeTunables（启动时读环境变量，运行期可由本臂的 arm.set_tunables 替换）：
     // - WXZ_ARM_START_DI_INDEX（默认：0）
     // - WXZ_ARM_STOP_DI_INDEX （默认：1）
     /// 机械臂是否就绪（综合判断）。
@@ -218,6 +245,7 @@ public:
 
     /// 急停。
     CRresult EmergencyStop(Logger const& logger);
+    CRresult emergency_stop(Logger const& logger) override { return EmergencyStop(logger); }
 
     /// 重置系统（用于故障恢复流程）。
     CRresult ResetSystem(Logger const& logger);
@@ -239,6 +267,127 @@ public:
     CRresult quick_stop(bool enable) override;
     CRresult path_download(const std::string& file, int index, int move_type, std::size_t max_points) override;
 
+    /// path_download 使用的解析缓存（见 ArmPathCache）；为空时每次都读文件并解析。启动前设置。
+    void set_path_cache(ArmPathCache* cache) { path_cache_ = cache; }
+
+    /// 本臂的运行期可调参数仓库（多臂时每臂一份，同臂的主/优先通道会话共用）；启动前设置。
+    /// 未设置时使用进程级缺省仓库 arm_runtime_tunables()。
+    void set_tunables_store(ArmRuntimeTunablesStore* store) { tunables_ = store ? store : &arm_runtime_tunables(); }
+    ArmRuntimeTunablesStore& tunables_store() const { return *tunables_; }
+
+    /// 当前快照；同一次操作只取一次并复用（见 arm_runtime_tunables.h）。
+    const ArmRuntimeTunables& tunables() const { return tunables_->current(); }
+
+    /// 本客户端自报指标（等待循环等）的 scope；启动前设置。
+    void set_metrics_scope(std::string scope) { metrics_scope_ = std::move(scope); }
+    const std::string& metrics_scope() const { return metrics_scope_; }
+
+    // --- 状态采样（ArmStatePoller）---
+    enum class SampleResult { Ok, Busy, Disconnected, Failed };
+
+    /// 采样一次机器人状态并写入快照。
+    ///
+    /// 只在 SDK 空闲时进行（try_lock，不与运动/查询争锁），也不主动建立连接；
+    /// 读失败时保持旧快照、不断开连接，重连交给实时路径处理。
+    SampleResult sample_state();
+
+    /// 年龄不超过 tunables.state_max_age_ms 的快照；否则返回 std::nullopt（调用方走实时 SDK 查询）。
+    std::optional<ArmStateSample> cached_state() const;
+
+    /// moveL/moveJ 运动前检查使用的快照：年龄不超过 tunables.precheck_max_age_ms，且晚于本客户端上一次运动结束；
+    /// 否则返回 std::nullopt（实时读取）。
+    std::optional<ArmStateSample> precheck_snapshot() const;
+
+    /// 最近一次成功采样（不论年龄）；尚未采样过时返回 false。用于 /arm/state 发布。
+    bool latest_state(ArmStateSample& out) const { return state_.load(out); }
+
+    struct StateCacheStats {
+        std::uint64_t hits{0};
+        std::uint64_t misses{0};
+    };
+
+    StateCacheStats state_cache_stats() const {
+        return StateCacheStats{cache_hits_.load(std::memory_order_relaxed),
+                               cache_misses_.load(std::memory_order_relaxed)};
+    }
+
+    // --- 非阻塞运动（ArmMotionTracker）---
+
+    /// 作用域内 moveL/moveJ 以非阻塞方式下发：SDK 接受指令即返回 success 并标记“运动进行中”，
+    /// 完成由调用方经 poll_motion()/finish_motion() 跟踪。作用域外（如 RPC 路径）保持阻塞下发。
+    ///
+    /// 只应在 arm_sdk_strand 上使用（与 RPC 路径串行，不会与其它 SDK 调用交错）。
+    class AsyncMotionScope {
+    public:
+        explicit AsyncMotionScope(ArmSdkClient& arm);
+        ~AsyncMotionScope();
+
+        AsyncMotionScope(const AsyncMotionScope&) = delete;
+        AsyncMotionScope& operator=(const AsyncMotionScope&) = delete;
+
+        /// 本作用域内是否下发了一次非阻塞运动。
+        bool started() const;
+
+    private:
+        ArmSdkClient& arm_;
+    };
+
+    /// 当前是否处于 AsyncMotionScope 内（moveL/moveJ 以非阻塞方式下发）。
+    bool async_motion_enabled() const;
+
+    /// 非阻塞的逐点运动（moveL_stepwise）：指令处理函数只下发第 0 段并登记本结构，
+    /// 其余段由运动跟踪方在上一段正常结束后逐段下发；某段失败或被急停/停止打断时不再续发。
+    struct MotionSequence {
+        std::size_t total{0};
+        std::size_t issued{0};  // 已下发的段数
+        std::function<CRresult(std::size_t index)> issue;  // 非阻塞下发第 index 段
+    };
+
+    /// 登记续发信息（覆盖未取走的旧值）；取走后清空。只应在 arm_sdk_strand 上使用。
+    void set_motion_sequence(MotionSequence seq);
+    std::optional<MotionSequence> take_motion_sequence();
+
+    /// 是否有已下发、尚未 finish_motion() 的非阻塞运动；此时新的 moveL/moveJ/轨迹执行会被拒绝。
+    bool motion_in_flight() const;
+
+    /// 运动进行中是否执行过急停/quickStop（其后“停止运动”不能视为正常完成）。
+    bool motion_interrupted() const;
+
+    /// 读取运动状态（cr_get_robotMoveStatus）。
+    CRresult poll_motion(bool& moving);
+
+    /// 停止当前运动（cr_stop）。
+    CRresult stop_motion();
+
+    /// 结束跟踪，清除“运动进行中/被中断”标记。
+    void finish_motion();
+
+    // --- 优先通道（ArmPriorityLane）---
+
+    /// 当前是否持有已建立的 SDK 会话（无锁读取，阻塞运动期间也可调用）。
+    bool connected() const override { return link_up_.load(std::memory_order_acquire); }
+
+    // --- 连接管理（ArmConnectionManager）---
+
+    /// 建立会话（已连接时直接返回 success）。SDK 连接在锁外进行，不阻塞正在执行的指令。
+    CRresult try_connect();
+
+    /// 打开后 ensure_connected() 不再同步重连：断线期间指令立即失败，由 ArmConnectionManager 在后台重连。
+    void set_fail_fast(bool on) { fail_fast_.store(on, std::memory_order_release); }
+
+    bool available() const override {
+        return !fail_fast_.load(std::memory_order_acquire) || link_up_.load(std::memory_order_acquire);
+    }
+
+    /// 本客户端执行急停/quickStop 后通知 peer（优先通道的独立客户端 -> 主客户端）。启动前设置。
+    void set_stop_peer(ArmSdkClient* peer) { stop_peer_ = peer; }
+
+    /// 记录一次来自其它会话的停止；无锁，可在任意线程调用（主客户端可能正被阻塞运动占用）。
+    /// 运动等待循环、轨迹执行与非阻塞运动跟踪据此提前以失败结束。
+    void note_stop_requested() { stop_epoch_.fetch_add(1, std::memory_order_acq_rel); }
+
+    std::uint64_t stop_epoch() const { return stop_epoch_.load(std::memory_order_acquire); }
+
 private:
     /// 连接到机械臂控制器。
     CRresult connect();
@@ -258,10 +407,31 @@ private:
     ArmConn conn_;
     RobotHandle handle_{0};
     bool connected_{false};
+    std::atomic<bool> link_up_{false};  // connected_ 的无锁镜像
+    std::atomic<bool> fail_fast_{false};
 
     // SDK handle + session 有状态且未声明线程安全。
     // 该服务存在多线程（DDS 回调 + 主循环），因此需要串行化所有 SDK 访问。
     mutable std::recursive_mutex sdk_mu_;
+
+    // 均由 sdk_mu_ 保护。
+    bool async_motion_{false};
+    bool motion_started_{false};
+    bool motion_in_flight_{false};
+    bool motion_interrupted_{false};
+    std::uint64_t motion_stop_epoch_{0};  // 下发非阻塞运动时的 stop_epoch_
+    std::int64_t motion_done_ns_{0};      // 上一次 moveL/moveJ 返回或非阻塞运动结束的时刻（steady_clock）
+    std::optional<MotionSequence> motion_seq_;
+
+    ArmSdkClient* stop_peer_{nullptr};
+    ArmPathCache* path_cache_{nullptr};
+    ArmRuntimeTunablesStore* tunables_{&arm_runtime_tunables()};
+    std::string metrics_scope_{"workstation_arm_control_service"};
+    std::atomic<std::uint64_t> stop_epoch_{0};
+
+    Seqlock<ArmStateSample> state_;
+    mutable std::atomic<std::uint64_t> cache_hits_{0};
+    mutable std::atomic<std::uint64_t> cache_misses_{0};
 };
 
 } // namespace wxz::workstation::arm_control::internal
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "logger.h"
 
@@ -17,6 +18,7 @@ class Strand;
 namespace wxz::workstation::arm_control::internal {
 
 class ArmCommandProcessor;
+class ArmSdkClient;
 class IArmClient;
 class CmdQueue;
 
@@ -32,6 +34,32 @@ struct ArmControlTopics {
     std::string fault_action_topic{"fault/action"};
     std::size_t dto_max_payload{8 * 1024};
     std::string dto_source{"workstation_arm_control_service"};
+
+    // 同时接受 ws.arm_command.v2；v2 指令的 status 以 ws.arm_status.v2 回复（见 workstation/arm_wire.h）。
+    bool wire_v2{false};
+
+    // /arm/state 周期状态样本（ws.arm_state.v1）；topic 为空或周期 <= 0 时不发布。
+    std::string state_topic{"/arm/state"};
+    int state_pub_ms{100};
+};
+
+/// 一条机械臂通道：SDK 客户端、命令队列、SDK strand、status 发布器与 topic 均为该臂独占。
+///
+/// 多臂时每臂一条（见 ArmControlConfig::arms）：某臂的阻塞运动/排队指令不会延后其它臂的指令；
+/// 各通道的 strand 可以跑在各自的 executor 线程上，也可以共用主循环的 executor。
+struct ArmLane {
+    std::string arm_id;  // 多臂配置中的 id（日志与故障名中区分各臂）；单臂为空
+    IArmClient* arm{nullptr};
+    CmdQueue* queue{nullptr};
+    wxz::core::Strand* sdk_strand{nullptr};
+    wxz::workstation::EventDtoPublisher* status_pub{nullptr};
+    ArmControlTopics topics;
+
+    // 非空时启用该臂的优先通道（独立 SDK 会话，见 ArmControlLoop::Options::priority_arm）。
+    ArmSdkClient* priority_arm{nullptr};
+
+    // 该臂指标的 scope 标签；为空时使用 ArmControlLoop::Options::metrics_scope。
+    std::string metrics_scope;
 };
 
 class ArmControlLoop {
@@ -39,8 +67,26 @@ public:
     struct Options {
         std::string metrics_scope{"workstation_arm_control_service"};
         std::size_t queue_max{64};
+
+        // 每臂同时投递到 arm_sdk_strand、尚未执行完的指令上限；其余留在 CmdQueue（满时 queue_full）。
+        std::size_t strand_in_flight_max{2};
+
+        // moveL/moveJ 以非阻塞方式下发，由 ArmMotionTracker 在 arm_sdk_strand 上轮询完成后再回复 /arm/status；
+        // 运动期间 strand 可继续处理查询与停止类指令（见 arm_motion_tracker.h）。
+        bool async_motion{false};
+
+        // 非空时启用优先通道：emergency_stop/quickStop/fault_reset 不进普通队列，
+        // 由该客户端（独立 SDK 会话，不可与主客户端共用）在专用线程上立即执行（见 arm_priority_lane.h）。
+        // 仅用于单臂构造函数；多臂时由各 ArmLane::priority_arm 指定。
+        ArmSdkClient* priority_arm{nullptr};
+
+        // >0 时启用 /arm/command 的重复指令判定（按 id 缓存最近的响应，见 arm_replay_cache.h）；0 表示关闭。
+        // 每臂各一份；急停/停止/复位类指令不参与判定。
+        std::size_t replay_cache_max{0};
+        std::chrono::milliseconds replay_ttl{60000};
     };
 
+    /// 单臂：等价于只有一条 ArmLane 的多臂构造。
     ArmControlLoop(wxz::workstation::Node& node,
                   wxz::core::Executor& exec,
                   wxz::core::Strand& arm_sdk_strand,
@@ -52,17 +98,25 @@ public:
                   Options opts,
                   wxz::core::Logger& logger);
 
-    void run(std::chrono::milliseconds pop_timeout = std::chrono::milliseconds(200));
+    /// 多臂：lanes 中各臂的 topic 必须互不相同；fault/action 订阅取第一条通道的 fault_action_topic。
+    ArmControlLoop(wxz::workstation::Node& node,
+                  wxz::core::Executor& exec,
+                  ArmCommandProcessor& processor,
+                  std::vector<ArmLane> lanes,
+                  Options opts,
+                  wxz::core::Logger& logger);
+
+    /// 运行主循环直到 NodeBase 停止。
+    ///
+    /// 有工作时每轮取空所有就绪项；空闲时阻塞在 executor 上，
+    /// 由新任务或跨线程 wakeup 唤醒，最长等待 idle_wait（用于驱动 tick 的周期任务）。
+    void run(std::chrono::milliseconds idle_wait = std::chrono::milliseconds(50));
 
 private:
     wxz::workstation::Node& node_;
     wxz::core::Executor& exec_;
-    wxz::core::Strand& arm_sdk_strand_;
     ArmCommandProcessor& processor_;
-    IArmClient& arm_;
-    CmdQueue& queue_;
-    wxz::workstation::EventDtoPublisher& status_pub_;
-    ArmControlTopics topics_;
+    std::vector<ArmLane> lanes_;
     Options opts_;
     wxz::core::Logger& logger_;
 };
@@ -30,6 +30,7 @@ enum class ArmErrc : int {
     InvalidArgs = 1004,
     QueueFull = 1101,
     UnknownOp = 1102,
+    MotionInterrupted = 1103,  // 非阻塞运动被急停/quickStop/停止信号打断（含其后排队的运动指令）
 
     // SDK 层
     SdkUnavailable = 2002,
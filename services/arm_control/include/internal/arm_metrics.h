@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "metrics.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+/// arm_control 自有指标的上报入口。
+///
+/// - 指标统一以 `wxz.arm.*` 命名，并带上 `scope` 标签（与 Options::metrics_scope 一致）。
+/// - 实际输出由 MotionCore 的 metrics sink 决定（app 中 set_metrics_sink 之前为 no-op）。
+/// - 热路径只累加本地计数，由主循环周期性调用这里的函数汇总上报。
+struct ArmMetrics {
+    static void counter_add(std::string_view name, double delta, const std::string& scope) {
+        wxz::core::metrics().counter_add(name, delta, {{"scope", scope}});
+    }
+
+    static void gauge_set(std::string_view name, double value, const std::string& scope) {
+        wxz::core::metrics().gauge_set(name, value, {{"scope", scope}});
+    }
+
+    static void observe(std::string_view name, double value, const std::string& scope) {
+        wxz::core::metrics().histogram_observe(name, value, {{"scope", scope}});
+    }
+};
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+#include "internal/arm_control_internal.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+/// 非阻塞运动的完成跟踪状态机：Idle -> Starting（等待开始运动）-> Moving（等待停止）-> Idle。
+///
+/// - 由 arm_sdk_strand 上的任务按 next_poll() 调用 poll()，每次只做几次短 SDK 查询，不阻塞 strand；
+///   间隔按 adaptive_poll_period 随运动时长从 5ms 退避到 20ms（等待开始）/ 50ms（等待停止）。
+/// - 判定规则与阻塞下发的 fallback-wait 一致：start_grace 内未观察到运动、运动超过 complete_timeout、
+///   停止信号（DI）触发都视为失败；另外运动期间执行过急停/quickStop 时以 CR_FAILED 结束。
+/// - 非线程安全：只在 arm_sdk_strand 上使用。
+class ArmMotionTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Phase { Idle, Starting, Moving };
+
+    /// 结束原因（用于日志与响应中的 err）。
+    enum class End { None, Completed, NotStarted, Timeout, StopSignal, Interrupted, SdkError };
+
+    explicit ArmMotionTracker(ArmSdkClient& arm) : arm_(arm) {}
+
+    /// 开始跟踪刚下发成功的运动；start_grace/complete_timeout 取自当前 tunables。
+    void begin(Clock::time_point now);
+
+    bool active() const { return phase_ != Phase::Idle; }
+    Phase phase() const { return phase_; }
+    Clock::time_point next_poll() const { return next_poll_; }
+    Clock::time_point started_at() const { return started_; }
+
+    /// 推进一次；运动结束时返回结果码（success / move_error / operate_timeout / CR_FAILED / SDK 错误码），
+    /// 同时清除 ArmSdkClient 的“运动进行中”标记并回到 Idle。
+    std::optional<CRresult> poll(Clock::time_point now);
+
+    /// 最近一次结束的原因。
+    End last_end() const { return last_end_; }
+
+    /// 结束前最后一个轮询间隔，即完成检测延迟的上界。
+    std::chrono::milliseconds last_poll_period() const { return last_period_; }
+
+private:
+    CRresult finish(End why, CRresult r);
+    void schedule(Clock::time_point now, std::chrono::milliseconds max_period);
+
+    ArmSdkClient& arm_;
+    Phase phase_{Phase::Idle};
+    End last_end_{End::None};
+    Clock::time_point started_{};
+    Clock::time_point deadline_{};
+    Clock::time_point next_poll_{};
+    std::chrono::milliseconds complete_timeout_{0};
+    std::chrono::milliseconds last_period_{0};
+};
+
+const char* motion_end_name(ArmMotionTracker::End e);
+
+} // namespace wxz::workstation::arm_control::internal
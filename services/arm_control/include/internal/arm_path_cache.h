@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "logger.h"
+
+#include "internal/arm_control_internal.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+/// 预加载使用的点缓冲容量：与 path_download 的 maxPoints 默认值一致，默认参数的下发可直接命中。
+inline constexpr std::size_t kDefaultPathMaxPoints = 10000;
+
+/// path_download 的路径解析缓存：按文件内容哈希缓存 cr_path_file2pathData 的结果，
+/// 重复下发同一条生产路径时跳过文件读取与解析。
+///
+/// - 命中判定：同一路径的 size/mtime 未变直接命中（只做一次 stat）；否则 mmap 源文件计算内容哈希，
+///   内容相同（包括复制/touch 过的文件）仍命中，不同才重新解析。
+/// - 解析结果的点缓冲来自复用池：淘汰的条目与解析失败的缓冲归还池中，避免每次 new/delete 大块内存。
+/// - cr_path_file2pathData 的可重入性未知：解析始终串行（parse_mu_），并行预加载只并行哈希部分。
+/// - 线程安全：acquire() 可在 arm_sdk_strand 与预加载线程上同时调用。
+class ArmPathCache {
+public:
+    struct Options {
+        std::size_t max_entries{8};  // 缓存的解析结果条数上限（LRU 淘汰）
+        std::size_t pool_max{4};     // 空闲点缓冲的保留个数
+        std::string metrics_scope{"workstation_arm_control_service"};
+    };
+
+    /// 一条解析结果；data.pathPoints 指向 points，在持有 shared_ptr 期间有效（被淘汰也不会释放）。
+    struct Entry {
+        std::unique_ptr<PathPoint[]> points;
+        std::size_t capacity{0};
+        PathData data{};
+        std::uint64_t hash{0};
+        std::uint64_t size{0};
+    };
+
+    using Lease = std::shared_ptr<const Entry>;
+
+    ArmPathCache(Options opts, wxz::core::Logger& logger);
+    ~ArmPathCache();
+
+    ArmPathCache(const ArmPathCache&) = delete;
+    ArmPathCache& operator=(const ArmPathCache&) = delete;
+
+    /// 取 file 的解析结果（容量不小于 max_points）；未命中时解析并缓存。失败返回 SDK 错误码，out 置空。
+    CRresult acquire(const std::string& file, std::size_t max_points, Lease& out);
+
+    /// 后台预加载目录下的所有普通文件（不递归）；threads 个线程并行读取/哈希。重复调用时等待上一轮结束。
+    void preload_dir(const std::string& dir, std::size_t max_points, unsigned threads);
+
+private:
+    struct PathKey {
+        std::uint64_t hash{0};
+        std::uint64_t size{0};
+        std::int64_t mtime_ns{0};
+    };
+
+    struct Buffer {
+        std::unique_ptr<PathPoint[]> points;
+        std::size_t capacity{0};
+    };
+
+    using LruList = std::list<std::shared_ptr<Entry>>;
+
+    Lease find_locked(std::uint64_t hash, std::uint64_t size, std::size_t max_points);
+    void insert_locked(std::shared_ptr<Entry> entry);
+    Buffer take_buffer_locked(std::size_t max_points);
+    void give_buffer_locked(Buffer buf);
+    CRresult parse(const std::string& file, std::size_t max_points, std::shared_ptr<Entry>& out);
+    void run_preload(std::string dir, std::size_t max_points, unsigned threads);
+
+    Options opts_;
+    wxz::core::Logger& logger_;
+
+    std::mutex mu_;  // 保护 lru_/by_hash_/by_path_/pool_
+    LruList lru_;    // 头部为最近使用
+    std::unordered_map<std::uint64_t, LruList::iterator> by_hash_;
+    std::unordered_map<std::string, PathKey> by_path_;
+    std::vector<Buffer> pool_;
+
+    std::mutex parse_mu_;
+    std::thread preload_;
+    std::atomic<bool> stopping_{false};
+};
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "dto/event_dto.h"
+#include "logger.h"
+
+#include "internal/arm_control_internal.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+class ArmCommandProcessor;
+
+/// 急停/quickStop/fault_reset 的优先通道。
+///
+/// - 独立的小队列 + 独立线程 + 独立 SDK 会话（ArmSdkClient 各自持有 handle 与锁），
+///   不排在普通 CmdQueue/arm_sdk_strand 的积压之后，也不等待被阻塞运动占用的主客户端锁。
+/// - 停止类指令执行后通过 ArmSdkClient::note_stop_requested() 通知主客户端，正在进行的运动等待随即结束。
+/// - 独立会话无法建立时（控制器不接受第二个连接等），该条指令回退到主客户端执行：
+///   仍不排队，但需等待主客户端锁。
+/// - 每条指令的响应经 on_reply 回调（在本线程）交给主循环发布。
+class ArmPriorityLane {
+public:
+    struct Options {
+        std::size_t queue_max{16};
+        std::string metrics_scope{"workstation_arm_control_service"};
+    };
+
+    using ReplyFn = std::function<void(EventDTOUtil::KvMap kv, bool v2)>;
+
+    /// arm 为优先通道专用的客户端（不可与主循环共用）；primary 为主客户端。
+    /// 两者均为 ArmSdkClient 时，arm 执行停止后通知 primary（set_stop_peer）。
+    ArmPriorityLane(ArmCommandProcessor& processor,
+                    IArmClient& arm,
+                    IArmClient& primary,
+                    Options opts,
+                    wxz::core::Logger& logger);
+    ~ArmPriorityLane();
+
+    ArmPriorityLane(const ArmPriorityLane&) = delete;
+    ArmPriorityLane& operator=(const ArmPriorityLane&) = delete;
+
+    void start(ReplyFn on_reply);
+
+    /// 停止并等待线程退出（可重复调用）。
+    void stop();
+
+    /// 入队；队列已满时返回 false。
+    bool submit(Cmd cmd) { return queue_.push(std::move(cmd)); }
+
+private:
+    void run();
+
+    ArmCommandProcessor& processor_;
+    IArmClient& arm_;
+    IArmClient& primary_;
+    Options opts_;
+    wxz::core::Logger& logger_;
+    CmdQueue queue_;
+    ReplyFn on_reply_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace wxz::workstation::arm_control::internal
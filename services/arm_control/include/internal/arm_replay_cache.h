@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "dto/event_dto.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+/// /arm/command 的幂等处理：按指令 id 记住最近的执行结果，重复到达的同一 id 不再执行。
+///
+/// - 新 id：登记为在途后照常执行；完成时记下响应，TTL 从完成时刻算起。
+/// - 已完成且未过期的 id：直接重发缓存的 /arm/status（重传、或发送方丢了 status 后重发）。
+/// - 仍在途的 id：挂到正在进行的执行上，不再入队；执行完成时发布的 status 同时回应所有重发。
+/// - 同一 id 但 op 不同视为新指令（覆盖旧条目），避免不同发送方的 id 碰撞被误判为重复。
+/// - 条数超过 max_entries 时按登记顺序淘汰最旧的条目（含在途条目，之后同 id 的重发会再次执行）。
+///
+/// 失败结果同样缓存：同一 id 的重发得到相同的失败 status，重试须使用新 id。
+/// 非线程安全：只在主循环线程上使用（派发前查表、发布 status 时回填）。
+class ArmReplayCache {
+public:
+    struct Options {
+        std::size_t max_entries{256};
+        std::chrono::milliseconds ttl{60000};
+    };
+
+    enum class Verdict {
+        Execute,   // 首次出现：已登记为在途，照常执行
+        Replay,    // 已完成：cached 指向缓存的响应
+        Attached,  // 仍在途：不执行，等待进行中的执行回复
+    };
+
+    struct Stats {
+        std::uint64_t replayed{0};
+        std::uint64_t attached{0};
+        std::uint64_t evicted_in_flight{0};
+    };
+
+    explicit ArmReplayCache(Options opts) : opts_(opts) {}
+
+    /// 派发前查表。返回 Replay 时 cached 在下一次修改本缓存前有效。
+    Verdict admit(const std::string& id,
+                  const std::string& op,
+                  std::chrono::steady_clock::time_point now,
+                  const EventDTOUtil::KvMap*& cached);
+
+    /// 指令完成：在途条目转为已完成并记下响应；id 不在途时忽略（如重发的缓存 status）。
+    void complete(const std::string& id, const EventDTOUtil::KvMap& resp, std::chrono::steady_clock::time_point now);
+
+    /// 指令未能执行（投递失败等）：移除在途条目，重发时重新执行。
+    void forget(const std::string& id);
+
+    std::size_t size() const { return entries_.size(); }
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Entry {
+        std::string op;
+        bool done{false};
+        std::chrono::steady_clock::time_point expires;
+        EventDTOUtil::KvMap resp;
+        std::uint64_t seq{0};
+    };
+
+    void evict_overflow();
+
+    Options opts_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::deque<std::pair<std::string, std::uint64_t>> order_;  // 登记顺序；seq 不符的项为已被覆盖/移除的旧登记
+    std::uint64_t next_seq_{1};
+    Stats stats_;
+};
+
+} // namespace wxz::workstation::arm_control::internal
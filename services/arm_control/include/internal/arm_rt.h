@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger.h"
+
+namespace wxz::core {
+class Strand;
+} // namespace wxz::core
+
+namespace wxz::workstation::arm_control::internal {
+
+/// SDK 线程的实时化选项（WXZ_ARM_RT*）。默认关闭：不改变调度策略与内存行为。
+struct ArmRtOptions {
+    bool enable{false};
+    int fifo_priority{80};               // SCHED_FIFO 优先级（1..99）
+    bool mlock{true};                    // mlockall(MCL_CURRENT | MCL_FUTURE)
+    std::size_t stack_prefault{512 * 1024};        // SDK 线程栈预触摸字节数
+    std::size_t heap_reserve{64 * 1024 * 1024};    // 每个 SDK 线程在其 malloc arena 中预触摸并保留的字节数
+    bool required{false};                // 自检失败时拒绝启动（否则只告警，按普通线程运行）
+};
+
+/// 实时化的自检结果：各项是否生效及失败原因（用于启动日志与指标）。
+struct ArmRtStatus {
+    bool mlocked{false};
+    bool heap_reserved{false};
+    bool fifo{false};
+    bool stack_prefaulted{false};
+    std::size_t heap_reserved_bytes{0};  // 实际在 SDK 线程 arena 中预触摸的字节数
+    std::vector<std::string> problems;
+
+    // 未请求的项（mlock=false、reserve/prefault 为 0）在 setup 中直接记为已满足。
+    bool ok() const { return mlocked && heap_reserved && fifo && stack_prefaulted; }
+};
+
+/// 进程级准备：关闭堆收缩与 mmap 大块分配、mlockall。在创建 SDK 线程前调用一次。
+void arm_rt_setup_process(const ArmRtOptions& opts, ArmRtStatus& status);
+
+/// 线程级准备：把调用线程切到 SCHED_FIFO、预触摸栈，并在该线程的 malloc arena 中预留 heap_reserve。
+/// 必须在 SDK 线程上执行（投递到其 strand）：glibc 按线程分配 arena，在主线程上预留的内存 SDK 线程用不上。
+void arm_rt_setup_thread(const ArmRtOptions& opts, ArmRtStatus& status);
+
+/// 把自检结果写成一行日志并上报 wxz.arm.rt.active（0/1）。
+void arm_rt_report(const ArmRtOptions& opts, const ArmRtStatus& status, const std::string& metrics_scope,
+                   wxz::core::Logger& logger);
+
+/// 派发抖动探针：周期性向 SDK strand 投递空任务，测量从投递到开始执行的延迟，
+/// 按 report_period 输出 p50/p99/p99.9/max（日志 + wxz.arm.rt.dispatch_*_us）。
+///
+/// - 同一时刻只有一个探测任务在途：SDK 线程被阻塞运动占用时，该次延迟如实计入（反映真实排队）。
+/// - 结果只在探针线程上统计，SDK 线程上只写一个时间戳，不加锁。
+/// - 在 RT 开/关两种配置下各运行一段时间，对比日志中的分位数即可评估实时化效果。
+class ArmDispatchProbe {
+public:
+    struct Options {
+        std::chrono::milliseconds period{10};
+        std::chrono::milliseconds report_period{10000};
+        std::string label;  // 日志中区分各臂
+        std::string metrics_scope{"workstation_arm_control_service"};
+        bool rt{false};     // 仅用于日志标注
+    };
+
+    ArmDispatchProbe(wxz::core::Strand& strand, Options opts, wxz::core::Logger& logger);
+    ~ArmDispatchProbe();
+
+    ArmDispatchProbe(const ArmDispatchProbe&) = delete;
+    ArmDispatchProbe& operator=(const ArmDispatchProbe&) = delete;
+
+    void start();
+    void stop();
+
+private:
+    void run();
+    void report();
+
+    wxz::core::Strand& strand_;
+    Options opts_;
+    wxz::core::Logger& logger_;
+
+    std::vector<std::int64_t> samples_us_;  // 探针线程独占
+    std::atomic<std::int64_t> ran_ns_{0};   // SDK 线程写入的执行时刻；0 表示尚未执行
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool stop_{false};
+    std::thread thread_;
+};
+
+} // namespace wxz::workstation::arm_control::internal
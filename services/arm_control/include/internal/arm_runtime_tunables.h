@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace wxz::workstation::arm_control::internal {
+
+/// 运行期可调参数快照（只读）：启动时从环境变量加载一次，之后只能整体替换。
+///
+/// 热路径（moveL/moveJ、DI 轮询、轨迹执行）只读取这里的普通字段，不再调用 getenv/解析字符串。
+struct ArmRuntimeTunables {
+    int start_di_index{0};                // WXZ_ARM_START_DI_INDEX
+    int stop_di_index{1};                 // WXZ_ARM_STOP_DI_INDEX
+    int path_index{0};                    // WXZ_ARM_PATH_INDEX
+    bool allow_large_angle{false};        // WXZ_ARM_ALLOW_LARGE_ANGLE
+    bool allow_large_joint{false};        // WXZ_ARM_ALLOW_LARGE_JOINT
+    bool dry_run{false};                  // WXZ_ARM_DRY_RUN
+    int move_start_grace_ms{400};         // WXZ_ARM_MOVE_START_GRACE_MS
+    int move_complete_timeout_ms{600000}; // WXZ_ARM_MOVE_COMPLETE_TIMEOUT_MS
+    int state_max_age_ms{250};            // WXZ_ARM_STATE_MAX_AGE_MS：查询 op 可接受的采样快照最大年龄，0 表示总是实时查询
+    int precheck_max_age_ms{100};         // WXZ_ARM_PRECHECK_MAX_AGE_MS：moveL/moveJ 运动前检查可用的快照最大年龄，0 表示总是实时读取
+
+    std::uint64_t generation{0};  // 由 store 在发布时写入；启动快照为 0
+};
+
+/// 从环境变量加载（缺省值同上）。
+ArmRuntimeTunables load_arm_runtime_tunables_from_env();
+
+/// 校验取值范围；不合法时返回字段名，合法返回 nullptr。
+const char* validate_arm_runtime_tunables(const ArmRuntimeTunables& t);
+
+/// RCU 风格的快照仓库。
+///
+/// - 读：current() 为一次 acquire load，无锁、无引用计数；返回的引用在进程内始终有效。
+/// - 写：publish()/update() 在写锁内复制出新快照并原子替换指针；旧快照不回收（每次替换几十字节，
+///   仅由运维 RPC 触发），因此读者无需宽限期即可安全持有引用。
+/// - 基于当前值的修改须用 update()：读取—修改—校验—发布整体在写锁内，并发修改不会互相覆盖。
+/// - 同一次操作应只调用一次 current() 并复用该引用，保证看到的是同一版本的各字段。
+class ArmRuntimeTunablesStore {
+public:
+    explicit ArmRuntimeTunablesStore(ArmRuntimeTunables initial);
+
+    ArmRuntimeTunablesStore(const ArmRuntimeTunablesStore&) = delete;
+    ArmRuntimeTunablesStore& operator=(const ArmRuntimeTunablesStore&) = delete;
+
+    const ArmRuntimeTunables& current() const noexcept { return *cur_.load(std::memory_order_acquire); }
+
+    /// 发布新快照（generation 自动递增），返回已发布的快照。
+    const ArmRuntimeTunables& publish(ArmRuntimeTunables next);
+
+    /// 以最新快照为基础应用 patch、校验并发布（整体持有写锁）。
+    ///
+    /// patch 返回非空字符串表示拒绝（原样写入 err）；校验失败时 err 为 "out_of_range.<字段>"。
+    /// 失败时不发布并返回 nullptr；成功返回已发布的快照。
+    using Patch = std::function<std::string(ArmRuntimeTunables&)>;
+    const ArmRuntimeTunables* update(const Patch& patch, std::string& err);
+
+private:
+    const ArmRuntimeTunables& publish_locked(ArmRuntimeTunables next);
+
+    std::mutex write_mu_;
+    std::vector<std::unique_ptr<const ArmRuntimeTunables>> versions_;
+    std::atomic<const ArmRuntimeTunables*> cur_{nullptr};
+};
+
+/// 进程级缺省仓库；首次访问时从环境变量加载。
+///
+/// 服务内每臂另建一份仓库并经 ArmSdkClient::set_tunables_store 绑定（arm.set_tunables 只改所属臂）；
+/// 这里只供未绑定仓库的客户端使用。
+ArmRuntimeTunablesStore& arm_runtime_tunables();
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "logger.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+class ArmSdkClient;
+
+/// 后台状态采样器：按固定周期调用 ArmSdkClient::sample_state()，刷新查询类 op 使用的快照。
+///
+/// - 独立线程运行，不经过 executor/arm_sdk_strand；SDK 忙（运动或实时查询中）时跳过本轮。
+/// - 每秒上报一次 `wxz.arm.state_poll.*` 与 `wxz.arm.state_cache.*` 指标。
+class ArmStatePoller {
+public:
+    struct Options {
+        std::chrono::milliseconds period{100};
+        std::string metrics_scope{"workstation_arm_control_service"};
+    };
+
+    ArmStatePoller(ArmSdkClient& arm, Options opts, wxz::core::Logger& logger);
+    ~ArmStatePoller();
+
+    ArmStatePoller(const ArmStatePoller&) = delete;
+    ArmStatePoller& operator=(const ArmStatePoller&) = delete;
+
+    void start();
+
+    /// 停止并等待采样线程退出（可重复调用）。
+    void stop();
+
+private:
+    void run();
+
+    struct Counters {
+        std::uint64_t ok{0};
+        std::uint64_t busy{0};
+        std::uint64_t disconnected{0};
+        std::uint64_t failed{0};
+        std::uint64_t cache_hits{0};
+        std::uint64_t cache_misses{0};
+    };
+
+    void report_metrics(const Counters& now, Counters& reported, std::chrono::steady_clock::time_point last_ok);
+
+    ArmSdkClient& arm_;
+    Options opts_;
+    wxz::core::Logger& logger_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool stop_{false};
+    std::thread thread_;
+};
+
+} // namespace wxz::workstation::arm_control::internal
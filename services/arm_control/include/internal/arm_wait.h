@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "internal/arm_metrics.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+/// SDK 等待循环（运动开始/完成、上电/使能、等待启动信号、轨迹执行、非阻塞运动跟踪）共用的轮询节拍。
+///
+/// - 自适应：间隔取已等待时长的 1/8，夹在 [min_period, max_period] 内。刚开始等待时（短运动、
+///   信号已就绪等常见情况）以 min_period 密集轮询，长等待逐步退避到 max_period，检测延迟不超过等待时长的约 1/8。
+/// - 给出 expected（预计完成时刻）时，在其前后 1/4 窗口内固定用 min_period，且不会一次睡过 expected。
+/// - 等待期间持有 SDK 锁，后台状态采样（ArmStatePoller）此时会跳过，因此这里只能主动轮询，无法由采样线程通知。
+struct WaitSpec {
+    const char* op{"wait"};  // 指标名中的 op 段：wxz.arm.wait.<op>.*
+    std::chrono::milliseconds timeout{0};
+    std::chrono::milliseconds min_period{5};
+    std::chrono::milliseconds max_period{50};
+    std::optional<std::chrono::milliseconds> expected;
+};
+
+inline std::chrono::milliseconds adaptive_poll_period(std::chrono::steady_clock::duration elapsed,
+                                                      std::chrono::milliseconds min_period,
+                                                      std::chrono::milliseconds max_period,
+                                                      std::optional<std::chrono::milliseconds> expected = std::nullopt) {
+    using std::chrono::milliseconds;
+    const auto el = std::chrono::duration_cast<milliseconds>(elapsed);
+    milliseconds period = std::clamp(el / 8, min_period, max_period);
+    if (expected) {
+        const milliseconds window = std::max(*expected / 4, max_period);
+        const milliseconds remaining = *expected - el;
+        if (remaining <= window && remaining >= -window) return min_period;
+        if (remaining > milliseconds(0)) period = std::min(period, std::max(remaining - window, min_period));
+    }
+    return period;
+}
+
+/// 按 WaitSpec 轮询 poll，直到它给出结果或超时。
+///
+/// poll() 返回 std::nullopt 表示继续等待，否则其值即为结果（成功或提前失败）；超时返回 std::nullopt。
+/// 结束时上报 wxz.arm.wait.<op>.lag_ms（最后一次轮询前的睡眠，即检测延迟上界）与 polls（轮询次数）。
+template <class Poll>
+std::optional<typename std::invoke_result_t<Poll>::value_type> adaptive_wait(const WaitSpec& spec,
+                                                                             const std::string& metrics_scope,
+                                                                             Poll&& poll) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + spec.timeout;
+    std::chrono::milliseconds last_sleep{0};
+    int polls = 0;
+
+    auto report = [&] {
+        const std::string prefix = std::string("wxz.arm.wait.") + spec.op;
+        ArmMetrics::observe(prefix + ".lag_ms", static_cast<double>(last_sleep.count()), metrics_scope);
+        ArmMetrics::observe(prefix + ".polls", static_cast<double>(polls), metrics_scope);
+    };
+
+    while (true) {
+        ++polls;
+        if (auto r = poll()) {
+            report();
+            return r;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) break;
+        last_sleep = adaptive_poll_period(now - start, spec.min_period, spec.max_period, spec.expected);
+        const auto wake = std::min(now + last_sleep, deadline);
+        std::this_thread::sleep_until(wake);
+    }
+    ArmMetrics::counter_add(std::string("wxz.arm.wait.") + spec.op + ".timeout_total", 1.0, metrics_scope);
+    return std::nullopt;
+}
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace wxz::workstation::arm_control::internal {
+
+// 常见 x86/ARM 平台的 cache line 大小；用于隔离生产者/消费者游标，避免伪共享。
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/// 有界无锁 MPMC 环形队列（Vyukov 算法）。
+///
+/// - 槽位在构造时一次性预分配，push/pop 不再触发堆分配（T 的移动本身除外）。
+/// - 容量按构造参数精确生效（不向上取 2 的幂），满时 try_push 返回 false。
+/// - 每个槽位独占 cache line；head/tail 游标也各自独占 cache line。
+///
+/// 要求：T 可默认构造、可移动赋值。
+template <class T>
+class BoundedMpmcQueue {
+public:
+    explicit BoundedMpmcQueue(std::size_t capacity)
+        : capacity_(capacity == 0 ? 1 : capacity), slots_(new Slot[capacity_]) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    /// 入队；队列已满时返回 false，且 v 保持不变。
+    bool try_push(T&& v) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &slots_[pos % capacity_];
+            const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::move(v);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// 出队；队列为空时返回 false。
+    bool try_pop(T& out) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &slots_[pos % capacity_];
+            const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(slot->value);
+        slot->seq.store(pos + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    /// 近似元素个数（并发下仅用于观测）。
+    std::size_t size_approx() const {
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        const std::size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? (tail - head) : 0;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<std::size_t> seq{0};
+        T value{};
+    };
+
+    const std::size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+};
+
+/// 单次 drain 的批量统计（仅由消费者线程读写）。
+struct MpscDrainStats {
+    std::uint64_t drains{0};     // 取到至少一个元素的 drain 次数
+    std::uint64_t items{0};      // 累计取出的元素数
+    std::size_t last_batch{0};   // 最近一次非空 drain 的批量
+    std::size_t max_batch{0};    // 历史最大批量
+};
+
+/// 无界多生产者/单消费者队列（Vyukov 侵入式 MPSC）。
+///
+/// - 入链为 wait-free：一次原子 exchange + 一次 release store，生产者之间不互相等待。
+/// - 节点在构造时按 pool_size 预分配，并在 pop 后回收到无锁空闲池（取节点为 lock-free）；
+///   稳态下 push/pop 不触发堆分配（池耗尽时才退化为 new）。
+/// - try_pop/drain 只允许单一消费者线程调用。
+/// - 生产者在 exchange 与链接 next 之间被抢占时，消费者会暂时看到“空”，下一轮即可取到。
+///
+/// 要求：T 可默认构造、可移动赋值。
+template <class T>
+class MpscQueue {
+public:
+    explicit MpscQueue(std::size_t pool_size = 64) : pool_(pool_size) {
+        for (std::size_t i = 0; i < pool_.capacity(); ++i) {
+            Node* n = new Node();
+            if (!pool_.try_push(std::move(n))) {
+                delete n;
+                break;
+            }
+        }
+    }
+
+    ~MpscQueue() {
+        T tmp;
+        while (try_pop(tmp)) {
+        }
+        Node* n = nullptr;
+        while (pool_.try_pop(n)) delete n;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T v) {
+        Node* n = nullptr;
+        if (!pool_.try_pop(n)) n = new Node();
+        n->value = std::move(v);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        link(n);
+    }
+
+    bool try_pop(T& out) {
+        Node* n = pop_node();
+        if (!n) return false;
+        out = std::move(n->value);
+        recycle(n);
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// 取出当前可见的全部元素并依次交给 fn(T&&)；返回本次取出的数量并更新批量统计。
+    template <class F>
+    std::size_t drain(F&& fn) {
+        std::size_t n = 0;
+        T v;
+        while (try_pop(v)) {
+            fn(std::move(v));
+            ++n;
+        }
+        if (n > 0) {
+            ++stats_.drains;
+            stats_.items += n;
+            stats_.last_batch = n;
+            if (n > stats_.max_batch) stats_.max_batch = n;
+        }
+        return n;
+    }
+
+    /// 近似元素个数（并发下仅用于观测）。
+    std::size_t size() const {
+        const auto n = pending_.load(std::memory_order_relaxed);
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+    /// drain 批量统计；仅消费者线程可读。
+    const MpscDrainStats& drain_stats() const { return stats_; }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    void link(Node* n) {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    Node* pop_node() {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+        link(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    void recycle(Node* n) {
+        n->value = T{};
+        if (!pool_.try_push(std::move(n))) delete n;
+    }
+
+    Node stub_;
+    // 生产者侧：head_ 与 pending_ 共用一条 cache line；消费者侧独占另一条。
+    alignas(kCacheLineSize) std::atomic<Node*> head_{&stub_};
+    std::atomic<std::int64_t> pending_{0};
+    alignas(kCacheLineSize) Node* tail_{&stub_};
+    MpscDrainStats stats_;
+    BoundedMpmcQueue<Node*> pool_;
+};
+
+} // namespace wxz::workstation::arm_control::internal
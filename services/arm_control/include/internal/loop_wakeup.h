@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "executor.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+/// 主循环的“有新工作”信号。
+///
+/// 主循环空闲时阻塞在 exec.spin_once() 中（executor 的等待本身不占 CPU）。
+/// 生产者若不在主循环线程上，则向 executor 投递一个空任务把它唤醒；
+/// 同一空闲周期内最多投递一次。主循环线程上的生产者（spin_once 内执行的回调/strand 任务）
+/// 无需唤醒：spin_once 返回后循环会立即 drain。
+///
+/// 须在主循环线程上构造（该线程即 owner）。
+class LoopWakeup {
+public:
+    explicit LoopWakeup(wxz::core::Executor& exec) : exec_(exec), owner_(std::this_thread::get_id()) {}
+
+    LoopWakeup(const LoopWakeup&) = delete;
+    LoopWakeup& operator=(const LoopWakeup&) = delete;
+
+    void notify() {
+        if (std::this_thread::get_id() == owner_) return;
+        pending_.store(true);
+        if (idle_.load() && !posted_.exchange(true)) {
+            (void)exec_.post([] {});
+        }
+    }
+
+    /// 进入空闲等待前调用；已有未处理的通知时返回 false（不应阻塞）。
+    bool begin_idle() {
+        idle_.store(true);
+        if (pending_.exchange(false)) {
+            idle_.store(false);
+            return false;
+        }
+        return true;
+    }
+
+    void end_idle() {
+        idle_.store(false);
+        pending_.store(false);
+        posted_.store(false);
+    }
+
+private:
+    wxz::core::Executor& exec_;
+    const std::thread::id owner_;
+    std::atomic<bool> idle_{false};
+    std::atomic<bool> pending_{false};
+    std::atomic<bool> posted_{false};
+};
+
+}  // namespace wxz::workstation::arm_control::internal
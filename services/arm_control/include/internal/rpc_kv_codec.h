@@ -3,6 +3,8 @@
 #include <optional>
 #include <string>
 
+#include "dto/event_dto.h"
+#include "workstation/arm_wire.h"
 #include "workstation/service.h"
 
 namespace wxz::workstation::arm_control::internal {
@@ -17,4 +19,13 @@ std::string json_to_csv(const Json& arr);
 // 要求：params 为 object，且 params["op"] 为 string。
 std::optional<std::string> build_raw_kv_from_params(const Json& params);
 
+// 直接由 JSON-RPC 的 params 构造类型化指令（不经过 KV 文本）：数组直接写入 std::array<double,6>，数值按 JSON 类型读取。
+// 仅当 op 在描述表中且参数都能被 v2 表达、各字段为原生 JSON 类型时返回 true；
+// 否则返回 false，调用方回退到 build_raw_kv_from_params（字符串参数、扩展 op、文本数值等，错误语义与历史一致）。
+// 不属于该 op 的其它字段（trace_id 等）被忽略，与 KV 路径下处理器不读取它们的行为一致。
+bool build_cmd_v2_from_params(const Json& params, wire::CommandV2& out);
+
+// 响应 KV 转成 JSON 对象（值按字符串原样移动，wire format 与历史一致）。
+Json kv_to_json(EventDTOUtil::KvMap&& kv);
+
 } // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace wxz::workstation::arm_control::internal {
+
+/// 单写者 / 多读者的 seqlock 快照。
+///
+/// - 写者 store() 不等待读者；读者 load() 不加锁，遇到并发写入时重试。
+/// - 数据按 64 位字保存在 std::atomic 中（relaxed 读写 + fence），读者与写者之间没有数据竞争。
+/// - 适合小而频繁更新的状态（几十到几百字节）；T 须为平凡可拷贝类型。
+///
+/// 要求：同一时刻只有一个线程调用 store()。
+template <class T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock<T> requires a trivially copyable T");
+
+public:
+    Seqlock() = default;
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    void store(const T& v) noexcept {
+        std::uint64_t buf[kWords]{};
+        std::memcpy(buf, &v, sizeof(T));
+
+        const std::uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    /// 读取最近一次写入的完整值；尚未写入过时返回 false（out 不变）。
+    bool load(T& out) const noexcept {
+        std::uint64_t buf[kWords];
+        for (;;) {
+            const std::uint64_t s1 = seq_.load(std::memory_order_acquire);
+            if (s1 & 1U) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (s1 == 0) return false;
+            for (std::size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == s1) break;
+        }
+        std::memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    /// 已完成的写入次数。
+    std::uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> words_[kWords]{};
+};
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+
+namespace wxz::workstation::arm_control::internal {
+
+/// 基于 Linux eventfd 的跨线程唤醒原语。
+///
+/// - notify()：可在任意线程调用（含 DDS 回调线程），不加锁。
+/// - wait_for()：阻塞等待 notify 或超时；返回前会清空计数。
+/// - fd()：可交给 poll/epoll 统一等待。
+///
+/// eventfd 创建失败时退化为按超时休眠（fd() 返回 -1）。
+class WakeupFd {
+public:
+    WakeupFd();
+    ~WakeupFd();
+
+    WakeupFd(const WakeupFd&) = delete;
+    WakeupFd& operator=(const WakeupFd&) = delete;
+
+    /// 唤醒等待方（多次 notify 可能合并为一次唤醒）。
+    void notify();
+
+    /// 等待唤醒；被唤醒返回 true，超时返回 false。
+    bool wait_for(std::chrono::milliseconds timeout);
+
+    /// 清空已累计的唤醒计数（非阻塞）。
+    void drain();
+
+    int fd() const { return fd_; }
+
+private:
+    int fd_{-1};
+};
+
+} // namespace wxz::workstation::arm_control::internal
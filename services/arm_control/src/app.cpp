@@ -1,10 +1,14 @@
 #include "app.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "fault_recovery_executor.h"
 #include "metrics_http_server.h"
@@ -15,7 +19,12 @@
 #include "internal/arm_control_internal.h"
 #include "internal/arm_error_codes.h"
 #include "internal/arm_command_processor.h"
+#include "internal/arm_connection_manager.h"
 #include "internal/arm_control_loop.h"
+#include "internal/arm_path_cache.h"
+#include "internal/arm_rt.h"
+#include "internal/arm_runtime_tunables.h"
+#include "internal/arm_state_poller.h"
 
 #include "executor.h"
 #include "fastdds_channel.h"
@@ -23,6 +32,7 @@
 
 #include "internal/rpc_control_plane.h"
 
+#include "workstation/exec_topology.h"
 #include "workstation/node.h"
 
 #include "node_base.h"
@@ -184,6 +194,26 @@ static std::unique_ptr<wxz::core::FaultRecoveryExecutor> maybe_start_fault_recov
     return fr;
 }
 
+/// 一台机械臂的运行资源（单臂时只有一份）。
+///
+/// 成员按依赖顺序声明（逆序析构）：sdk_lane 最后析构；运行中的组件由 run() 末尾显式停止。
+struct ArmUnit {
+    std::string id;     // 多臂配置中的 id；单臂为空
+    std::string scope;  // metrics scope
+    wxz::workstation::arm_control::internal::ArmConn conn;
+
+    std::unique_ptr<wxz::workstation::ExecLane> sdk_lane;  // SDK strand（独占线程或主 executor）
+    std::unique_ptr<wxz::workstation::arm_control::internal::ArmRuntimeTunablesStore> tunables;  // 本臂的运行期参数
+    std::unique_ptr<wxz::workstation::arm_control::internal::ArmSdkClient> client;
+    std::unique_ptr<wxz::workstation::arm_control::internal::ArmSdkClient> priority_client;
+    std::unique_ptr<wxz::workstation::arm_control::internal::CmdQueue> queue;
+    std::vector<std::unique_ptr<wxz::workstation::arm_control::internal::ArmConnectionManager>> conn_managers;
+    std::unique_ptr<wxz::workstation::arm_control::internal::ArmStatePoller> state_poller;
+    std::unique_ptr<wxz::workstation::EventDtoPublisher> status_pub;
+    std::unique_ptr<wxz::workstation::RpcService> rpc_server;
+    std::unique_ptr<wxz::workstation::arm_control::internal::ArmDispatchProbe> probe;
+};
+
 } // namespace
 
 int run() {
@@ -194,7 +224,6 @@ int run() {
 
     const ArmControlConfig cfg = load_arm_control_config_from_env();
 
-    const auto& conn = cfg.conn;
     const int domain = cfg.domain;
     const std::size_t queue_max = cfg.queue_max;
     const std::string& sw_version = cfg.sw_version;
@@ -202,8 +231,27 @@ int run() {
     logger.set_level(cfg.log_level);
     logger.set_prefix("[workstation_arm_control_service] ");
 
+    if (!cfg.arms_error.empty()) {
+        logger.log(LogLevel::Error, "invalid WXZ_ARMS: " + cfg.arms_error);
+        return 2;
+    }
+
+    // 多臂时每臂一份 ArmUnit，topic / metrics scope 追加 /<arm_id>；单臂时保持原有名称。
+    const bool multi_arm = !cfg.arms.empty();
+    std::vector<ArmUnit> units;
+    if (multi_arm) {
+        for (const auto& a : cfg.arms) units.push_back(ArmUnit{.id = a.id, .conn = a.conn});
+    } else {
+        units.push_back(ArmUnit{.conn = cfg.conn});
+    }
+    for (auto& u : units) u.scope = arm_lane_name(cfg.metrics_scope, u.id);
+
     std::atomic<int> requested_exit_code{0};
 
+    // RT 模式的进程级准备（mlockall / 堆预留）须在创建任何 worker 线程之前完成。
+    ArmRtStatus rt_process;
+    if (cfg.rt.enable) arm_rt_setup_process(cfg.rt, rt_process);
+
     // 类 ROS2：单一、外部驱动的执行器。
     // - threads=0：本服务不额外创建 worker 线程。
     // - 本 run() 循环通过 exec.spin_once() 驱动回调执行。
@@ -211,8 +259,56 @@ int run() {
     exec_opts.threads = 0;
     wxz::core::Executor exec(exec_opts);
     (void)exec.start();
-    wxz::core::Strand ingress_strand(exec);
-    wxz::core::Strand arm_sdk_strand(exec);
+
+    // 执行线程布局：默认 ingress/SDK/RPC 都由本线程的主循环驱动；按配置把 ingress strand 与各臂 SDK strand
+    // 移到独占线程（可绑核）。多臂时 SDK strand 默认独占线程：一臂的阻塞运动不占用主循环，也不延后其它臂。
+    if (std::string err; !wxz::workstation::place_current_thread(cfg.main_cpu, "arm-main", &err)) {
+        logger.log(LogLevel::Warn, "main thread placement failed: " + err);
+    }
+    wxz::workstation::ExecLane ingress_lane(exec, cfg.ingress_thread, logger);
+    // RT 模式只提升 SDK 线程的优先级：默认让 SDK strand 独占线程，不把主循环切到 SCHED_FIFO。
+    const bool sdk_dedicated = cfg.sdk_thread < 0 ? (multi_arm || cfg.rt.enable) : cfg.sdk_thread != 0;
+    for (std::size_t i = 0; i < units.size(); ++i) {
+        auto& u = units[i];
+        u.sdk_lane = std::make_unique<wxz::workstation::ExecLane>(
+            exec,
+            wxz::workstation::ExecThreadSpec{
+                .dedicated = sdk_dedicated,
+                .cpu = i < cfg.sdk_cpus.size() ? cfg.sdk_cpus[i] : -1,
+                .name = u.id.empty() ? std::string("arm-sdk") : "sdk-" + u.id,
+            },
+            logger);
+    }
+
+    // RT 模式的线程级准备在各 SDK 线程上执行，完成后自检；WXZ_ARM_RT_REQUIRED=1 时任一臂未生效即拒绝启动。
+    if (cfg.rt.enable) {
+        bool rt_ok = true;
+        for (auto& u : units) {
+            ArmRtStatus st = rt_process;
+            if (!u.sdk_lane->dedicated()) {
+                st.problems.push_back("SDK strand shares the main loop thread (WXZ_ARM_SDK_THREAD=0); SCHED_FIFO not applied");
+            } else {
+                std::promise<void> done;
+                auto done_f = done.get_future();
+                const bool posted = u.sdk_lane->strand().post([&] {
+                    arm_rt_setup_thread(cfg.rt, st);
+                    done.set_value();
+                });
+                if (!posted || done_f.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
+                    // 任务可能仍在排队：等它结束后 st 才可读，不能就此离开作用域。
+                    if (posted) done_f.wait();
+                    st.problems.push_back("SDK thread did not run the RT setup task");
+                }
+            }
+            if (!u.id.empty()) st.problems.insert(st.problems.begin(), "arm=" + u.id);
+            arm_rt_report(cfg.rt, st, u.scope, logger);
+            rt_ok = rt_ok && st.ok();
+        }
+        if (!rt_ok && cfg.rt.required) {
+            logger.log(LogLevel::Error, "rt mode required but not fully in effect (WXZ_ARM_RT_REQUIRED=1)");
+            return 3;
+        }
+    }
 
     wxz::core::NodeBaseConfig node_cfg;
     node_cfg.service = "workstation_arm_control_service";
@@ -230,14 +326,21 @@ int run() {
     node_cfg.heartbeat_period_ms = cfg.heartbeat_period_ms;
     node_cfg.timesync_period_ms = cfg.timesync_period_ms;
     node_cfg.timesync_scope = cfg.timesync_scope;
-    node_cfg.topics_pub = {cfg.status_dto_topic, cfg.fault_status_topic};
-    node_cfg.topics_sub = {cfg.cmd_dto_topic, cfg.fault_action_topic};
+    node_cfg.topics_pub = {cfg.fault_status_topic};
+    node_cfg.topics_sub = {cfg.fault_action_topic};
+    for (const auto& u : units) {
+        node_cfg.topics_pub.push_back(arm_lane_name(cfg.status_dto_topic, u.id));
+        if (cfg.state_pub_ms > 0 && !cfg.state_topic.empty()) {
+            node_cfg.topics_pub.push_back(arm_lane_name(cfg.state_topic, u.id));
+        }
+        node_cfg.topics_sub.push_back(arm_lane_name(cfg.cmd_dto_topic, u.id));
+    }
     node_cfg.warn = [&](const std::string& m) { logger.log(LogLevel::Warn, m); };
 
     wxz::workstation::Node ws_node(wxz::workstation::Node::Options{
         std::move(node_cfg),
         &exec,
-        &ingress_strand,
+        &ingress_lane.strand(),
         &logger,
         "workstation_arm_control_service",
     });
@@ -252,57 +355,186 @@ int run() {
                                                      "workstation_arm_control_service",
                                                      requested_exit_code);
 
-    logger.log(LogLevel::Info,
-               "start ip=" + conn.ip + " port=" + std::to_string(conn.port) +
-                   " domain=" + std::to_string(domain) +
-                   " cmd='" + cfg.cmd_dto_topic + "' status='" + cfg.status_dto_topic + "'");
+    for (const auto& u : units) {
+        logger.log(LogLevel::Info,
+                   std::string("start ") + (u.id.empty() ? "" : "arm=" + u.id + " ") + "ip=" + u.conn.ip +
+                       " port=" + std::to_string(u.conn.port) + " domain=" + std::to_string(domain) +
+                       " cmd='" + arm_lane_name(cfg.cmd_dto_topic, u.id) +
+                       "' status='" + arm_lane_name(cfg.status_dto_topic, u.id) + "'" +
+                       " sdk_thread=" + u.sdk_lane->describe());
+    }
+    logger.log(LogLevel::Info, "ingress_thread=" + ingress_lane.describe());
 
-    CmdQueue queue(queue_max);
+    // 运行期可调参数在启动时加载一次，每臂一份仓库；之后热路径只读快照，由该臂的 arm.set_tunables 整体替换。
+    const ArmRuntimeTunables initial_tunables = load_arm_runtime_tunables_from_env();
+    {
+        const ArmRuntimeTunables& t = initial_tunables;
+        logger.log(LogLevel::Info,
+                   "tunables dry_run=" + std::to_string(t.dry_run ? 1 : 0) +
+                       " start_di=" + std::to_string(t.start_di_index) +
+                       " stop_di=" + std::to_string(t.stop_di_index) +
+                       " path_index=" + std::to_string(t.path_index) +
+                       " move_start_grace_ms=" + std::to_string(t.move_start_grace_ms) +
+                       " move_complete_timeout_ms=" + std::to_string(t.move_complete_timeout_ms));
+    }
 
     // SDK 为直接链接依赖：若运行环境缺少 SDK runtime libs，则进程会在启动阶段被 loader 阻止（不会走到这里）。
     logger.log(LogLevel::Info, "SDK enabled (direct-linked)");
-    std::unique_ptr<IArmClient> arm = std::make_unique<ArmSdkClient>(conn);
 
-    // 业务处理器：KV 命令负载 -> KV 状态负载。
-    ArmCommandProcessor processor;
+    // path_download 的解析缓存：各臂共用（同一路径文件只解析一次）；预加载在后台进行，不阻塞启动。
+    std::unique_ptr<ArmPathCache> path_cache;
+    if (cfg.path_cache_max > 0) {
+        path_cache = std::make_unique<ArmPathCache>(ArmPathCache::Options{
+                                                        .max_entries = cfg.path_cache_max,
+                                                        .metrics_scope = cfg.metrics_scope,
+                                                    },
+                                                    logger);
+        if (!cfg.path_preload_dir.empty()) {
+            path_cache->preload_dir(cfg.path_preload_dir,
+                                    kDefaultPathMaxPoints,
+                                    static_cast<unsigned>(std::max(cfg.path_preload_threads, 1)));
+        }
+    }
 
-    const ArmControlTopics topics{
-        .domain = domain,
-        .cmd_dto_topic = cfg.cmd_dto_topic,
-        .cmd_dto_schema = cfg.cmd_dto_schema,
-        .status_dto_topic = cfg.status_dto_topic,
-        .status_dto_schema = cfg.status_dto_schema,
-        .fault_action_topic = cfg.fault_action_topic,
-        .dto_max_payload = cfg.dto_max_payload,
-        .dto_source = cfg.dto_source,
-    };
+    for (auto& u : units) {
+        u.queue = std::make_unique<CmdQueue>(queue_max);
+        u.tunables = std::make_unique<ArmRuntimeTunablesStore>(initial_tunables);
+        u.client = std::make_unique<ArmSdkClient>(u.conn);
+        u.client->set_metrics_scope(u.scope);
+        u.client->set_tunables_store(u.tunables.get());
+        if (path_cache) u.client->set_path_cache(path_cache.get());
+
+        // 优先通道使用独立的 SDK 会话，与主客户端互不加锁。
+        if (cfg.priority_lane) {
+            u.priority_client = std::make_unique<ArmSdkClient>(u.conn);
+            u.priority_client->set_metrics_scope(u.scope);
+            u.priority_client->set_tunables_store(u.tunables.get());
+        }
+
+        // 会话在启动时预连接、断线后后台重连；关闭时回到“首条指令时同步连接”的旧行为。
+        if (cfg.conn_manager) {
+            auto manage = [&](ArmSdkClient& client, const char* name) {
+                auto m = std::make_unique<ArmConnectionManager>(
+                    client,
+                    ArmConnectionManager::Options{
+                        .backoff_min = std::chrono::milliseconds(cfg.reconnect_min_ms),
+                        .backoff_max = std::chrono::milliseconds(cfg.reconnect_max_ms),
+                        .name = name,
+                        .metrics_scope = u.scope,
+                    },
+                    logger);
+                m->start();
+                u.conn_managers.push_back(std::move(m));
+            };
+            manage(*u.client, "primary");
+            if (u.priority_client) manage(*u.priority_client, "priority");
+        }
+
+        // 查询类 op 的状态快照：后台线程按 WXZ_ARM_STATE_POLL_MS 采样，SDK 忙时跳过。
+        if (cfg.state_poll_ms > 0) {
+            u.state_poller = std::make_unique<ArmStatePoller>(*u.client,
+                                                              ArmStatePoller::Options{
+                                                                  .period = std::chrono::milliseconds(cfg.state_poll_ms),
+                                                                  .metrics_scope = u.scope,
+                                                              },
+                                                              logger);
+            u.state_poller->start();
+        }
+    }
 
-    auto status_pub = ws_node.create_publisher_eventdto(cfg.status_dto_topic, cfg.dto_max_payload);
+    // 业务处理器：KV 命令负载 -> KV 状态负载（无状态，各臂共用）。
+    ArmCommandProcessor processor;
 
-    auto rpc_server = wxz::workstation::arm_control::internal::start_arm_rpc_control_plane(
-        cfg,
-        ws_node,
-        processor,
-        *arm,
-        arm_sdk_strand,
-        logger);
+    std::vector<ArmLane> lanes;
+    for (auto& u : units) {
+        u.status_pub = ws_node.create_publisher_eventdto(arm_lane_name(cfg.status_dto_topic, u.id), cfg.dto_max_payload);
+
+        // RPC 控制面同样按臂拆分：请求/回复 topic 与服务名追加 /<arm_id>，handler 在该臂的 strand 上执行。
+        ArmControlConfig rpc_cfg = cfg;
+        rpc_cfg.rpc_req_topic = arm_lane_name(cfg.rpc_req_topic, u.id);
+        rpc_cfg.rpc_rep_topic = arm_lane_name(cfg.rpc_rep_topic, u.id);
+        rpc_cfg.rpc_service_name = arm_lane_name(cfg.rpc_service_name, u.id);
+        rpc_cfg.metrics_scope = u.scope;
+        u.rpc_server = wxz::workstation::arm_control::internal::start_arm_rpc_control_plane(
+            rpc_cfg,
+            ws_node,
+            processor,
+            *u.client,
+            u.sdk_lane->strand(),
+            logger);
+
+        lanes.push_back(ArmLane{
+            .arm_id = u.id,
+            .arm = u.client.get(),
+            .queue = u.queue.get(),
+            .sdk_strand = &u.sdk_lane->strand(),
+            .status_pub = u.status_pub.get(),
+            .topics =
+                ArmControlTopics{
+                    .domain = domain,
+                    .cmd_dto_topic = arm_lane_name(cfg.cmd_dto_topic, u.id),
+                    .cmd_dto_schema = cfg.cmd_dto_schema,
+                    .status_dto_topic = arm_lane_name(cfg.status_dto_topic, u.id),
+                    .status_dto_schema = cfg.status_dto_schema,
+                    .fault_action_topic = cfg.fault_action_topic,
+                    .dto_max_payload = cfg.dto_max_payload,
+                    .dto_source = cfg.dto_source,
+                    .wire_v2 = cfg.wire_v2,
+                    .state_topic = cfg.state_poll_ms > 0 ? arm_lane_name(cfg.state_topic, u.id) : std::string{},
+                    .state_pub_ms = cfg.state_pub_ms,
+                },
+            .priority_arm = u.priority_client.get(),
+            .metrics_scope = u.scope,
+        });
+    }
+
+    if (cfg.async_motion) logger.log(LogLevel::Info, "async motion enabled: moveL/moveJ replies follow motion completion");
+    if (cfg.replay_cache_max > 0) {
+        logger.log(LogLevel::Info, "duplicate cmd ids are replayed: max=" + std::to_string(cfg.replay_cache_max) +
+                                       " ttl_ms=" + std::to_string(cfg.replay_ttl_ms));
+    }
 
     ArmControlLoop loop(ws_node,
                         exec,
-                        arm_sdk_strand,
                         processor,
-                        *arm,
-                        queue,
-                        *status_pub,
-                        topics,
+                        std::move(lanes),
                         ArmControlLoop::Options{
                             .metrics_scope = cfg.metrics_scope,
                             .queue_max = queue_max,
+                            .strand_in_flight_max = cfg.strand_in_flight_max,
+                            .async_motion = cfg.async_motion,
+                            .replay_cache_max = cfg.replay_cache_max,
+                            .replay_ttl = std::chrono::milliseconds(std::max(1, cfg.replay_ttl_ms)),
                         },
                         logger);
-    loop.run();
 
-    if (rpc_server) rpc_server->stop();
+    // 可选的派发抖动探针：对比 RT 开/关时 SDK strand 的 p50/p99/p99.9 派发延迟。
+    if (cfg.rt_probe_ms > 0) {
+        for (auto& u : units) {
+            u.probe = std::make_unique<ArmDispatchProbe>(u.sdk_lane->strand(),
+                                                         ArmDispatchProbe::Options{
+                                                             .period = std::chrono::milliseconds(cfg.rt_probe_ms),
+                                                             .report_period = std::chrono::milliseconds(
+                                                                 std::max(cfg.rt_probe_report_ms, cfg.rt_probe_ms)),
+                                                             .label = u.id,
+                                                             .metrics_scope = u.scope,
+                                                             .rt = cfg.rt.enable,
+                                                         },
+                                                         logger);
+            u.probe->start();
+        }
+    }
+
+    loop.run(std::chrono::milliseconds(std::max(1, cfg.loop_idle_ms)));
+
+    for (auto& u : units) {
+        if (u.probe) u.probe->stop();
+        if (u.rpc_server) u.rpc_server->stop();
+        if (u.state_poller) u.state_poller->stop();
+        for (auto& m : u.conn_managers) m->stop();
+    }
+    for (auto& u : units) u.sdk_lane->stop();
+    ingress_lane.stop();
     exec.stop();
 
     if (fault_recovery) fault_recovery->stop();
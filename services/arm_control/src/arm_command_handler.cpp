@@ -1,31 +1,40 @@
 #include "internal/arm_command_handler.h"
 #include <array>
-#include <iomanip>
-#include <sstream>
+#include <string_view>
 #include <unordered_map>
 
 #include "internal/arm_error_codes.h"
-#include "command_router.h"
-#include "kv_codec.h"
+#include "internal/arm_runtime_tunables.h"
+#include "workstation/arm_ops.h"
 
 namespace wxz::workstation::arm_control::internal {
 
-ArmCommand parse_arm_command(const std::string& raw) {
+namespace ops = wxz::workstation::arm_control::ops;
+
+ArmCommand parse_arm_command(std::string_view raw) {
     ArmCommand cmd;
     cmd.raw = raw;
-    cmd.kv = wxz::core::KvCodec::parse(raw);
-    cmd.op = wxz::core::KvCodec::get(cmd.kv, "op", "");
-    cmd.id = wxz::core::KvCodec::get(cmd.kv, "id", "");
+    cmd.kv.parse(raw);
+    cmd.op = cmd.kv.get("op");
+    cmd.id = cmd.kv.get("id");
+    return cmd;
+}
+
+ArmCommand make_arm_command(const wire::CommandV2& v2) {
+    ArmCommand cmd;
+    cmd.op = ops::op_desc(v2.op).name;
+    cmd.id = v2.id.view();
+    cmd.v2 = &v2;
     return cmd;
 }
 
 static EventDTOUtil::KvMap make_base_resp(const ArmCommand& cmd) {
     EventDTOUtil::KvMap resp;
-    if (!cmd.id.empty()) resp["id"] = cmd.id;
-    resp["op"] = cmd.op;
+    if (!cmd.id.empty()) resp["id"] = std::string(cmd.id);
+    resp["op"] = std::string(cmd.op);
     return resp;
 }
-// 注册表单例
+// 模块侧扩展/覆盖的 handler（按 op 名）；内置 op 在编译期绑定，不经过此表。
 static std::unordered_map<std::string, ArmCommandHandler>& registry() {
     static auto* m = new std::unordered_map<std::string, ArmCommandHandler>();
     return *m;
@@ -35,63 +44,143 @@ void register_arm_handler(const std::string& op, ArmCommandHandler fn) {
     registry()[op] = fn;
 }
 
-// 内置处理器
-static EventDTOUtil::KvMap h_moveL(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
-    EventDTOUtil::KvMap resp = make_base_resp(cmd);
-    const auto& kv = cmd.kv;
-    const std::string pose_s = kv.count("pose") ? kv.at("pose") : "";
-    const std::string joint_s = kv.count("jointpos") ? kv.at("jointpos") : "";
+// 参数访问：v2 指令直接读取类型化字段，v1 指令从 KV 文本解析。
+
+static bool has_arg(const ArmCommand& cmd, std::string_view key) {
+    if (cmd.v2) return (cmd.v2->fields & wire::cmd_field_for(key)) != 0;
+    return cmd.kv.contains(key);
+}
+
+/// 可选 double 参数：未给出时 present=false；v1 文本解析失败时 value 为空（text 保留原文用于日志）。
+struct DoubleArg {
+    bool present{false};
+    std::optional<double> value;
+    std::string_view text;
+};
+
+static DoubleArg double_arg(const ArmCommand& cmd, std::string_view key) {
+    DoubleArg a;
+    if (const auto* v2 = cmd.v2) {
+        const auto field = static_cast<wire::CmdField>(wire::cmd_field_for(key));
+        if (!v2->has(field)) return a;
+        a.present = true;
+        switch (field) {
+            case wire::kFieldSpeed: a.value = v2->speed; break;
+            case wire::kFieldAcc: a.value = v2->acc; break;
+            case wire::kFieldJerk: a.value = v2->jerk; break;
+            default: break;
+        }
+        return a;
+    }
+    if (const auto s = cmd.kv.find(key)) {
+        a.present = true;
+        a.text = *s;
+        a.value = parse_double(*s);
+    }
+    return a;
+}
+
+static std::optional<std::array<double, 6>> csv6_arg(const ArmCommand& cmd, std::string_view key) {
+    if (const auto* v2 = cmd.v2) {
+        if (key == "pose" && v2->has(wire::kFieldPose)) return v2->pose;
+        if (key == "jointpos" && v2->has(wire::kFieldJointpos)) return v2->jointpos;
+        return std::nullopt;
+    }
+    return parse_csv6(cmd.kv.get(key));
+}
+
+/// 可选 bool 参数（v1 仅 "1"/"true" 为真）；未给出返回 std::nullopt。
+static std::optional<bool> bool_arg(const ArmCommand& cmd, std::string_view key) {
+    if (const auto* v2 = cmd.v2) {
+        if (key == "enable" && v2->has(wire::kFieldEnable)) return v2->enable;
+        return std::nullopt;
+    }
+    const auto s = cmd.kv.find(key);
+    if (!s) return std::nullopt;
+    return *s == "1" || *s == "true";
+}
 
-    const auto speed_opt = kv.count("speed") ? parse_double(kv.at("speed")) : std::optional<double>{};
-    const auto acc_opt = kv.count("acc") ? parse_double(kv.at("acc")) : std::optional<double>{};
-    const auto jerk_opt = kv.count("jerk") ? parse_double(kv.at("jerk")) : std::optional<double>{};
+/// 可选 int 参数；未给出或 v1 解析失败返回 std::nullopt。
+static std::optional<int> int_arg(const ArmCommand& cmd, std::string_view key) {
+    if (const auto* v2 = cmd.v2) {
+        if (key == "timeout_ms" && v2->has(wire::kFieldTimeoutMs)) return v2->timeout_ms;
+        return std::nullopt;
+    }
+    const auto s = cmd.kv.find(key);
+    if (!s) return std::nullopt;
+    return parse_int(*s);
+}
 
-    if (kv.count("speed") && !speed_opt) {
-        logger.log(LogLevel::Warn, "moveL bad speed='" + kv.at("speed") + "'");
+/// 直线运动的速度参数（moveL 与 moveL_stepwise 共用默认值与安全护栏）。
+struct LineMotionParams {
+    double speed{30.0};
+    double acc{30.0};
+    double jerk{60.0};
+};
+
+static std::optional<LineMotionParams> line_motion_params(const ArmCommand& cmd,
+                                                          EventDTOUtil::KvMap& resp,
+                                                          const Logger& logger) {
+    const std::string op(cmd.op);
+    const DoubleArg speed_a = double_arg(cmd, "speed");
+    const DoubleArg acc_a = double_arg(cmd, "acc");
+    const DoubleArg jerk_a = double_arg(cmd, "jerk");
+
+    if (speed_a.present && !speed_a.value) {
+        logger.log(LogLevel::Warn, op + " bad speed='" + std::string(speed_a.text) + "'");
         arm_set_error(resp, ArmErrc::ParseError, "bad_speed");
-        return resp;
+        return std::nullopt;
     }
-    if (kv.count("acc") && !acc_opt) {
-        logger.log(LogLevel::Warn, "moveL bad acc='" + kv.at("acc") + "'");
+    if (acc_a.present && !acc_a.value) {
+        logger.log(LogLevel::Warn, op + " bad acc='" + std::string(acc_a.text) + "'");
         arm_set_error(resp, ArmErrc::ParseError, "bad_acc");
-        return resp;
+        return std::nullopt;
     }
-    if (kv.count("jerk") && !jerk_opt) {
-        logger.log(LogLevel::Warn, "moveL bad jerk='" + kv.at("jerk") + "'");
+    if (jerk_a.present && !jerk_a.value) {
+        logger.log(LogLevel::Warn, op + " bad jerk='" + std::string(jerk_a.text) + "'");
         arm_set_error(resp, ArmErrc::ParseError, "bad_jerk");
-        return resp;
+        return std::nullopt;
     }
 
-    const double speed = speed_opt.value_or(30.0);
-    const double acc = acc_opt.value_or(30.0);
-    const double jerk = jerk_opt.value_or(60.0);
+    LineMotionParams p;
+    p.speed = speed_a.value.value_or(p.speed);
+    p.acc = acc_a.value.value_or(p.acc);
+    p.jerk = jerk_a.value.value_or(p.jerk);
 
     // 安全护栏（单位：speed mm/s，acc mm/s^2，jerk mm/s^3）。
     // 对齐 SDK demo 的约束：speed <= 3000。
-    if (speed <= 0.0 || speed > 3000.0) {
-        logger.log(LogLevel::Error, "moveL rejected: speed out of range: " + std::to_string(speed));
+    if (p.speed <= 0.0 || p.speed > 3000.0) {
+        logger.log(LogLevel::Error, op + " rejected: speed out of range: " + std::to_string(p.speed));
         arm_set_error(resp, ArmErrc::InvalidArgs, "invalid_speed");
-        return resp;
+        return std::nullopt;
     }
-    if (acc < 0.0 || acc > 20000.0) {
-        logger.log(LogLevel::Error, "moveL rejected: acc out of range: " + std::to_string(acc));
+    if (p.acc < 0.0 || p.acc > 20000.0) {
+        logger.log(LogLevel::Error, op + " rejected: acc out of range: " + std::to_string(p.acc));
         arm_set_error(resp, ArmErrc::InvalidArgs, "invalid_acc");
-        return resp;
+        return std::nullopt;
     }
-    if (jerk < 0.0 || jerk > 20000.0) {
-        logger.log(LogLevel::Error, "moveL rejected: jerk out of range: " + std::to_string(jerk));
+    if (p.jerk < 0.0 || p.jerk > 20000.0) {
+        logger.log(LogLevel::Error, op + " rejected: jerk out of range: " + std::to_string(p.jerk));
         arm_set_error(resp, ArmErrc::InvalidArgs, "invalid_jerk");
-        return resp;
+        return std::nullopt;
     }
+    return p;
+}
+
+// 内置处理器
+static EventDTOUtil::KvMap h_moveL(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
+    EventDTOUtil::KvMap resp = make_base_resp(cmd);
+    const auto params = line_motion_params(cmd, resp, logger);
+    if (!params) return resp;
 
-    auto pose = parse_csv6(pose_s);
-    auto joint = parse_csv6(joint_s);
+    auto pose = csv6_arg(cmd, "pose");
+    auto joint = csv6_arg(cmd, "jointpos");
     if (!pose || !joint) {
         logger.log(LogLevel::Warn, "moveL bad pose or jointpos");
         arm_set_error(resp, ArmErrc::ParseError, "bad_pose_or_jointpos");
         return resp;
     }
-    const CRresult r = arm.moveL(*joint, *pose, speed, acc, jerk);
+    const CRresult r = arm.moveL(*joint, *pose, params->speed, params->acc, params->jerk);
     arm_set_sdk_result(resp, static_cast<int>(r));
     if (r != success) logger.log(LogLevel::Error, "moveL failed code=" + std::to_string(static_cast<int>(r)));
     return resp;
@@ -99,21 +188,19 @@ static EventDTOUtil::KvMap h_moveL(const ArmCommand& cmd, IArmClient& arm, const
 
 static EventDTOUtil::KvMap h_moveJoint(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
     EventDTOUtil::KvMap resp = make_base_resp(cmd);
-    const auto& kv = cmd.kv;
-    const std::string joint_s = kv.count("jointpos") ? kv.at("jointpos") : "";
-    const auto speed_opt = kv.count("speed") ? parse_double(kv.at("speed")) : std::optional<double>{};
-    if (kv.count("speed") && !speed_opt) {
-        logger.log(LogLevel::Warn, "moveJoint bad speed='" + kv.at("speed") + "'");
+    const DoubleArg speed_a = double_arg(cmd, "speed");
+    if (speed_a.present && !speed_a.value) {
+        logger.log(LogLevel::Warn, "moveJoint bad speed='" + std::string(speed_a.text) + "'");
         arm_set_error(resp, ArmErrc::ParseError, "bad_speed");
         return resp;
     }
-    const double speed = speed_opt.value_or(3.14);
+    const double speed = speed_a.value.value_or(3.14);
     if (speed <= 0.0 || speed > 6.0) {
         logger.log(LogLevel::Error, "moveJoint rejected: speed(rad/s) out of range: " + std::to_string(speed));
         arm_set_error(resp, ArmErrc::InvalidArgs, "invalid_speed");
         return resp;
     }
-    auto joint = parse_csv6(joint_s);
+    auto joint = csv6_arg(cmd, "jointpos");
     if (!joint) {
         logger.log(LogLevel::Warn, "moveJoint bad jointpos");
         arm_set_error(resp, ArmErrc::ParseError, "bad_jointpos");
@@ -143,8 +230,7 @@ static EventDTOUtil::KvMap h_fault_reset(const ArmCommand& cmd, IArmClient& arm,
 
 static EventDTOUtil::KvMap h_slowSpeed(const ArmCommand& cmd, IArmClient& arm, const Logger& /*logger*/) {
     EventDTOUtil::KvMap resp = make_base_resp(cmd);
-    const auto& kv = cmd.kv;
-    const bool enable = kv.count("enable") ? (kv.at("enable") == "1" || kv.at("enable") == "true") : true;
+    const bool enable = bool_arg(cmd, "enable").value_or(true);
     const CRresult r = arm.slow_speed(enable);
     arm_set_sdk_result(resp, static_cast<int>(r));
     return resp;
@@ -152,8 +238,7 @@ static EventDTOUtil::KvMap h_slowSpeed(const ArmCommand& cmd, IArmClient& arm, c
 
 static EventDTOUtil::KvMap h_quickStop(const ArmCommand& cmd, IArmClient& arm, const Logger& /*logger*/) {
     EventDTOUtil::KvMap resp = make_base_resp(cmd);
-    const auto& kv = cmd.kv;
-    const bool enable = kv.count("enable") ? (kv.at("enable") == "1" || kv.at("enable") == "true") : true;
+    const bool enable = bool_arg(cmd, "enable").value_or(true);
     const CRresult r = arm.quick_stop(enable);
     arm_set_sdk_result(resp, static_cast<int>(r));
     return resp;
@@ -162,10 +247,10 @@ static EventDTOUtil::KvMap h_quickStop(const ArmCommand& cmd, IArmClient& arm, c
 static EventDTOUtil::KvMap h_path_download(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
     EventDTOUtil::KvMap resp = make_base_resp(cmd);
     const auto& kv = cmd.kv;
-    const std::string file = kv.count("file") ? kv.at("file") : "";
-    const int index = kv.count("index") ? parse_int(kv.at("index")).value_or(1) : 1;
-    const int move_type = kv.count("moveType") ? parse_int(kv.at("moveType")).value_or(1) : 1;
-    const std::size_t max_points = kv.count("maxPoints") ? parse_size(kv.at("maxPoints")).value_or(10000) : 10000;
+    const std::string file(kv.get("file"));
+    const int index = parse_int(kv.get("index", "1")).value_or(1);
+    const int move_type = parse_int(kv.get("moveType", "1")).value_or(1);
+    const std::size_t max_points = parse_size(kv.get("maxPoints", "10000")).value_or(10000);
     if (file.empty()) {
         logger.log(LogLevel::Warn, "path_download missing file");
         arm_set_error(resp, ArmErrc::MissingField, "missing_file");
@@ -181,12 +266,33 @@ static ArmSdkClient* as_sdk_client(IArmClient& arm) {
     return dynamic_cast<ArmSdkClient*>(&arm);
 }
 
-static std::string format_csv6_fixed(const std::array<double, 6>& v, int precision = 6) {
-    std::ostringstream os;
-    os.setf(std::ios::fixed);
-    os << std::setprecision(precision);
-    os << v[0] << "," << v[1] << "," << v[2] << "," << v[3] << "," << v[4] << "," << v[5];
-    return os.str();
+// 查询类 op 先读后台采样快照（ArmStatePoller）；快照过旧或不可用时才做实时 SDK 查询。
+
+static std::optional<bool> cached_di(const ArmSdkClient& sdk, bool start) {
+    const auto st = sdk.cached_state();
+    if (!st) return std::nullopt;
+    const ArmRuntimeTunables& tun = sdk.tunables();
+    if (start) {
+        if (st->start_di_index != tun.start_di_index) return std::nullopt;
+        return st->start_di;
+    }
+    if (st->stop_di_index != tun.stop_di_index) return std::nullopt;
+    return st->stop_di;
+}
+
+static EventDTOUtil::KvMap h_robot_mode(const ArmCommand& cmd, IArmClient& arm, const Logger& /*logger*/) {
+    EventDTOUtil::KvMap resp = make_base_resp(cmd);
+    int mode = 0;
+    CRresult r = success;
+    const auto* sdk = as_sdk_client(arm);
+    if (const auto st = sdk ? sdk->cached_state() : std::nullopt) {
+        mode = st->mode;
+    } else {
+        r = arm.get_robot_mode(mode);
+    }
+    arm_set_sdk_result(resp, static_cast<int>(r));
+    if (r == success) resp["mode"] = std::to_string(mode);
+    return resp;
 }
 
 static EventDTOUtil::KvMap h_is_arm_ready(const ArmCommand& cmd, IArmClient& arm, const Logger& /*logger*/) {
@@ -196,7 +302,8 @@ static EventDTOUtil::KvMap h_is_arm_ready(const ArmCommand& cmd, IArmClient& arm
         arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
         return resp;
     }
-    resp["value"] = sdk->IsArmReady() ? "1" : "0";
+    const auto st = sdk->cached_state();
+    resp["value"] = (st ? robot_mode_is_ready(st->mode) : sdk->IsArmReady()) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
@@ -208,7 +315,8 @@ static EventDTOUtil::KvMap h_is_power_on(const ArmCommand& cmd, IArmClient& arm,
         arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
         return resp;
     }
-    resp["value"] = sdk->IsPowerOn() ? "1" : "0";
+    const auto st = sdk->cached_state();
+    resp["value"] = (st ? robot_mode_is_powered(st->mode) : sdk->IsPowerOn()) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
@@ -220,7 +328,8 @@ static EventDTOUtil::KvMap h_is_start_signal(const ArmCommand& cmd, IArmClient&
         arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
         return resp;
     }
-    resp["value"] = sdk->IsStartSignal() ? "1" : "0";
+    const auto di = cached_di(*sdk, true);
+    resp["value"] = (di ? *di : sdk->IsStartSignal()) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
@@ -232,7 +341,8 @@ static EventDTOUtil::KvMap h_is_stop_signal(const ArmCommand& cmd, IArmClient& a
         arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
         return resp;
     }
-    resp["value"] = sdk->IsStopSignal() ? "1" : "0";
+    const auto di = cached_di(*sdk, false);
+    resp["value"] = (di ? *di : sdk->IsStopSignal()) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
@@ -244,7 +354,8 @@ static EventDTOUtil::KvMap h_is_trajectory_complete(const ArmCommand& cmd, IArmC
         arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
         return resp;
     }
-    resp["value"] = sdk->IsTrajectoryComplete() ? "1" : "0";
+    const auto st = sdk->cached_state();
+    resp["value"] = (st ? (st->path_run_status != 1) : sdk->IsTrajectoryComplete()) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
@@ -256,16 +367,12 @@ static EventDTOUtil::KvMap h_is_all_trajectories_complete(const ArmCommand& cmd,
         arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
         return resp;
     }
-    resp["value"] = sdk->IsAllTrajectoriesComplete() ? "1" : "0";
+    const auto st = sdk->cached_state();
+    resp["value"] = (st ? (st->path_run_status != 1) : sdk->IsAllTrajectoriesComplete()) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
 
-static EventDTOUtil::KvMap h_initialize_arm(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
-    // 复用既有行为的别名。
-    return h_power_on(cmd, arm, logger);
-}
-
 static EventDTOUtil::KvMap h_wait_for_start(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
     EventDTOUtil::KvMap resp = make_base_resp(cmd);
     auto* sdk = as_sdk_client(arm);
@@ -274,8 +381,7 @@ static EventDTOUtil::KvMap h_wait_for_start(const ArmCommand& cmd, IArmClient& a
         return resp;
     }
 
-    const auto& kv = cmd.kv;
-    const int timeout_ms = kv.count("timeout_ms") ? parse_int(kv.at("timeout_ms")).value_or(30000) : 30000;
+    const int timeout_ms = int_arg(cmd, "timeout_ms").value_or(30000);
     const CRresult r = sdk->WaitForStart(std::chrono::milliseconds(timeout_ms), logger);
     resp["value"] = (r == success) ? "1" : "0";
     // 对于该高层 op：用 ok=1 表示传输/处理链路成功，
@@ -292,29 +398,97 @@ static EventDTOUtil::KvMap h_execute_trajectory(const ArmCommand& cmd, IArmClien
         return resp;
     }
 
-    const auto& kv = cmd.kv;
-    const int timeout_ms = kv.count("timeout_ms") ? parse_int(kv.at("timeout_ms")).value_or(60000) : 60000;
+    const int timeout_ms = int_arg(cmd, "timeout_ms").value_or(60000);
     const CRresult r = sdk->ExecuteTrajectory(std::chrono::milliseconds(timeout_ms), logger);
     resp["value"] = (r == success) ? "1" : "0";
     arm_set_ok(resp);
     return resp;
 }
 
-static EventDTOUtil::KvMap h_emergency_stop(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
+// 单条 moveL_stepwise 的点数上限（阻塞路径下整批占住调用线程）。
+constexpr std::size_t kMaxStepwisePoints = 64;
+
+// 逐点顺序执行 moveL（不是融合轨迹）：省去每点一次 /arm/command 往返与 BT tick，点与点之间仍会停稳。
+//
+// 经 /arm/command 执行时（AsyncMotionScope 内）只下发第 0 点并登记续发信息，其余点由运动跟踪逐点下发：
+// 点间不占住 arm_sdk_strand，急停/停止在任一点上都会打断并结束整批，结果在最后一点结束后回复（done 由跟踪方填写）。
+// 其余调用方（RPC）逐点阻塞执行，急停/quickStop 经 stop_epoch 在点与点之间生效。
+static EventDTOUtil::KvMap h_moveL_stepwise(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
     EventDTOUtil::KvMap resp = make_base_resp(cmd);
+    const auto params = line_motion_params(cmd, resp, logger);
+    if (!params) return resp;
+
+    // poses/jointposes 无 v2 字段，只走 v1 KV。
+    const auto poses = parse_csv6_list(cmd.kv.get("poses"), kMaxStepwisePoints);
+    const auto joints = parse_csv6_list(cmd.kv.get("jointposes"), kMaxStepwisePoints);
+    if (!poses || !joints) {
+        logger.log(LogLevel::Warn, "moveL_stepwise bad poses or jointposes (max " + std::to_string(kMaxStepwisePoints) +
+                                       " points)");
+        arm_set_error(resp, ArmErrc::ParseError, "bad_poses_or_jointposes");
+        return resp;
+    }
+    // jointposes 只给一组时作为所有点的参考关节（对应 BT 里先 GetJointActualPos 再逐点 moveL 的写法）。
+    if (joints->size() != 1 && poses->size() != joints->size()) {
+        logger.log(LogLevel::Warn, "moveL_stepwise poses/jointposes count mismatch");
+        arm_set_error(resp, ArmErrc::InvalidArgs, "points_count_mismatch");
+        return resp;
+    }
+
     auto* sdk = as_sdk_client(arm);
-    if (!sdk) {
-        arm_set_error(resp, ArmErrc::InternalError, "unsupported_client");
+    const std::size_t count = poses->size();
+    resp["count"] = std::to_string(count);
+
+    if (sdk && sdk->async_motion_enabled()) {
+        auto issue = [&arm, poses = std::move(*poses), joints = std::move(*joints), p = *params](std::size_t i) {
+            const auto& joint = joints[joints.size() == 1 ? 0 : i];
+            return arm.moveL(joint, poses[i], p.speed, p.acc, p.jerk);
+        };
+        const CRresult r = issue(0);
+        if (r != success) {
+            logger.log(LogLevel::Error, "moveL_stepwise failed at point 0 code=" + std::to_string(static_cast<int>(r)));
+            resp["done"] = "0";
+            arm_set_sdk_result(resp, static_cast<int>(r));
+            return resp;
+        }
+        sdk->set_motion_sequence(ArmSdkClient::MotionSequence{.total = count, .issued = 1, .issue = std::move(issue)});
+        arm_set_ok(resp);
         return resp;
     }
-    const CRresult r = sdk->EmergencyStop(logger);
-    arm_set_sdk_result(resp, static_cast<int>(r));
+
+    const std::uint64_t epoch = sdk ? sdk->stop_epoch() : 0;
+    std::size_t done = 0;
+    auto interrupted = [&] { return sdk && sdk->stop_epoch() != epoch; };
+    for (; done < count; ++done) {
+        CRresult r = success;
+        if (!interrupted()) {
+            const auto& joint = (*joints)[joints->size() == 1 ? 0 : done];
+            r = arm.moveL(joint, (*poses)[done], params->speed, params->acc, params->jerk);
+        }
+        // 运动等待中收到停止时 moveL 以 CR_FAILED 返回：按中断上报，而不是 SDK 失败。
+        if (interrupted()) {
+            logger.log(LogLevel::Warn, "moveL_stepwise interrupted at point " + std::to_string(done));
+            resp["done"] = std::to_string(done);
+            arm_set_error(resp, ArmErrc::MotionInterrupted, "motion_interrupted");
+            return resp;
+        }
+        if (r != success) {
+            logger.log(LogLevel::Error, "moveL_stepwise failed at point " + std::to_string(done) +
+                                            " code=" + std::to_string(static_cast<int>(r)));
+            resp["done"] = std::to_string(done);
+            arm_set_sdk_result(resp, static_cast<int>(r));
+            return resp;
+        }
+    }
+    resp["done"] = std::to_string(done);
+    arm_set_ok(resp);
     return resp;
 }
 
-static EventDTOUtil::KvMap h_reset_system(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
-    // fault_reset 的别名。
-    return h_fault_reset(cmd, arm, logger);
+static EventDTOUtil::KvMap h_emergency_stop(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
+    EventDTOUtil::KvMap resp = make_base_resp(cmd);
+    const CRresult r = arm.emergency_stop(logger);
+    arm_set_sdk_result(resp, static_cast<int>(r));
+    return resp;
 }
 
 static EventDTOUtil::KvMap h_get_joint_actual_pos(const ArmCommand& cmd, IArmClient& arm, const Logger& /*logger*/) {
@@ -326,177 +500,98 @@ static EventDTOUtil::KvMap h_get_joint_actual_pos(const ArmCommand& cmd, IArmCli
     }
 
     std::array<double, 6> pos_deg{};
-    const CRresult r = sdk->GetJointActualPosDeg(pos_deg);
+    CRresult r = success;
+    if (const auto st = sdk->cached_state()) {
+        pos_deg = st->joint_deg;
+    } else {
+        r = sdk->GetJointActualPosDeg(pos_deg);
+    }
     arm_set_sdk_result(resp, static_cast<int>(r));
     if (r == success) {
         constexpr double kPi = 3.14159265358979323846;
         std::array<double, 6> pos_rad{};
         for (std::size_t i = 0; i < 6; ++i) pos_rad[i] = pos_deg[i] * kPi / 180.0;
         // 约定：jointpos 使用弧度，与 MoveJ/MoveL 入参对齐。
-        resp["jointpos"] = format_csv6_fixed(pos_rad);
-        resp["jointpos_deg"] = format_csv6_fixed(pos_deg);
+        resp["jointpos"] = wire::format_csv6_fixed(pos_rad);
+        resp["jointpos_deg"] = wire::format_csv6_fixed(pos_deg);
     }
     return resp;
 }
 
-void init_default_arm_handlers() {
-    // 幂等注册（同名覆盖是允许的；同一个 fn 反复注册也没问题）。
-    register_arm_handler("moveL", &h_moveL);
-    register_arm_handler("moveLine", &h_moveL);
-    register_arm_handler("moveJoint", &h_moveJoint);
-    register_arm_handler("moveJ", &h_moveJoint);
-    register_arm_handler("power_on", &h_power_on);
-    // 别名：保持与 bt_service / 用户期望的措辞一致。
-    register_arm_handler("power_on_enable", &h_power_on);
-    register_arm_handler("initialize_arm", &h_initialize_arm);
-    register_arm_handler("fault_reset", &h_fault_reset);
-    register_arm_handler("reset_system", &h_reset_system);
-    register_arm_handler("slowSpeed", &h_slowSpeed);
-    register_arm_handler("slow_speed", &h_slowSpeed);
-    register_arm_handler("quickStop", &h_quickStop);
-    register_arm_handler("quick_stop", &h_quickStop);
-    register_arm_handler("path_download", &h_path_download);
-
-    // 高层状态/信号辅助接口。
-    register_arm_handler("is_arm_ready", &h_is_arm_ready);
-    register_arm_handler("is_power_on", &h_is_power_on);
-    register_arm_handler("is_start_signal", &h_is_start_signal);
-    register_arm_handler("is_stop_signal", &h_is_stop_signal);
-    register_arm_handler("is_trajectory_complete", &h_is_trajectory_complete);
-    register_arm_handler("is_all_trajectories_complete", &h_is_all_trajectories_complete);
-    register_arm_handler("wait_for_start", &h_wait_for_start);
-    register_arm_handler("execute_trajectory", &h_execute_trajectory);
-    register_arm_handler("emergency_stop", &h_emergency_stop);
-
-    // 查询实际关节位置。
-    // - jointpos：弧度（用于 MoveJ/MoveL）
-    // - jointpos_deg：角度（用于调试）
-    register_arm_handler("get_joint_actual_pos", &h_get_joint_actual_pos);
+// 内置 op 到 handler 的绑定；别名与必填字段由 workstation/arm_ops.h 的描述表给出。
+static ArmCommandHandler builtin_handler(ops::ArmOp op) {
+    switch (op) {
+        case ops::ArmOp::MoveL: return &h_moveL;
+        case ops::ArmOp::MoveJoint: return &h_moveJoint;
+        case ops::ArmOp::PowerOn: return &h_power_on;
+        case ops::ArmOp::FaultReset: return &h_fault_reset;
+        case ops::ArmOp::SlowSpeed: return &h_slowSpeed;
+        case ops::ArmOp::QuickStop: return &h_quickStop;
+        case ops::ArmOp::EmergencyStop: return &h_emergency_stop;
+        case ops::ArmOp::PathDownload: return &h_path_download;
+        case ops::ArmOp::IsArmReady: return &h_is_arm_ready;
+        case ops::ArmOp::IsPowerOn: return &h_is_power_on;
+        case ops::ArmOp::IsStartSignal: return &h_is_start_signal;
+        case ops::ArmOp::IsStopSignal: return &h_is_stop_signal;
+        case ops::ArmOp::IsTrajectoryComplete: return &h_is_trajectory_complete;
+        case ops::ArmOp::IsAllTrajectoriesComplete: return &h_is_all_trajectories_complete;
+        case ops::ArmOp::WaitForStart: return &h_wait_for_start;
+        case ops::ArmOp::ExecuteTrajectory: return &h_execute_trajectory;
+        case ops::ArmOp::GetJointActualPos: return &h_get_joint_actual_pos;
+        case ops::ArmOp::RobotMode: return &h_robot_mode;
+        case ops::ArmOp::MoveLStepwise: return &h_moveL_stepwise;
+        case ops::ArmOp::DemoEcho:
+            return nullptr;
+    }
+    return nullptr;
 }
 
 EventDTOUtil::KvMap handle_arm_command(const ArmCommand& cmd, IArmClient& arm, const Logger& logger) {
-    static bool initialized = false;
-    if (!initialized) {
-        init_default_arm_handlers();
-        initialized = true;
-    }
-
-    // 每次按需构建 router，保证其反映 registry() 的最新状态
-    //（包括模块侧的动态注册）。
-    wxz::core::CommandRouter router;
-    EventDTOUtil::KvMap out;
-    bool out_set = false;
-
-    auto set_out = [&](EventDTOUtil::KvMap resp) {
-        out = std::move(resp);
-        out_set = true;
-    };
-
-    router.on_missing_op = [&](const wxz::core::CommandRouter::KvMap& kv) {
-        ArmCommand c;
-        c.kv = kv;
-        c.op = wxz::core::KvCodec::get(kv, "op", "");
-        c.id = wxz::core::KvCodec::get(kv, "id", "");
-        EventDTOUtil::KvMap resp = make_base_resp(c);
+    // 直接在 KV 视图上分发：缺 op / 未知 op / 缺必填字段 的语义与原 CommandRouter 路由一致。
+    // arm_control 保持历史行为：不强制要求 id。
+    //（部分外部控制器可能会省略 id；我们仍返回尽力而为的响应。）
+    if (cmd.op.empty()) {
+        EventDTOUtil::KvMap resp = make_base_resp(cmd);
         logger.log(LogLevel::Warn, "missing op");
         arm_set_error(resp, ArmErrc::MissingField, "missing_op");
-        set_out(std::move(resp));
-    };
-
-    router.on_unknown_op = [&](std::string_view op, const wxz::core::CommandRouter::KvMap& kv) {
-        ArmCommand c;
-        c.kv = kv;
-        c.op = std::string(op);
-        c.id = wxz::core::KvCodec::get(kv, "id", "");
-        EventDTOUtil::KvMap resp = make_base_resp(c);
-        logger.log(LogLevel::Warn, "unknown op='" + std::string(op) + "'");
+        return resp;
+    }
+
+    // 内置 op：完美哈希查表；模块注册的 handler 可按名覆盖内置实现或提供新 op。
+    const ops::OpDesc* desc = ops::find_op(cmd.op);
+    ArmCommandHandler fn = nullptr;
+    if (const auto& reg = registry(); !reg.empty()) {
+        if (auto it = reg.find(std::string(cmd.op)); it != reg.end()) fn = it->second;
+    }
+    const bool builtin = !fn && desc;
+    if (builtin) fn = builtin_handler(desc->id);
+    if (!fn) {
+        EventDTOUtil::KvMap resp = make_base_resp(cmd);
+        logger.log(LogLevel::Warn, "unknown op='" + std::string(cmd.op) + "'");
         arm_set_error(resp, ArmErrc::UnknownOp, "unknown_op");
-        set_out(std::move(resp));
-    };
-
-    router.on_missing_field = [&](std::string_view op, std::string_view missing_key, const wxz::core::CommandRouter::KvMap& kv) {
-        ArmCommand c;
-        c.kv = kv;
-        c.op = op.empty() ? wxz::core::KvCodec::get(kv, "op", "") : std::string(op);
-        c.id = wxz::core::KvCodec::get(kv, "id", "");
-        EventDTOUtil::KvMap resp = make_base_resp(c);
-        logger.log(LogLevel::Warn,
-                   "missing field: op='" + c.op + "' key='" + std::string(missing_key) + "'");
-        arm_set_error(resp, ArmErrc::MissingField, "missing_" + std::string(missing_key));
-        set_out(std::move(resp));
-    };
+        return resp;
+    }
 
-    // arm_control 保持历史行为：不强制要求 id。
-    //（部分外部控制器可能会省略 id；我们仍返回尽力而为的响应。）
-    for (const auto& [op, fn] : registry()) {
-        if (!fn) continue;
-
-        // 各路由的必填字段。
-        // 注意：仅对核心内置 op 做强校验，避免破坏第三方/模块扩展 op。
-        // - moveL/moveLine：需要 pose + jointpos
-        // - moveJoint：需要 jointpos
-        // - path_download：需要 file
-        // - demo_echo：需要 msg
-        // - slowSpeed/quickStop：需要 enable
-        if (op == "moveL" || op == "moveLine") {
-            router.add_route(op, {"pose", "jointpos"}, [&](const wxz::core::CommandRouter::KvMap& kv) {
-                ArmCommand c;
-                c.kv = kv;
-                c.op = wxz::core::KvCodec::get(kv, "op", "");
-                c.id = wxz::core::KvCodec::get(kv, "id", "");
-                set_out(fn(c, arm, logger));
-            });
-        } else if (op == "moveJoint") {
-            router.add_route(op, {"jointpos"}, [&](const wxz::core::CommandRouter::KvMap& kv) {
-                ArmCommand c;
-                c.kv = kv;
-                c.op = wxz::core::KvCodec::get(kv, "op", "");
-                c.id = wxz::core::KvCodec::get(kv, "id", "");
-                set_out(fn(c, arm, logger));
-            });
-        } else if (op == "path_download") {
-            router.add_route(op, {"file"}, [&](const wxz::core::CommandRouter::KvMap& kv) {
-                ArmCommand c;
-                c.kv = kv;
-                c.op = wxz::core::KvCodec::get(kv, "op", "");
-                c.id = wxz::core::KvCodec::get(kv, "id", "");
-                set_out(fn(c, arm, logger));
-            });
-        } else if (op == "demo_echo") {
-            router.add_route(op, {"msg"}, [&](const wxz::core::CommandRouter::KvMap& kv) {
-                ArmCommand c;
-                c.kv = kv;
-                c.op = wxz::core::KvCodec::get(kv, "op", "");
-                c.id = wxz::core::KvCodec::get(kv, "id", "");
-                set_out(fn(c, arm, logger));
-            });
-        } else if (op == "slowSpeed" || op == "quickStop") {
-            router.add_route(op, {"enable"}, [&](const wxz::core::CommandRouter::KvMap& kv) {
-                ArmCommand c;
-                c.kv = kv;
-                c.op = wxz::core::KvCodec::get(kv, "op", "");
-                c.id = wxz::core::KvCodec::get(kv, "id", "");
-                set_out(fn(c, arm, logger));
-            });
-        } else {
-            router.add_route(op, {}, [&](const wxz::core::CommandRouter::KvMap& kv) {
-                ArmCommand c;
-                c.kv = kv;
-                c.op = wxz::core::KvCodec::get(kv, "op", "");
-                c.id = wxz::core::KvCodec::get(kv, "id", "");
-                set_out(fn(c, arm, logger));
-            });
+    // 仅对描述表中的 op 做必填字段校验，避免破坏第三方/模块扩展 op。
+    if (desc) {
+        for (const auto& arg : desc->args) {
+            if (!arg.required || has_arg(cmd, arg.key)) continue;
+            EventDTOUtil::KvMap resp = make_base_resp(cmd);
+            logger.log(LogLevel::Warn,
+                       "missing field: op='" + std::string(cmd.op) + "' key='" + std::string(arg.key) + "'");
+            arm_set_error(resp, ArmErrc::MissingField, "missing_" + std::string(arg.key));
+            return resp;
         }
     }
 
-    router.dispatch_kv(cmd.kv);
-    if (out_set) return out;
+    // 连接由 ArmConnectionManager 在后台维护时，断线期间内置 op 立即失败，不在 strand 上等待连接超时。
+    if (builtin && !arm.available()) {
+        EventDTOUtil::KvMap resp = make_base_resp(cmd);
+        arm_set_error(resp, ArmErrc::SdkUnavailable, "sdk_unavailable");
+        return resp;
+    }
 
-    // 兜底：按理不应发生，但仍保持行为安全。
-    EventDTOUtil::KvMap resp = make_base_resp(cmd);
-    logger.log(LogLevel::Warn, "dispatch produced no response");
-    arm_set_error(resp, ArmErrc::UnknownOp, "unknown_op");
-    return resp;
+    return fn(cmd, arm, logger);
 }
 
 } // namespace wxz::workstation::arm_control::internal
@@ -1,6 +1,7 @@
 #include "internal/arm_command_processor.h"
 
 #include "internal/arm_command_handler.h"
+#include "internal/arm_error_codes.h"
 
 namespace wxz::workstation::arm_control::internal {
 
@@ -11,4 +12,68 @@ EventDTOUtil::KvMap ArmCommandProcessor::handle_raw_command(const std::string& r
     return handle_arm_command(cmd, arm, logger);
 }
 
+EventDTOUtil::KvMap ArmCommandProcessor::handle_v2_command(const std::string& raw,
+                                                          IArmClient& arm,
+                                                          const wxz::core::Logger& logger) const {
+    wire::CommandV2 v2;
+    if (!wire::decode(raw, v2)) {
+        logger.log(LogLevel::Warn, "bad v2 command payload size=" + std::to_string(raw.size()));
+        EventDTOUtil::KvMap resp;
+        arm_set_error(resp, ArmErrc::BadRequest, "bad_v2_payload");
+        return resp;
+    }
+    return handle_arm_command(make_arm_command(v2), arm, logger);
+}
+
+EventDTOUtil::KvMap ArmCommandProcessor::handle_typed_command(const wire::CommandV2& cmd,
+                                                             std::string_view op_name,
+                                                             IArmClient& arm,
+                                                             const wxz::core::Logger& logger) const {
+    ArmCommand typed = make_arm_command(cmd);
+    if (!op_name.empty()) typed.op = op_name;
+    return handle_arm_command(typed, arm, logger);
+}
+
+const ops::OpDesc* ArmCommandProcessor::peek_op(const std::string& raw, bool v2) const {
+    if (v2) {
+        wire::CommandV2 cmd;
+        if (!wire::decode(raw, cmd)) return nullptr;
+        return &ops::op_desc(cmd.op);
+    }
+    return ops::find_op(parse_arm_command(raw).op);
+}
+
+bool ArmCommandProcessor::peek_key(const std::string& raw, bool v2, std::string& id, std::string& op) const {
+    if (v2) {
+        wire::CommandV2 cmd;
+        if (!wire::decode(raw, cmd) || cmd.id.view().empty()) return false;
+        id.assign(cmd.id.view());
+        op.assign(ops::op_desc(cmd.op).name);
+        return true;
+    }
+    const ArmCommand cmd = parse_arm_command(raw);
+    if (cmd.id.empty()) return false;
+    id.assign(cmd.id);
+    op.assign(cmd.op);
+    return true;
+}
+
+EventDTOUtil::KvMap ArmCommandProcessor::reject_command(const std::string& raw,
+                                                        bool v2,
+                                                        ArmErrc code,
+                                                        std::string_view err) const {
+    EventDTOUtil::KvMap resp;
+    wire::CommandV2 v2_cmd;
+    ArmCommand cmd;
+    if (!v2) {
+        cmd = parse_arm_command(raw);
+    } else if (wire::decode(raw, v2_cmd)) {
+        cmd = make_arm_command(v2_cmd);
+    }
+    if (!cmd.id.empty()) resp["id"] = std::string(cmd.id);
+    if (!cmd.op.empty()) resp["op"] = std::string(cmd.op);
+    arm_set_error(resp, code, err);
+    return resp;
+}
+
 }  // namespace wxz::workstation::arm_control::internal
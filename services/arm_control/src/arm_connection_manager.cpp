@@ -0,0 +1,105 @@
+#include "internal/arm_connection_manager.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "internal/arm_control_internal.h"
+#include "internal/arm_metrics.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+const char* connection_state_name(ArmConnectionManager::State s) {
+    switch (s) {
+        case ArmConnectionManager::State::Connecting: return "connecting";
+        case ArmConnectionManager::State::Connected: return "connected";
+        case ArmConnectionManager::State::Down: return "down";
+    }
+    return "unknown";
+}
+
+ArmConnectionManager::ArmConnectionManager(ArmSdkClient& arm, Options opts, wxz::core::Logger& logger)
+    : arm_(arm), opts_(std::move(opts)), logger_(logger) {
+    if (opts_.backoff_min.count() <= 0) opts_.backoff_min = std::chrono::milliseconds(200);
+    opts_.backoff_max = std::max(opts_.backoff_max, opts_.backoff_min);
+    if (opts_.check_period.count() <= 0) opts_.check_period = std::chrono::milliseconds(100);
+    backoff_ = opts_.backoff_min;
+}
+
+ArmConnectionManager::~ArmConnectionManager() {
+    stop();
+}
+
+void ArmConnectionManager::start() {
+    if (thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = false;
+    }
+    if (!attempt()) {
+        logger_.log(LogLevel::Warn, "arm session '" + opts_.name + "' not reachable at startup, retrying in background");
+    }
+    arm_.set_fail_fast(true);
+    thread_ = std::thread([this] { run(); });
+}
+
+void ArmConnectionManager::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    arm_.set_fail_fast(false);
+}
+
+void ArmConnectionManager::set_state(State s) {
+    const State prev = state_.exchange(s, std::memory_order_acq_rel);
+    if (prev == s) return;
+    logger_.log(s == State::Connected ? LogLevel::Info : LogLevel::Warn,
+                "arm session '" + opts_.name + "' " + connection_state_name(prev) + " -> " + connection_state_name(s));
+    ArmMetrics::gauge_set("wxz.arm.conn." + opts_.name + ".up", s == State::Connected ? 1.0 : 0.0, opts_.metrics_scope);
+}
+
+bool ArmConnectionManager::attempt() {
+    const auto t0 = std::chrono::steady_clock::now();
+    const CRresult r = arm_.try_connect();
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    ArmMetrics::observe("wxz.arm.conn." + opts_.name + ".connect_ms", ms, opts_.metrics_scope);
+    if (r == success) {
+        backoff_ = opts_.backoff_min;
+        set_state(State::Connected);
+        return true;
+    }
+    ArmMetrics::counter_add("wxz.arm.conn." + opts_.name + ".connect_fail_total", 1.0, opts_.metrics_scope);
+    if (state() != State::Down) {
+        logger_.log(LogLevel::Warn,
+                    "arm session '" + opts_.name + "' connect failed code=" + std::to_string(static_cast<int>(r)));
+    }
+    set_state(State::Down);
+    return false;
+}
+
+void ArmConnectionManager::run() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+        std::chrono::milliseconds wait = opts_.check_period;
+        if (!arm_.connected()) {
+            lock.unlock();
+            if (state() == State::Connected) {
+                // 指令执行中出错而断开：先标记下线（新指令立即失败），再立即重连一次。
+                set_state(State::Connecting);
+                ArmMetrics::counter_add("wxz.arm.conn." + opts_.name + ".reconnect_total", 1.0, opts_.metrics_scope);
+            }
+            if (!attempt()) {
+                wait = backoff_;
+                backoff_ = std::min(backoff_ * 2, opts_.backoff_max);
+            }
+            lock.lock();
+        } else if (state() != State::Connected) {
+            set_state(State::Connected);
+        }
+        cv_.wait_for(lock, wait, [this] { return stop_; });
+    }
+}
+
+} // namespace wxz::workstation::arm_control::internal
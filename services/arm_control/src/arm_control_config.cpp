@@ -1,9 +1,56 @@
 #include "internal/arm_control_config.h"
 
+#include <algorithm>
+#include <cctype>
+
 #include "logger.h"
 
 namespace wxz::workstation::arm_control::internal {
 
+std::string parse_arm_instances(std::string_view spec, const ArmConn& defaults, std::vector<ArmInstanceConfig>& out) {
+    out.clear();
+    auto trim = [](std::string_view v) {
+        while (!v.empty() && (v.front() == ' ' || v.front() == '\t')) v.remove_prefix(1);
+        while (!v.empty() && (v.back() == ' ' || v.back() == '\t')) v.remove_suffix(1);
+        return v;
+    };
+
+    while (!spec.empty()) {
+        const auto comma = spec.find(',');
+        const std::string_view item = trim(spec.substr(0, comma));
+        spec = (comma == std::string_view::npos) ? std::string_view{} : spec.substr(comma + 1);
+        if (item.empty()) continue;
+
+        const auto at = item.find('@');
+        if (at == std::string_view::npos) return "missing '@' in '" + std::string(item) + "'";
+
+        ArmInstanceConfig arm;
+        arm.id = std::string(trim(item.substr(0, at)));
+        arm.conn = defaults;
+        if (arm.id.empty() || !std::all_of(arm.id.begin(), arm.id.end(), [](unsigned char c) {
+                return std::isalnum(c) || c == '_' || c == '-';
+            })) {
+            return "invalid arm id in '" + std::string(item) + "'";
+        }
+        for (const auto& prev : out) {
+            if (prev.id == arm.id) return "duplicate arm id '" + arm.id + "'";
+        }
+
+        std::string_view addr = trim(item.substr(at + 1));
+        if (const auto colon = addr.rfind(':'); colon != std::string_view::npos) {
+            const auto port = parse_int(addr.substr(colon + 1));
+            if (!port || *port <= 0 || *port > 65535) return "invalid port in '" + std::string(item) + "'";
+            arm.conn.port = *port;
+            addr = addr.substr(0, colon);
+        }
+        if (addr.empty()) return "missing ip in '" + std::string(item) + "'";
+        arm.conn.ip = std::string(addr);
+        out.push_back(std::move(arm));
+    }
+    if (out.empty()) return "no arms listed";
+    return {};
+}
+
 ArmControlConfig load_arm_control_config_from_env() {
     ArmControlConfig cfg;
 
@@ -11,6 +58,24 @@ ArmControlConfig load_arm_control_config_from_env() {
     cfg.conn.port = Env::get_int("WXZ_ARM_PORT", 2323);
     cfg.conn.passwd = Env::get_str("WXZ_ARM_PASS", "123");
 
+    if (const std::string arms = Env::get_str("WXZ_ARMS", ""); !arms.empty()) {
+        cfg.arms_error = parse_arm_instances(arms, cfg.conn, cfg.arms);
+    }
+
+    cfg.ingress_thread = wxz::workstation::exec_thread_spec_from_env("WXZ_ARM_INGRESS", "arm-ingress");
+    cfg.sdk_thread = Env::get_int("WXZ_ARM_SDK_THREAD", -1);
+    cfg.sdk_cpus = wxz::workstation::parse_cpu_list(Env::get_str("WXZ_ARM_SDK_CPU", ""));
+    cfg.main_cpu = Env::get_int("WXZ_ARM_MAIN_CPU", -1);
+
+    cfg.rt.enable = Env::get_bool("WXZ_ARM_RT", false);
+    cfg.rt.fifo_priority = Env::get_int("WXZ_ARM_RT_PRIORITY", 80);
+    cfg.rt.mlock = Env::get_bool("WXZ_ARM_RT_MLOCK", true);
+    cfg.rt.stack_prefault = Env::get_size("WXZ_ARM_RT_STACK_KB", 512) * 1024;
+    cfg.rt.heap_reserve = Env::get_size("WXZ_ARM_RT_HEAP_MB", 64) * 1024 * 1024;
+    cfg.rt.required = Env::get_bool("WXZ_ARM_RT_REQUIRED", false);
+    cfg.rt_probe_ms = Env::get_int("WXZ_ARM_RT_PROBE_MS", 0);
+    cfg.rt_probe_report_ms = Env::get_int("WXZ_ARM_RT_PROBE_REPORT_MS", 10000);
+
     cfg.domain = Env::get_int("WXZ_DOMAIN_ID", 0);
 
     cfg.cmd_dto_topic = Env::get_str("WXZ_P1_ARM_COMMAND_TOPIC", "/arm/command");
@@ -19,6 +84,9 @@ ArmControlConfig load_arm_control_config_from_env() {
     cfg.status_dto_schema = Env::get_str("WXZ_ARM_STATUS_DTO_SCHEMA", "ws.arm_status.v1");
     cfg.dto_source = Env::get_str("WXZ_DTO_SOURCE", "workstation_arm_control_service");
     cfg.dto_max_payload = Env::get_size("WXZ_DTO_MAX_PAYLOAD", 8192);
+    cfg.wire_v2 = Env::get_bool("WXZ_ARM_WIRE_V2", false);
+    cfg.state_topic = Env::get_str("WXZ_ARM_STATE_TOPIC", "/arm/state");
+    cfg.state_pub_ms = Env::get_int("WXZ_ARM_STATE_PUB_MS", 100);
 
     cfg.capability_topic = Env::get_str("WXZ_CAPABILITY_STATUS_TOPIC", "capability/status");
     cfg.fault_status_topic = Env::get_str("WXZ_FAULT_STATUS_TOPIC", "fault/status");
@@ -30,6 +98,19 @@ ArmControlConfig load_arm_control_config_from_env() {
     cfg.health_file = Env::get_str("WXZ_HEALTH_FILE", "");
 
     cfg.queue_max = Env::get_size("WXZ_ARM_QUEUE_MAX", 64);
+    cfg.strand_in_flight_max = Env::get_size("WXZ_ARM_STRAND_INFLIGHT_MAX", 2);
+    cfg.loop_idle_ms = Env::get_int("WXZ_ARM_LOOP_IDLE_MS", 50);
+    cfg.state_poll_ms = Env::get_int("WXZ_ARM_STATE_POLL_MS", 100);
+    cfg.async_motion = Env::get_bool("WXZ_ARM_ASYNC_MOTION", false);
+    cfg.priority_lane = Env::get_bool("WXZ_ARM_PRIORITY_LANE", true);
+    cfg.replay_cache_max = Env::get_size("WXZ_ARM_REPLAY_CACHE_MAX", 0);
+    cfg.replay_ttl_ms = Env::get_int("WXZ_ARM_REPLAY_TTL_MS", 60000);
+    cfg.path_cache_max = Env::get_size("WXZ_ARM_PATH_CACHE_MAX", 8);
+    cfg.path_preload_dir = Env::get_str("WXZ_ARM_PATH_PRELOAD_DIR", "");
+    cfg.path_preload_threads = Env::get_int("WXZ_ARM_PATH_PRELOAD_THREADS", 2);
+    cfg.conn_manager = Env::get_bool("WXZ_ARM_CONN_MANAGER", true);
+    cfg.reconnect_min_ms = Env::get_int("WXZ_ARM_RECONNECT_MIN_MS", 200);
+    cfg.reconnect_max_ms = Env::get_int("WXZ_ARM_RECONNECT_MAX_MS", 10000);
     cfg.sw_version = Env::get_str("WXZ_SW_VERSION", "dev");
 
     cfg.rpc_enable = Env::get_int("WXZ_ARM_RPC_ENABLE", 0);
@@ -1,5 +1,8 @@
 #include "internal/arm_control_internal.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cmath>
 #include <chrono>
 #include <csignal>
@@ -8,6 +11,7 @@
 #include <iostream>
 #include <optional>
 #include <sstream>
+#include <system_error>
 #include <thread>
 #include <vector>
 
@@ -15,6 +19,11 @@
 
 #include "dto/event_dto_cdr.h"
 
+#include "internal/arm_metrics.h"
+#include "internal/arm_path_cache.h"
+#include "internal/arm_runtime_tunables.h"
+#include "internal/arm_wait.h"
+
 namespace wxz::workstation::arm_control::internal {
 
 namespace {
@@ -127,12 +136,66 @@ bool is_mode_motion_allowed(enum RobotModes mode) {
     }
 }
 
-CRresult precheck_blocking_motion_or_reject(ArmSdkClient& self, RobotHandle handle, const char* api_name, double speed_hint) {
+/// 单次 moveL/moveJ 的 SDK 调用统计（调用结束时上报）。
+struct MoveStats {
+    int sdk_calls{0};
+    bool precheck_cached{false};
+    double precheck_ms{0.0};
+};
+
+// read_motion_precheck_state 的 SDK 调用数。
+constexpr int kPrecheckStateCalls = 5;
+
+bool precheck_state_ok(const MotionPrecheckState& st) {
+    return st.moving != TRUE && st.control_mode == CONTROL_MODE_POSITION && st.speed_percent != 0 &&
+           is_mode_motion_allowed(st.mode);
+}
+
+void report_move_stats(const ArmSdkClient& self, const char* api_name, const MoveStats& stats, double issue_ms) {
+    const std::string& scope = self.metrics_scope();
+    const std::string prefix = std::string("wxz.arm.move.") + api_name;
+    const char* source = stats.precheck_cached ? "wxz.arm.move.precheck_cached_total" : "wxz.arm.move.precheck_live_total";
+    ArmMetrics::counter_add(source, 1.0, scope);
+    ArmMetrics::observe(prefix + ".sdk_calls", static_cast<double>(stats.sdk_calls), scope);
+    ArmMetrics::observe(prefix + ".precheck_ms", stats.precheck_ms, scope);
+    ArmMetrics::observe(prefix + ".issue_ms", issue_ms, scope);
+}
+
+double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+std::int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+CRresult precheck_blocking_motion_or_reject(ArmSdkClient& self,
+                                            RobotHandle handle,
+                                            const char* api_name,
+                                            double speed_hint,
+                                            MoveStats& stats) {
+    const auto t0 = std::chrono::steady_clock::now();
     MotionPrecheckState st{};
-    const CRresult r = read_motion_precheck_state(handle, st);
-    if (r != success) return r;
+    // 新鲜且一切正常的快照直接放行；快照过旧或显示异常时实时重读（异常可能已消除，且需要准确的诊断信息）。
+    if (const auto s = self.precheck_snapshot()) {
+        st.mode = static_cast<enum RobotModes>(s->mode);
+        st.moving = s->moving ? TRUE : FALSE;
+        st.control_mode = s->control_mode;
+        st.speed_percent = s->speed_percent;
+        stats.precheck_cached = precheck_state_ok(st);
+    }
+    if (!stats.precheck_cached) {
+        stats.sdk_calls += kPrecheckStateCalls;
+        const CRresult r = read_motion_precheck_state(handle, st);
+        if (r != success) return r;
+    }
 
-    if (self.IsStopSignal()) {
+    // 停止信号始终实时读取，不使用快照。
+    ++stats.sdk_calls;
+    const bool stop = self.IsStopSignal();
+    stats.precheck_ms = ms_since(t0);
+    if (stop) {
         return CR_FAILED;
     }
 
@@ -183,36 +246,38 @@ CRresult wait_motion_complete_or_timeout(ArmSdkClient& self,
                                         const char* api_name,
                                         std::chrono::milliseconds start_grace,
                                         std::chrono::milliseconds complete_timeout) {
-    const auto start_deadline = std::chrono::steady_clock::now() + start_grace;
-    BOOL moving = FALSE;
-    while (std::chrono::steady_clock::now() < start_deadline) {
+    const std::uint64_t epoch = self.stop_epoch();
+    // 停止请求/停止信号：两个阶段都以 CR_FAILED 提前结束。
+    auto stopped = [&]() -> std::optional<CRresult> {
+        if (self.stop_epoch() != epoch) return CR_FAILED;
         if (self.IsStopSignal()) {
             (void)::cr_stop(handle);
             return CR_FAILED;
         }
-        const CRresult r = ::cr_get_robotMoveStatus(handle, &moving);
-        if (r != success) return r;
-        if (moving == TRUE) break;
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-    }
+        return std::nullopt;
+    };
 
-    if (moving != TRUE) {
-        return move_error;
-    }
+    BOOL moving = FALSE;
+    const WaitSpec start_spec{.op = "motion_start", .timeout = start_grace, .max_period = std::chrono::milliseconds(20)};
+    const auto started = adaptive_wait(start_spec, self.metrics_scope(), [&]() -> std::optional<CRresult> {
+        if (auto r = stopped()) return r;
+        const CRresult r = ::cr_get_robotMoveStatus(handle, &moving);
+        if (r != success || moving == TRUE) return r;
+        return std::nullopt;
+    });
+    if (!started) return move_error;
+    if (*started != success) return *started;
 
-    const auto done_deadline = std::chrono::steady_clock::now() + complete_timeout;
-    while (std::chrono::steady_clock::now() < done_deadline) {
-        if (self.IsStopSignal()) {
-            (void)::cr_stop(handle);
-            return CR_FAILED;
-        }
+    const WaitSpec done_spec{.op = "motion_done", .timeout = complete_timeout};
+    const auto done = adaptive_wait(done_spec, self.metrics_scope(), [&]() -> std::optional<CRresult> {
+        if (auto r = stopped()) return r;
         const CRresult r = ::cr_get_robotMoveStatus(handle, &moving);
-        if (r != success) return r;
-        if (moving != TRUE) {
-            std::cerr << api_name << " fallback-wait: motion complete" << "\n";
-            return success;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if (r != success || moving != TRUE) return r;
+        return std::nullopt;
+    });
+    if (done) {
+        if (*done == success) std::cerr << api_name << " fallback-wait: motion complete" << "\n";
+        return *done;
     }
 
     std::cerr << api_name << " fallback-wait: timeout" << "\n";
@@ -247,77 +312,135 @@ std::size_t Env::get_size(const char* key, std::size_t def) {
     }
 }
 
-std::optional<std::array<double, 6>> parse_csv6(const std::string& s) {
-    std::array<double, 6> out{};
-    std::size_t start = 0;
-    int idx = 0;
-    while (idx < 6) {
-        std::size_t end = s.find(',', start);
-        std::string token = (end == std::string::npos) ? s.substr(start) : s.substr(start, end - start);
-        while (!token.empty() && token.front() == ' ') token.erase(token.begin());
-        while (!token.empty() && token.back() == ' ') token.pop_back();
-        if (token.empty()) return std::nullopt;
-        try {
-            out[static_cast<std::size_t>(idx)] = std::stod(token);
-        } catch (...) {
-            return std::nullopt;
-        }
-        ++idx;
-        if (end == std::string::npos) break;
-        start = end + 1;
+namespace {
+
+// 去掉首尾空格（与历史 parse_csv6 的 token 裁剪一致）。
+std::string_view trim_spaces(std::string_view s) {
+    while (!s.empty() && s.front() == ' ') s.remove_prefix(1);
+    while (!s.empty() && s.back() == ' ') s.remove_suffix(1);
+    return s;
+}
+
+// 兼容 std::stod/stoi 接受的前缀：前导空白与显式 '+'（from_chars 本身不接受）。
+std::string_view strip_numeric_prefix(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+    if (s.size() > 1 && s.front() == '+' && s[1] != '-' && s[1] != '+') s.remove_prefix(1);
+    return s;
+}
+
+// 整串必须被完整消费；越界、空串、尾随字符均视为失败。无异常、无分配。
+template <class T, class... Fmt>
+std::optional<T> from_chars_full(std::string_view s, Fmt... fmt) {
+    if (s.empty()) return std::nullopt;
+    T v{};
+    const char* const last = s.data() + s.size();
+    const auto [ptr, ec] = std::from_chars(s.data(), last, v, fmt...);
+    if (ec != std::errc{} || ptr != last) return std::nullopt;
+    return v;
+}
+
+template <class T>
+std::optional<T> from_chars_exact(std::string_view s) {
+    return from_chars_full<T>(strip_numeric_prefix(s));
+}
+
+// 0x 之后的十六进制浮点主体：hex 数字 [. hex 数字]（至少一位）[p [+-] 十进制数字]。
+// from_chars(hex) 本身还会接受 "inf"/"nan" 与 "p+-3" 这类 strtod 不接受的写法（libstdc++ 12），先按语法过滤。
+bool is_hex_float_body(std::string_view s) {
+    std::size_t i = 0;
+    std::size_t digits = 0;
+    while (i < s.size() && std::isxdigit(static_cast<unsigned char>(s[i]))) ++i, ++digits;
+    if (i < s.size() && s[i] == '.') {
+        ++i;
+        while (i < s.size() && std::isxdigit(static_cast<unsigned char>(s[i]))) ++i, ++digits;
     }
-    if (idx != 6) return std::nullopt;
-    return out;
+    if (digits == 0) return false;
+    if (i == s.size()) return true;
+    if (s[i] != 'p' && s[i] != 'P') return false;
+    ++i;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) ++i;
+    if (i == s.size()) return false;
+    while (i < s.size() && std::isdigit(static_cast<unsigned char>(s[i]))) ++i;
+    return i == s.size();
 }
 
-std::optional<double> parse_double(const std::string& s) {
-    try {
-        std::size_t idx = 0;
-        double v = std::stod(s, &idx);
-        if (idx != s.size()) return std::nullopt;
-        return v;
-    } catch (...) {
-        return std::nullopt;
+// double 额外兼容 strtod 的十六进制浮点（"0x1p3"）；from_chars 需去掉 0x 前缀并单独处理符号。
+template <>
+std::optional<double> from_chars_exact<double>(std::string_view s) {
+    s = strip_numeric_prefix(s);
+    std::string_view body = s;
+    const bool neg = !body.empty() && body.front() == '-';
+    if (neg) body.remove_prefix(1);
+    if (body.size() > 2 && body[0] == '0' && (body[1] == 'x' || body[1] == 'X')) {
+        body.remove_prefix(2);
+        if (!is_hex_float_body(body)) return std::nullopt;
+        const auto v = from_chars_full<double>(body, std::chars_format::hex);
+        if (!v) return std::nullopt;
+        return neg ? -*v : *v;
     }
+    return from_chars_full<double>(s);
 }
 
-std::optional<int> parse_int(const std::string& s) {
-    try {
-        std::size_t idx = 0;
-        int v = std::stoi(s, &idx);
-        if (idx != s.size()) return std::nullopt;
-        return v;
-    } catch (...) {
-        return std::nullopt;
+} // namespace
+
+std::optional<std::array<double, 6>> parse_csv6(std::string_view s) {
+    std::array<double, 6> out{};
+    std::size_t n = 0;
+    while (n < out.size()) {
+        // string_view::find(char) 走 memchr（glibc 下为向量化实现）。
+        const std::size_t end = s.find(',');
+        const auto v = from_chars_exact<double>(trim_spaces(s.substr(0, end)));
+        if (!v) return std::nullopt;
+        out[n++] = *v;
+        if (end == std::string_view::npos) break;
+        s.remove_prefix(end + 1);
     }
+    if (n != out.size()) return std::nullopt;
+    return out;
 }
 
-std::optional<std::size_t> parse_size(const std::string& s) {
-    try {
-        std::size_t idx = 0;
-        auto v = static_cast<std::size_t>(std::stoul(s, &idx));
-        if (idx != s.size()) return std::nullopt;
-        return v;
-    } catch (...) {
-        return std::nullopt;
+std::optional<std::vector<std::array<double, 6>>> parse_csv6_list(std::string_view s, std::size_t max_points) {
+    if (trim_spaces(s).empty()) return std::nullopt;
+    std::vector<std::array<double, 6>> out;
+    while (true) {
+        const std::size_t end = s.find('|');
+        if (out.size() >= max_points) return std::nullopt;
+        const auto p = parse_csv6(s.substr(0, end));
+        if (!p) return std::nullopt;
+        out.push_back(*p);
+        if (end == std::string_view::npos) break;
+        s.remove_prefix(end + 1);
     }
+    return out;
+}
+
+std::optional<double> parse_double(std::string_view s) {
+    return from_chars_exact<double>(s);
+}
+
+std::optional<int> parse_int(std::string_view s) {
+    return from_chars_exact<int>(s);
+}
+
+std::optional<std::size_t> parse_size(std::string_view s) {
+    return from_chars_exact<std::size_t>(s);
 }
 
-CmdQueue::CmdQueue(std::size_t max_size) : max_size_(max_size) {}
+CmdQueue::CmdQueue(std::size_t max_size) : ring_(max_size) {}
 
 bool CmdQueue::push(Cmd cmd) {
-    std::lock_guard<std::mutex> lock(mu_);
-    if (q_.size() >= max_size_) return false;
-    q_.push(std::move(cmd));
-    cv_.notify_one();
+    if (!ring_.try_push(std::move(cmd))) return false;
+    // Dekker 式握手：ring 的发布只是 release store，之后读 waiters_ 可能被提前到 store 之前。
+    // 两侧各放一道 seq_cst fence（与 pop_for 中 fetch_add 之后的 fence 配对），保证
+    // “本侧看到 waiters_ > 0” 与 “对侧重新检查时看到新元素” 至少一个成立，避免丢失唤醒。
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) > 0) wake_.notify();
     return true;
 }
 
 std::optional<Cmd> CmdQueue::try_pop() {
-    std::lock_guard<std::mutex> lock(mu_);
-    if (q_.empty()) return std::nullopt;
-    Cmd cmd = std::move(q_.front());
-    q_.pop();
+    Cmd cmd;
+    if (!ring_.try_pop(cmd)) return std::nullopt;
     return cmd;
 }
 
@@ -326,14 +449,24 @@ std::optional<Cmd> CmdQueue::pop_for(std::chrono::milliseconds timeout, const st
 }
 
 std::optional<Cmd> CmdQueue::pop_for(std::chrono::milliseconds timeout, const std::function<bool()>& running) {
-    std::unique_lock<std::mutex> lock(mu_);
-    if (!cv_.wait_for(lock, timeout, [&] { return !q_.empty() || !running(); })) {
-        return std::nullopt;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        if (auto cmd = try_pop()) return cmd;
+        if (!running()) return std::nullopt;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) return std::nullopt;
+
+        waiters_.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // 与 push 中的 fence 配对
+        if (auto cmd = try_pop()) {
+            waiters_.fetch_sub(1);
+            return cmd;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        (void)wake_.wait_for(std::max(remaining, std::chrono::milliseconds(1)));
+        waiters_.fetch_sub(1);
     }
-    if (q_.empty()) return std::nullopt;
-    Cmd cmd = std::move(q_.front());
-    q_.pop();
-    return cmd;
 }
 
 StatusPublisher::StatusPublisher(int domain,
@@ -387,20 +520,39 @@ CRresult ArmSdkClient::connect() {
     if (r == success) {
         handle_ = handle;
         connected_ = true;
+        link_up_.store(true, std::memory_order_release);
     }
     return r;
 }
 
+CRresult ArmSdkClient::try_connect() {
+    if (link_up_.load(std::memory_order_acquire)) return success;
+    RobotHandle handle{};
+    const CRresult r = ::cr_create_robot(&handle, conn_.ip.c_str(), conn_.port, conn_.passwd.c_str());
+    if (r != success) return r;
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    if (connected_) {
+        (void)::cr_destroy_robot(handle);
+        return success;
+    }
+    handle_ = handle;
+    connected_ = true;
+    link_up_.store(true, std::memory_order_release);
+    return success;
+}
+
 void ArmSdkClient::disconnect() {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
     if (!connected_) return;
     (void)::cr_destroy_robot(handle_);
     connected_ = false;
+    link_up_.store(false, std::memory_order_release);
     handle_ = 0;
 }
 
 CRresult ArmSdkClient::ensure_connected() {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    if (fail_fast_.load(std::memory_order_acquire)) return connected_ ? success : CR_FAILED;
     CRresult r = connect();
     if (r == success) return r;
     disconnect();
@@ -434,28 +586,36 @@ std::optional<PathRunMsg> ArmSdkClient::get_path_run_status() {
     return msg;
 }
 
+bool robot_mode_is_ready(int mode) {
+    return (mode == static_cast<int>(ProgramStop) || mode == static_cast<int>(Jog) || mode == static_cast<int>(JointIdle));
+}
+
+bool robot_mode_is_powered(int mode) {
+    return (mode != static_cast<int>(JointPowerOff) && mode != static_cast<int>(Closed));
+}
+
 bool ArmSdkClient::IsArmReady() {
     int mode = static_cast<int>(Closed);
     const CRresult r = get_robot_mode(mode);
     if (r != success) return false;
-    return (mode == static_cast<int>(ProgramStop) || mode == static_cast<int>(Jog) || mode == static_cast<int>(JointIdle));
+    return robot_mode_is_ready(mode);
 }
 
 bool ArmSdkClient::IsPowerOn() {
     int mode = static_cast<int>(Closed);
     const CRresult r = get_robot_mode(mode);
     if (r != success) return false;
-    return (mode != static_cast<int>(JointPowerOff) && mode != static_cast<int>(Closed));
+    return robot_mode_is_powered(mode);
 }
 
 bool ArmSdkClient::IsStartSignal() {
-    const int idx = Env::get_int("WXZ_ARM_START_DI_INDEX", 0);
+    const int idx = tunables().start_di_index;
     const auto v = read_config_di(idx);
     return v.value_or(false);
 }
 
 bool ArmSdkClient::IsStopSignal() {
-    const int idx = Env::get_int("WXZ_ARM_STOP_DI_INDEX", 1);
+    const int idx = tunables().stop_di_index;
     const auto v = read_config_di(idx);
     return v.value_or(false);
 }
@@ -497,21 +657,26 @@ CRresult ArmSdkClient::InitializeArm(Logger const& logger) {
 
 CRresult ArmSdkClient::WaitForStart(std::chrono::milliseconds timeout, Logger const& logger) {
     (void)logger;
-    const auto deadline = std::chrono::steady_clock::now() + timeout;
-    while (std::chrono::steady_clock::now() < deadline) {
-        if (IsStopSignal()) return CR_FAILED;
+    const std::uint64_t epoch = stop_epoch();
+    const WaitSpec spec{.op = "wait_for_start", .timeout = timeout, .max_period = std::chrono::milliseconds(20)};
+    const auto r = adaptive_wait(spec, metrics_scope_, [&]() -> std::optional<CRresult> {
+        if (stop_epoch() != epoch || IsStopSignal()) return CR_FAILED;
         if (IsStartSignal()) return success;
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-    }
-    return CR_FAILED;
+        return std::nullopt;
+    });
+    return r.value_or(CR_FAILED);
 }
 
 CRresult ArmSdkClient::ExecuteTrajectory(std::chrono::milliseconds timeout, Logger const& logger) {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    if (motion_in_flight_) {
+        logger.log(LogLevel::Warn, "ExecuteTrajectory rejected: non-blocking motion in progress");
+        return CR_FAILED;
+    }
     const CRresult cr = ensure_connected();
     if (cr != success) return cr;
 
-    const int path_index = Env::get_int("WXZ_ARM_PATH_INDEX", 0);
+    const int path_index = tunables().path_index;
     logger.log(LogLevel::Info, std::string("ExecuteTrajectory path_index=") + std::to_string(path_index));
     CRresult r = ::cr_path_action(handle_, path_index, 1 /*start*/);
     if (r != success) {
@@ -519,15 +684,14 @@ CRresult ArmSdkClient::ExecuteTrajectory(std::chrono::milliseconds timeout, Logg
         return r;
     }
 
-    const auto deadline = std::chrono::steady_clock::now() + timeout;
-    while (std::chrono::steady_clock::now() < deadline) {
-        if (IsStopSignal()) {
-            (void)::cr_path_action(handle_, path_index, 0 /*stop*/);
-            return CR_FAILED;
-        }
+    const std::uint64_t epoch = stop_epoch();
+    const WaitSpec spec{.op = "execute_trajectory", .timeout = timeout, .min_period = std::chrono::milliseconds(10)};
+    const auto done = adaptive_wait(spec, metrics_scope_, [&]() -> std::optional<CRresult> {
+        if (stop_epoch() != epoch || IsStopSignal()) return CR_FAILED;
         if (IsTrajectoryComplete()) return success;
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    }
+        return std::nullopt;
+    });
+    if (done && *done == success) return success;
 
     (void)::cr_path_action(handle_, path_index, 0 /*stop*/);
     return CR_FAILED;
@@ -540,6 +704,8 @@ CRresult ArmSdkClient::EmergencyStop(Logger const& logger) {
     if (cr != success) return cr;
     const CRresult r = ::cr_stop(handle_);
     if (r != success) disconnect();
+    if (motion_in_flight_) motion_interrupted_ = true;
+    if (stop_peer_) stop_peer_->note_stop_requested();
     return r;
 }
 
@@ -555,8 +721,14 @@ CRresult ArmSdkClient::moveL(const std::array<double, 6>& jointpos,
                             double acc,
                             double jerk) {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    if (motion_in_flight_) {
+        std::cerr << "moveL rejected: previous non-blocking motion still in progress" << "\n";
+        return CR_FAILED;
+    }
     const CRresult cr = ensure_connected();
     if (cr != success) return cr;
+    // 整个调用只取一次快照：各开关来自同一版本（见 arm_runtime_tunables.h）。
+    const ArmRuntimeTunables& tun = tunables();
 
     // 最后一层安全检查（不完全依赖上游校验）。
     auto is_finite6 = [](const std::array<double, 6>& v) {
@@ -577,10 +749,10 @@ CRresult ArmSdkClient::moveL(const std::array<double, 6>& jointpos,
     constexpr double kMaxAbsAngleRadSuspicious = 10.0; // 约 572 度
     for (int i = 3; i < 6; ++i) {
         if (std::fabs(pose[static_cast<std::size_t>(i)]) > kMaxAbsAngleRadSuspicious) {
-            // 默认拒绝；高级用户可通过环境变量显式放行。
-            if (!Env::get_bool("WXZ_ARM_ALLOW_LARGE_ANGLE", false)) {
+            // 默认拒绝；高级用户可通过环境变量或 arm.set_tunables 显式放行。
+            if (!tun.allow_large_angle) {
                 std::cerr << "moveL rejected: pose angle(rad) suspicious (>" << kMaxAbsAngleRadSuspicious
-                          << "), set WXZ_ARM_ALLOW_LARGE_ANGLE=1 to override" << "\n";
+                          << "), set WXZ_ARM_ALLOW_LARGE_ANGLE=1 or arm.set_tunables allow_large_angle to override" << "\n";
                 disconnect();
                 return CR_FAILED;
             }
@@ -589,9 +761,9 @@ CRresult ArmSdkClient::moveL(const std::array<double, 6>& jointpos,
     }
     for (int i = 0; i < 6; ++i) {
         if (std::fabs(jointpos[static_cast<std::size_t>(i)]) > kMaxAbsAngleRadSuspicious) {
-            if (!Env::get_bool("WXZ_ARM_ALLOW_LARGE_JOINT", false)) {
+            if (!tun.allow_large_joint) {
                 std::cerr << "moveL rejected: jointpos(rad) suspicious (>" << kMaxAbsAngleRadSuspicious
-                          << "), set WXZ_ARM_ALLOW_LARGE_JOINT=1 to override" << "\n";
+                          << "), set WXZ_ARM_ALLOW_LARGE_JOINT=1 or arm.set_tunables allow_large_joint to override" << "\n";
                 disconnect();
                 return CR_FAILED;
             }
@@ -634,7 +806,7 @@ CRresult ArmSdkClient::moveL(const std::array<double, 6>& jointpos,
     p.motiontriggerMode = MovetriggerbyOnlyRpc;
 
     // 可选 dry-run：仅打印计算后的参数，不实际下发运动。
-    if (Env::get_bool("WXZ_ARM_DRY_RUN", false)) {
+    if (tun.dry_run) {
         std::ostringstream os;
         os.setf(std::ios::fixed);
         os << "moveL dry_run: "
@@ -650,40 +822,47 @@ CRresult ArmSdkClient::moveL(const std::array<double, 6>& jointpos,
         return success;
     }
 
+    MoveStats stats;
     {
-        const CRresult pr = precheck_blocking_motion_or_reject(*this, handle_, "moveL", speed);
+        const CRresult pr = precheck_blocking_motion_or_reject(*this, handle_, "moveL", speed, stats);
         if (pr != success) return pr;
     }
 
-    const CRresult r = ::cr_move_line(handle_, p, TRUE);
+    const auto issue_t0 = std::chrono::steady_clock::now();
+    ++stats.sdk_calls;
+    const CRresult r = ::cr_move_line(handle_, p, async_motion_ ? FALSE : TRUE);
+    const double issue_ms = ms_since(issue_t0);
+    motion_done_ns_ = steady_now_ns();
+    if (r == success && async_motion_) {
+        motion_started_ = true;
+        motion_in_flight_ = true;
+        motion_interrupted_ = false;
+        motion_stop_epoch_ = stop_epoch();
+    }
     if (r != success) {
-        if (r == move_error) {
-            const auto start_grace = std::chrono::milliseconds(Env::get_int("WXZ_ARM_MOVE_START_GRACE_MS", 400));
-            const auto complete_timeout =
-                std::chrono::milliseconds(Env::get_int("WXZ_ARM_MOVE_COMPLETE_TIMEOUT_MS", 600000));
+        if (r == move_error && !async_motion_) {
+            const auto start_grace = std::chrono::milliseconds(tun.move_start_grace_ms);
+            const auto complete_timeout = std::chrono::milliseconds(tun.move_complete_timeout_ms);
             std::cerr << "moveL got move_error, entering fallback wait"
                       << " start_grace_ms=" << start_grace.count()
                       << " complete_timeout_ms=" << complete_timeout.count() << "\n";
             const CRresult fr = wait_motion_complete_or_timeout(*this, handle_, "moveL", start_grace, complete_timeout);
-            if (fr == success) return success;
+            motion_done_ns_ = steady_now_ns();
+            if (fr == success) {
+                report_move_stats(*this, "moveL", stats, issue_ms);
+                return success;
+            }
         }
-        // 增补诊断信息，便于区分：参数/单位问题 vs robot mode 问题 vs 运动状态问题。
-        enum RobotModes mode = Closed;
-        BOOL moving = FALSE;
-        int control_mode = -1;
-        unsigned int speed_percent = 0;
-        (void)::cr_get_robotMode(handle_, &mode);
-        (void)::cr_get_robotMoveStatus(handle_, &moving);
-        (void)::cr_get_controlMode(handle_, &control_mode);
-        (void)::cr_get_robotSpeedPercent(handle_, &speed_percent);
-        BOOL tp_use = FALSE;
-        (void)::cr_cfg_safety_tp_use_get(handle_, &tp_use);
+        // 增补诊断信息，便于区分：参数/单位问题 vs robot mode 问题 vs 运动状态问题（仅失败路径实时读取）。
+        MotionPrecheckState diag{};
+        stats.sdk_calls += kPrecheckStateCalls;
+        (void)read_motion_precheck_state(handle_, diag);
         std::cerr << "moveL failed code=" << static_cast<int>(r) << " (" << cr_result_name(r) << ")"
-                  << " robotMode=" << static_cast<int>(mode) << "(" << robot_mode_name(mode) << ")"
-                  << " controlMode=" << control_mode
-                  << " speedPercent=" << speed_percent
-                  << " tpUse=" << (tp_use == TRUE ? 1 : 0)
-                  << " isMoving=" << (moving == TRUE ? 1 : 0)
+                  << " robotMode=" << static_cast<int>(diag.mode) << "(" << robot_mode_name(diag.mode) << ")"
+                  << " controlMode=" << diag.control_mode
+                  << " speedPercent=" << diag.speed_percent
+                  << " tpUse=" << (diag.tp_use == TRUE ? 1 : 0)
+                  << " isMoving=" << (diag.moving == TRUE ? 1 : 0)
                   << " speed=" << speed << " acc=" << acc << " jerk_in=" << jerk
                   << " coordinateType=" << static_cast<int>(p.coordinateType)
                   << " tcpID=" << p.tcpID
@@ -699,13 +878,19 @@ CRresult ArmSdkClient::moveL(const std::array<double, 6>& jointpos,
             disconnect();
         }
     }
+    report_move_stats(*this, "moveL", stats, issue_ms);
     return r;
 }
 
 CRresult ArmSdkClient::moveJ(const std::array<double, 6>& jointpos, double speed_rad_per_s) {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    if (motion_in_flight_) {
+        std::cerr << "moveJ rejected: previous non-blocking motion still in progress" << "\n";
+        return CR_FAILED;
+    }
     const CRresult cr = ensure_connected();
     if (cr != success) return cr;
+    const ArmRuntimeTunables& tun = tunables();
 
     const double speed_deg = speed_rad_per_s * 180.0 / 3.14159265358979323846;
     PointControlPara p{};
@@ -727,39 +912,46 @@ CRresult ArmSdkClient::moveJ(const std::array<double, 6>& jointpos, double speed
     p.poseTranType = poseTranMoveToTargetPose;
     p.motiontriggerMode = MovetriggerbyOnlyRpc;
 
+    MoveStats stats;
     {
-        const CRresult pr = precheck_blocking_motion_or_reject(*this, handle_, "moveJ", speed_rad_per_s);
+        const CRresult pr = precheck_blocking_motion_or_reject(*this, handle_, "moveJ", speed_rad_per_s, stats);
         if (pr != success) return pr;
     }
 
-    const CRresult r = ::cr_move_joint(handle_, p, TRUE);
+    const auto issue_t0 = std::chrono::steady_clock::now();
+    ++stats.sdk_calls;
+    const CRresult r = ::cr_move_joint(handle_, p, async_motion_ ? FALSE : TRUE);
+    const double issue_ms = ms_since(issue_t0);
+    motion_done_ns_ = steady_now_ns();
+    if (r == success && async_motion_) {
+        motion_started_ = true;
+        motion_in_flight_ = true;
+        motion_interrupted_ = false;
+        motion_stop_epoch_ = stop_epoch();
+    }
     if (r != success) {
-        if (r == move_error) {
-            const auto start_grace = std::chrono::milliseconds(Env::get_int("WXZ_ARM_MOVE_START_GRACE_MS", 400));
-            const auto complete_timeout =
-                std::chrono::milliseconds(Env::get_int("WXZ_ARM_MOVE_COMPLETE_TIMEOUT_MS", 600000));
+        if (r == move_error && !async_motion_) {
+            const auto start_grace = std::chrono::milliseconds(tun.move_start_grace_ms);
+            const auto complete_timeout = std::chrono::milliseconds(tun.move_complete_timeout_ms);
             std::cerr << "moveJ got move_error, entering fallback wait"
                       << " start_grace_ms=" << start_grace.count()
                       << " complete_timeout_ms=" << complete_timeout.count() << "\n";
             const CRresult fr = wait_motion_complete_or_timeout(*this, handle_, "moveJ", start_grace, complete_timeout);
-            if (fr == success) return success;
+            motion_done_ns_ = steady_now_ns();
+            if (fr == success) {
+                report_move_stats(*this, "moveJ", stats, issue_ms);
+                return success;
+            }
         }
-        enum RobotModes mode = Closed;
-        BOOL moving = FALSE;
-        int control_mode = -1;
-        unsigned int speed_percent = 0;
-        (void)::cr_get_robotMode(handle_, &mode);
-        (void)::cr_get_robotMoveStatus(handle_, &moving);
-        (void)::cr_get_controlMode(handle_, &control_mode);
-        (void)::cr_get_robotSpeedPercent(handle_, &speed_percent);
-        BOOL tp_use = FALSE;
-        (void)::cr_cfg_safety_tp_use_get(handle_, &tp_use);
+        MotionPrecheckState diag{};
+        stats.sdk_calls += kPrecheckStateCalls;
+        (void)read_motion_precheck_state(handle_, diag);
         std::cerr << "moveJ failed code=" << static_cast<int>(r) << " (" << cr_result_name(r) << ")"
-                  << " robotMode=" << static_cast<int>(mode) << "(" << robot_mode_name(mode) << ")"
-                  << " controlMode=" << control_mode
-                  << " speedPercent=" << speed_percent
-                  << " tpUse=" << (tp_use == TRUE ? 1 : 0)
-                  << " isMoving=" << (moving == TRUE ? 1 : 0)
+                  << " robotMode=" << static_cast<int>(diag.mode) << "(" << robot_mode_name(diag.mode) << ")"
+                  << " controlMode=" << diag.control_mode
+                  << " speedPercent=" << diag.speed_percent
+                  << " tpUse=" << (diag.tp_use == TRUE ? 1 : 0)
+                  << " isMoving=" << (diag.moving == TRUE ? 1 : 0)
                   << " speed_rad_per_s=" << speed_rad_per_s
                   << " coordinateType=" << static_cast<int>(p.coordinateType)
                   << "\n";
@@ -768,6 +960,7 @@ CRresult ArmSdkClient::moveJ(const std::array<double, 6>& jointpos, double speed
             disconnect();
         }
     }
+    report_move_stats(*this, "moveJ", stats, issue_ms);
     return r;
 }
 
@@ -782,25 +975,32 @@ CRresult ArmSdkClient::power_on_enable(Logger const& logger) {
     logger.log(LogLevel::Debug, std::string("robotMode=") + std::to_string(static_cast<int>(mode)));
 
     if (mode == JointPowerOff) {
+        // 等待 robotMode 到达 target；超时不视为失败（与原固定步长循环一致，继续后续步骤）。
+        auto wait_mode = [&](const WaitSpec& spec, RobotModes target) {
+            const auto res = adaptive_wait(spec, metrics_scope_, [&]() -> std::optional<CRresult> {
+                const CRresult rr = ::cr_get_robotMode(handle_, &mode);
+                if (rr != success || mode == target) return rr;
+                return std::nullopt;
+            });
+            return res.value_or(success);
+        };
+
         r = ::cr_poweron(handle_);
         if (r != success) return r;
-
-        for (int i = 0; i < 40; ++i) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            r = ::cr_get_robotMode(handle_, &mode);
-            if (r != success) return r;
-            if (mode == JointIdle) break;
-        }
+        r = wait_mode(WaitSpec{.op = "power_on",
+                               .timeout = std::chrono::milliseconds(2000),
+                               .min_period = std::chrono::milliseconds(10)},
+                      JointIdle);
+        if (r != success) return r;
 
         r = ::cr_enable(handle_);
         if (r != success) return r;
-
-        for (int i = 0; i < 40; ++i) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            r = ::cr_get_robotMode(handle_, &mode);
-            if (r != success) return r;
-            if (mode == ProgramStop) break;
-        }
+        r = wait_mode(WaitSpec{.op = "enable",
+                               .timeout = std::chrono::milliseconds(8000),
+                               .min_period = std::chrono::milliseconds(10),
+                               .max_period = std::chrono::milliseconds(200)},
+                      ProgramStop);
+        if (r != success) return r;
     }
 
     return success;
@@ -820,6 +1020,76 @@ CRresult ArmSdkClient::get_robot_mode(int& out_mode) {
     return success;
 }
 
+ArmSdkClient::SampleResult ArmSdkClient::sample_state() {
+    std::unique_lock<std::recursive_mutex> lock(sdk_mu_, std::try_to_lock);
+    if (!lock.owns_lock()) return SampleResult::Busy;
+    if (!connected_) return SampleResult::Disconnected;
+
+    const ArmRuntimeTunables& tun = tunables();
+    ArmStateSample s{};
+    s.ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now().time_since_epoch())
+                  .count();
+
+    enum RobotModes mode = Closed;
+    BOOL moving = FALSE;
+    if (::cr_get_robotMode(handle_, &mode) != success) return SampleResult::Failed;
+    if (::cr_get_robotMoveStatus(handle_, &moving) != success) return SampleResult::Failed;
+    if (::cr_get_controlMode(handle_, &s.control_mode) != success) return SampleResult::Failed;
+    if (::cr_get_robotSpeedPercent(handle_, &s.speed_percent) != success) return SampleResult::Failed;
+    s.mode = static_cast<int>(mode);
+    s.moving = (moving == TRUE);
+
+#if !defined(ROB_AXIS_NUM) || (ROB_AXIS_NUM >= 6)
+    double pos[ROB_AXIS_NUM]{};
+    if (::cr_get_jointActualPos(handle_, pos) != success) return SampleResult::Failed;
+    for (std::size_t i = 0; i < 6; ++i) s.joint_deg[i] = pos[i];
+#endif
+
+    BOOL di = FALSE;
+    if (::cr_get_configDigitalIn(handle_, tun.start_di_index, &di) != success) return SampleResult::Failed;
+    s.start_di_index = tun.start_di_index;
+    s.start_di = (di == TRUE);
+    di = FALSE;
+    if (::cr_get_configDigitalIn(handle_, tun.stop_di_index, &di) != success) return SampleResult::Failed;
+    s.stop_di_index = tun.stop_di_index;
+    s.stop_di = (di == TRUE);
+
+    PathRunMsg path{};
+    if (::cr_path_currentRunStatus_get(handle_, &path) != success) return SampleResult::Failed;
+    s.path_run_status = static_cast<int>(path.pathrunstatus);
+
+    state_.store(s);
+    return SampleResult::Ok;
+}
+
+std::optional<ArmStateSample> ArmSdkClient::cached_state() const {
+    const int max_age_ms = tunables().state_max_age_ms;
+    ArmStateSample s;
+    if (max_age_ms > 0 && state_.load(s)) {
+        const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count();
+        if (now_ns - s.ts_ns <= static_cast<std::int64_t>(max_age_ms) * 1000000) {
+            cache_hits_.fetch_add(1, std::memory_order_relaxed);
+            return s;
+        }
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+std::optional<ArmStateSample> ArmSdkClient::precheck_snapshot() const {
+    const int max_age_ms = tunables().precheck_max_age_ms;
+    ArmStateSample s;
+    if (max_age_ms <= 0 || !state_.load(s)) return std::nullopt;
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    // 早于上一次运动结束的样本可能仍显示运动前/运动中的状态，不用于放行。
+    if (s.ts_ns <= motion_done_ns_) return std::nullopt;
+    if (steady_now_ns() - s.ts_ns > static_cast<std::int64_t>(max_age_ms) * 1000000) return std::nullopt;
+    return s;
+}
+
 CRresult ArmSdkClient::fault_reset() {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
     const CRresult cr = ensure_connected();
@@ -838,7 +1108,80 @@ CRresult ArmSdkClient::quick_stop(bool enable) {
     std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
     const CRresult cr = ensure_connected();
     if (cr != success) return cr;
-    return ::cr_set_configDigitalOut(handle_, 1, enable ? FALSE : TRUE);
+    if (enable && motion_in_flight_) motion_interrupted_ = true;
+    const CRresult r = ::cr_set_configDigitalOut(handle_, 1, enable ? FALSE : TRUE);
+    if (enable && stop_peer_) stop_peer_->note_stop_requested();
+    return r;
+}
+
+ArmSdkClient::AsyncMotionScope::AsyncMotionScope(ArmSdkClient& arm) : arm_(arm) {
+    std::lock_guard<std::recursive_mutex> lock(arm_.sdk_mu_);
+    arm_.async_motion_ = true;
+    arm_.motion_started_ = false;
+}
+
+ArmSdkClient::AsyncMotionScope::~AsyncMotionScope() {
+    std::lock_guard<std::recursive_mutex> lock(arm_.sdk_mu_);
+    arm_.async_motion_ = false;
+}
+
+bool ArmSdkClient::AsyncMotionScope::started() const {
+    std::lock_guard<std::recursive_mutex> lock(arm_.sdk_mu_);
+    return arm_.motion_started_;
+}
+
+bool ArmSdkClient::async_motion_enabled() const {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    return async_motion_;
+}
+
+void ArmSdkClient::set_motion_sequence(MotionSequence seq) {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    motion_seq_ = std::move(seq);
+}
+
+std::optional<ArmSdkClient::MotionSequence> ArmSdkClient::take_motion_sequence() {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    std::optional<MotionSequence> out = std::move(motion_seq_);
+    motion_seq_.reset();
+    return out;
+}
+
+bool ArmSdkClient::motion_in_flight() const {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    return motion_in_flight_;
+}
+
+bool ArmSdkClient::motion_interrupted() const {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    return motion_interrupted_ || (motion_in_flight_ && stop_epoch() != motion_stop_epoch_);
+}
+
+CRresult ArmSdkClient::poll_motion(bool& moving) {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    const CRresult cr = ensure_connected();
+    if (cr != success) return cr;
+    BOOL m = FALSE;
+    const CRresult r = ::cr_get_robotMoveStatus(handle_, &m);
+    if (r != success) {
+        disconnect();
+        return r;
+    }
+    moving = (m == TRUE);
+    return success;
+}
+
+CRresult ArmSdkClient::stop_motion() {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    if (!connected_) return CR_FAILED;
+    return ::cr_stop(handle_);
+}
+
+void ArmSdkClient::finish_motion() {
+    std::lock_guard<std::recursive_mutex> lock(sdk_mu_);
+    motion_done_ns_ = steady_now_ns();
+    motion_in_flight_ = false;
+    motion_interrupted_ = false;
 }
 
 CRresult ArmSdkClient::path_download(const std::string& file,
@@ -849,6 +1192,22 @@ CRresult ArmSdkClient::path_download(const std::string& file,
     const CRresult cr = ensure_connected();
     if (cr != success) return cr;
 
+    if (path_cache_) {
+        ArmPathCache::Lease path;
+        CRresult r = path_cache_->acquire(file, max_points, path);
+        if (r != success) {
+            disconnect();
+            return r;
+        }
+        PathDownloadData dl{};
+        dl.pathData = path->data;
+        dl.pathPara.index = index;
+        dl.pathPara.moveType = move_type;
+        r = ::cr_path_download(handle_, dl);
+        if (r != success) disconnect();
+        return r;
+    }
+
     PathData pathData{};
     pathData.pathPoints = new PathPoint[max_points];
 
@@ -1,15 +1,30 @@
 #include "internal/arm_control_loop.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "internal/arm_command_processor.h"
 #include "internal/arm_control_internal.h"
 #include "internal/arm_error_codes.h"
+#include "internal/arm_metrics.h"
+#include "internal/arm_motion_tracker.h"
+#include "internal/arm_priority_lane.h"
+#include "internal/arm_replay_cache.h"
+#include "internal/loop_wakeup.h"
 
 #include "executor.h"
 #include "service_common.h"
 #include "strand.h"
+#include "workstation/arm_wire.h"
+#include "workstation/dto_template.h"
 #include "workstation/node.h"
 
 namespace wxz::workstation::arm_control::internal {
@@ -34,41 +49,588 @@ struct Kv {
     }
 };
 
-} // namespace
+namespace wire = wxz::workstation::arm_control::wire;
 
-ArmControlLoop::ArmControlLoop(wxz::workstation::Node& node,
-                               wxz::core::Executor& exec,
-                               wxz::core::Strand& arm_sdk_strand,
-                               ArmCommandProcessor& processor,
-                               IArmClient& arm,
-                               CmdQueue& queue,
-                               wxz::workstation::EventDtoPublisher& status_pub,
-                               ArmControlTopics topics,
-                               Options opts,
-                               wxz::core::Logger& logger)
-    : node_(node)
-    , exec_(exec)
-    , arm_sdk_strand_(arm_sdk_strand)
-    , processor_(processor)
-    , arm_(arm)
-    , queue_(queue)
-    , status_pub_(status_pub)
-    , topics_(std::move(topics))
-    , opts_(std::move(opts))
-    , logger_(logger) {}
+/// 待发布的 status：v2 指令的结果以 ws.arm_status.v2 编码，其余走 v1 KV。
+struct StatusOut {
+    EventDTOUtil::KvMap kv;
+    bool v2{false};
+    bool replay{false};  // 重发的缓存响应：不再上报故障、不回填缓存
+};
 
-void ArmControlLoop::run(std::chrono::milliseconds pop_timeout) {
-    wxz::core::ChannelQoS qos = wxz::core::default_reliable_qos();
+/// 把 handler 产出的 KV 响应转成 v2 status（数值字段用 from_chars 解析，不走 stod）。
+wire::StatusV2 to_status_v2(const EventDTOUtil::KvMap& kv) {
+    wire::StatusV2 st;
+    auto field = [&](const char* key) -> const std::string* {
+        auto it = kv.find(key);
+        return it == kv.end() ? nullptr : &it->second;
+    };
 
-    // 跨线程移交：
-    // - DDS 回调线程只做轻量入队（请求/结果）。
-    // - 只有本循环会调用 NodeBase / status 发布器。
-    // - SDK 调用在串行的 arm_sdk_strand 上执行。
-    MpscQueue<EventDTOUtil::KvMap> resp_out_q;
-    MpscQueue<wxz::core::FaultStatus> fault_out_q;
-    MpscQueue<EventDTOUtil::KvMap> fault_action_q;
+    if (const auto* ok = field("ok")) st.set(wire::StatusV2::kOk, *ok == "1" || *ok == "true" || *ok == "TRUE");
+    if (const auto* op = field("op")) {
+        if (const auto* desc = ops::find_op(*op)) {
+            st.op = desc->id;
+            st.set(wire::StatusV2::kHasOp);
+        }
+    }
+    if (const auto* id = field("id")) st.id.assign(*id, /*truncate=*/true);
+    if (const auto* err = field("err")) st.err.assign(*err, /*truncate=*/true);
+    if (const auto* s = field("err_code")) st.err_code = parse_int(*s).value_or(0);
+    if (const auto* s = field("code")) {
+        st.code = parse_int(*s).value_or(0);
+        st.set(wire::StatusV2::kHasCode);
+    }
+    if (const auto* s = field("sdk_code")) {
+        st.sdk_code = parse_int(*s).value_or(0);
+        st.set(wire::StatusV2::kHasSdkCode);
+    }
+    if (const auto* d = field("dedup")) st.set(wire::StatusV2::kDedup, *d == "1");
+    if (const auto* v = field("value")) {
+        st.set(wire::StatusV2::kHasValue);
+        st.set(wire::StatusV2::kValue, *v == "1");
+    }
+    const auto* jp = field("jointpos");
+    const auto* jd = field("jointpos_deg");
+    if (jp && jd) {
+        auto rad = parse_csv6(*jp);
+        auto deg = parse_csv6(*jd);
+        if (rad && deg) {
+            st.jointpos = *rad;
+            st.jointpos_deg = *deg;
+            st.set(wire::StatusV2::kHasJoints);
+        }
+    }
+    return st;
+}
+
+/// run() 内各通道共享的主循环资源（只在主循环线程上使用 node 发布故障/状态）。
+struct LoopShared {
+    wxz::workstation::Node& node;
+    ArmCommandProcessor& processor;
+    wxz::core::Logger& logger;
+    LoopWakeup& wakeup;
+    MpscQueue<wxz::core::FaultStatus>& fault_out_q;
+    const ArmControlLoop::Options& opts;
+};
+
+/// 一条 ArmLane 在 run() 期间的运行态：命令派发、非阻塞运动、优先通道、status/state 发布与指标。
+///
+/// 除注明在 sdk_strand 上执行的成员外，其余只在主循环线程上调用。
+class LaneRuntime {
+public:
+    LaneRuntime(const ArmLane& lane, LoopShared& shared)
+        : lane_(lane)
+        , shared_(shared)
+        , scope_(lane.metrics_scope.empty() ? shared.opts.metrics_scope : lane.metrics_scope)
+        , sdk_(dynamic_cast<ArmSdkClient*>(lane.arm))
+        // status 只在本循环线程发布：复用同一个预构建的 DTO（常量字段只写一次，payload 缓冲跨发布复用）。
+        , status_tpl_(*lane.status_pub,
+                      lane.topics.status_dto_topic,
+                      lane.topics.status_dto_schema,
+                      lane.topics.dto_source) {
+        // /arm/state：按固定周期发布后台采样的最新样本（同样只在本循环线程发布）。
+        // 只发布“命令完成之后”采到的新样本，保证订阅端在收到某条 status 后读到的不是该命令执行前的状态。
+        const ArmControlTopics& topics = lane_.topics;
+        if (sdk_ && topics.state_pub_ms > 0 && !topics.state_topic.empty()) {
+            state_pub_ = shared_.node.create_publisher_eventdto(topics.state_topic, topics.dto_max_payload);
+            if (state_pub_) {
+                state_tpl_ = std::make_unique<wxz::workstation::EventDtoTemplate>(
+                    *state_pub_, topics.state_topic, std::string(wire::kStateSchemaV1), topics.dto_source, 128);
+            }
+        }
+        state_period_ = std::chrono::milliseconds(std::max(1, topics.state_pub_ms));
+        next_state_pub_ = std::chrono::steady_clock::now();
+
+        // 运动跟踪：启用非阻塞运动时用于所有运动指令，否则只用于 moveL_stepwise（逐点续发，点间可被停止打断）。
+        if (sdk_) motion_ = std::make_unique<ArmMotionTracker>(*sdk_);
+        if (shared_.opts.replay_cache_max > 0) {
+            replay_ = std::make_unique<ArmReplayCache>(ArmReplayCache::Options{
+                .max_entries = shared_.opts.replay_cache_max,
+                .ttl = shared_.opts.replay_ttl,
+            });
+        }
+    }
+
+    LaneRuntime(const LaneRuntime&) = delete;
+    LaneRuntime& operator=(const LaneRuntime&) = delete;
+
+    const std::string& arm_id() const { return lane_.arm_id; }
+    const std::string& metrics_scope() const { return scope_; }
+
+    /// 故障名：单臂为 arm.<what>，多臂为 arm.<arm_id>.<what>。
+    std::string fault_name(const char* what) const {
+        return lane_.arm_id.empty() ? std::string("arm.") + what : "arm." + lane_.arm_id + "." + what;
+    }
+
+    /// 启动优先通道并订阅该臂的命令 topic。
+    void start(const wxz::core::ChannelQoS& qos) {
+        auto& logger = shared_.logger;
+
+        // 优先通道：与普通队列/arm_sdk_strand 完全分离，响应同样经 resp_out_q 由本循环发布。
+        if (lane_.priority_arm && sdk_) {
+            priority_lane_ = std::make_unique<ArmPriorityLane>(shared_.processor,
+                                                               *lane_.priority_arm,
+                                                               *sdk_,
+                                                               ArmPriorityLane::Options{.metrics_scope = scope_},
+                                                               logger);
+            priority_lane_->start([this](EventDTOUtil::KvMap kv, bool v2) {
+                resp_out_q_.push(StatusOut{std::move(kv), v2});
+                shared_.wakeup.notify();
+            });
+        }
+
+        const ArmControlTopics& topics = lane_.topics;
+        wxz::workstation::EventDtoSubscription::Options cmd_sub_opts;
+        cmd_sub_opts.qos = qos;
+        cmd_sub_opts.dto_max_payload = topics.dto_max_payload;
+        cmd_sub_opts.pool_buffers =
+            Env::get_size("WXZ_CMD_INGRESS_POOL_BUFFERS", std::max<std::size_t>(64, shared_.opts.queue_max * 2));
+        cmd_sub_opts.metrics_scope = scope_;
+
+        // 启用 v2 时按 schema_id 自行筛选（订阅本身不过滤），以便同一 topic 上同时接受 v1/v2。
+        cmd_sub_ = shared_.node.create_subscription_eventdto(
+            topics.cmd_dto_topic,
+            topics.wire_v2 ? std::string{} : topics.cmd_dto_schema,
+            [this](const ::EventDTO& dto) { on_command(dto); },
+            cmd_sub_opts);
+    }
+
+    /// 停止优先通道，并在 sdk_strand 上投递屏障：已排队但未开始的任务直接跳过，
+    /// 正在执行的任务结束后 pending 减一。pending 归零前不得析构本对象（任务引用 this）。
+    void stop(std::atomic<std::size_t>& pending) {
+        if (priority_lane_) priority_lane_->stop();
+        stopping_.store(true);
+        pending.fetch_add(1);
+        if (!lane_.sdk_strand->post([&pending] { pending.fetch_sub(1); })) pending.fetch_sub(1);
+    }
+
+    /// 把队列中的指令投递到该臂的 sdk_strand，strand 上未执行完的指令不超过 strand_in_flight_max 条。
+    ///
+    /// 其余指令留在 CmdQueue 中，使 WXZ_ARM_QUEUE_MAX/queue_full 仍对积压生效（strand 队列本身不设上限）；
+    /// 指令执行完（或转入运动等待队列）时释放名额并唤醒主循环继续派发。
+    std::size_t dispatch_cmds() {
+        const std::size_t cap = std::max<std::size_t>(1, shared_.opts.strand_in_flight_max);
+        std::size_t n = 0;
+        while (strand_in_flight_.load(std::memory_order_acquire) < cap) {
+            auto cmd_opt = lane_.queue->try_pop();
+            if (!cmd_opt) break;
+            ++n;
+            std::string replay_id;
+            if (replay_ && !admit_cmd(*cmd_opt, replay_id)) continue;
+            strand_in_flight_.fetch_add(1, std::memory_order_acq_rel);
+            const bool queued = lane_.sdk_strand->post([this, cmd = std::move(*cmd_opt)]() mutable {
+                execute_cmd(std::move(cmd));
+                strand_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+                shared_.wakeup.notify();
+            });
+            if (!queued) {
+                strand_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+                if (!replay_id.empty()) replay_->forget(replay_id);
+                shared_.logger.log(LogLevel::Warn, log_prefix() + "cmd dropped: arm_sdk_strand rejected task");
+                resp_out_q_.push(StatusOut{{
+                    {"ok", "0"},
+                    {"err", "executor_rejected"},
+                    {"code", std::to_string(static_cast<int>(ArmErrc::InvalidArgs))},
+                    {"err_code", std::to_string(static_cast<int>(ArmErrc::InvalidArgs))},
+                }, cmd_opt->v2});
+            }
+        }
+        return n;
+    }
+
+    std::size_t drain_resp_out() {
+        return resp_out_q_.drain([&](StatusOut&& out) {
+            if (!out.replay) {
+                maybe_publish_fault_from_resp(out.kv);
+                if (replay_) {
+                    if (auto it = out.kv.find("id"); it != out.kv.end()) {
+                        replay_->complete(it->second, out.kv, std::chrono::steady_clock::now());
+                    }
+                }
+            }
+            // 启用重复指令判定时在每条 status 中声明，bt_service 据此才会以同一 id 重发有副作用的指令。
+            if (replay_) out.kv["dedup"] = "1";
+            publish_status(out);
+        });
+    }
+
+    /// fault/action reset：在该臂的 sdk_strand 上执行 fault_reset，结果经 fault_out_q 发布。
+    void post_fault_reset(EventDTOUtil::KvMap req) {
+        const bool queued = lane_.sdk_strand->post([
+            this,
+            req = std::move(req)
+        ]() mutable {
+            if (stopping_.load()) return;
+            auto& logger = shared_.logger;
+            const auto r = lane_.arm->fault_reset();
+
+            wxz::core::FaultStatus st;
+            st.fault = req.count("fault") ? req["fault"] : fault_name("fault");
+            if (r == 0) {
+                st.active = false;
+                st.severity = "info";
+                st.err_code = 0;
+                st.err = "fault_reset_ok";
+                logger.log(LogLevel::Info, log_prefix() + "fault_reset ok");
+            } else {
+                st.active = true;
+                st.severity = "error";
+                st.err_code = static_cast<int>(r);
+                st.err = "fault_reset_failed";
+                logger.log(LogLevel::Warn, log_prefix() + "fault_reset failed code=" + std::to_string(static_cast<int>(r)));
+            }
+            shared_.fault_out_q.push(std::move(st));
+            shared_.wakeup.notify();
+        });
+
+        if (!queued) {
+            shared_.logger.log(LogLevel::Warn, log_prefix() + "fault_reset dropped: arm_sdk_strand rejected task");
+        }
+    }
+
+    void maybe_poll_motion() {
+        const std::int64_t due = motion_poll_ns_.load(std::memory_order_acquire);
+        if (due == 0 || steady_ns() < due || motion_poll_posted_.exchange(true)) return;
+        if (!lane_.sdk_strand->post([this] { poll_motion(); })) {
+            motion_poll_posted_.store(false);
+            shared_.logger.log(LogLevel::Warn, log_prefix() + "motion poll dropped: arm_sdk_strand rejected task");
+        }
+    }
+
+    void maybe_publish_state() {
+        if (!state_tpl_) return;
+        const auto now = std::chrono::steady_clock::now();
+        if (now < next_state_pub_) return;
+        next_state_pub_ += state_period_;
+        if (next_state_pub_ < now) next_state_pub_ = now + state_period_;
+
+        ArmStateSample s;
+        if (!sdk_->latest_state(s)) return;
+        if (s.ts_ns == last_state_ts_ns_ || s.ts_ns <= last_cmd_done_ns_.load(std::memory_order_acquire)) return;
+        last_state_ts_ns_ = s.ts_ns;
+
+        constexpr double kPi = 3.14159265358979323846;
+        wire::StateV1 st;
+        st.seq = ++state_seq_;
+        const std::int64_t age_ms = (steady_ns() - s.ts_ns) / 1000000;
+        st.ts_ms = wxz::core::now_epoch_ms() - static_cast<std::uint64_t>(std::max<std::int64_t>(0, age_ms));
+        st.mode = s.mode;
+        st.control_mode = s.control_mode;
+        st.speed_percent = s.speed_percent;
+        st.path_run_status = s.path_run_status;
+        for (std::size_t i = 0; i < 6; ++i) st.jointpos[i] = s.joint_deg[i] * kPi / 180.0;
+        st.set(wire::StateV1::kMoving, s.moving);
+        st.set(wire::StateV1::kReady, robot_mode_is_ready(s.mode));
+        st.set(wire::StateV1::kPowered, robot_mode_is_powered(s.mode));
+        st.set(wire::StateV1::kStartDi, s.start_di);
+        st.set(wire::StateV1::kStopDi, s.stop_di);
+        st.set(wire::StateV1::kPathRunning, s.path_run_status == 1);
+
+        wire::encode(st, state_tpl_->begin());
+        (void)state_tpl_->publish({});
+    }
+
+    /// 空闲等待的上限：不超过该臂下一次 /arm/state 发布或运动轮询时刻。
+    void clamp_idle_wait(std::chrono::milliseconds& wait) const {
+        auto clamp_wait_until = [&](std::chrono::steady_clock::time_point t) {
+            const auto until = std::chrono::ceil<std::chrono::milliseconds>(t - std::chrono::steady_clock::now());
+            wait = std::clamp(until, std::chrono::milliseconds(0), wait);
+        };
+        if (state_tpl_) clamp_wait_until(next_state_pub_);
+        if (const std::int64_t due = motion_poll_ns_.load(std::memory_order_acquire); due != 0) {
+            clamp_wait_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(due)));
+        }
+    }
+
+    /// 周期汇总上报该臂的移交队列、发布与非阻塞运动指标。
+    void report_metrics(const std::function<void(const char*, std::size_t, const MpscDrainStats&, MpscDrainStats&,
+                                                 const std::string&)>& report_queue) {
+        report_queue("resp_out_q", resp_out_q_.size(), resp_out_q_.drain_stats(), resp_out_reported_, scope_);
+        status_tpl_.report_metrics("wxz.arm.status_pub", scope_);
+        if (state_tpl_) state_tpl_->report_metrics("wxz.arm.state_pub", scope_);
+        if (motion_) {
+            auto add = [&](const char* name, const std::atomic<std::uint64_t>& cur, std::uint64_t& prev) {
+                const std::uint64_t v = cur.load(std::memory_order_relaxed);
+                if (v > prev) ArmMetrics::counter_add(name, static_cast<double>(v - prev), scope_);
+                prev = v;
+            };
+            add("wxz.arm.motion.started_total", motion_counters_.started, motion_reported_.started);
+            add("wxz.arm.motion.completed_total", motion_counters_.completed, motion_reported_.completed);
+            add("wxz.arm.motion.failed_total", motion_counters_.failed, motion_reported_.failed);
+            add("wxz.arm.motion.deferred_total", motion_counters_.deferred, motion_reported_.deferred);
+            add("wxz.arm.motion.deferred_rejected_total", motion_counters_.deferred_rejected,
+                motion_reported_.deferred_rejected);
+            ArmMetrics::gauge_set("wxz.arm.motion.in_flight", motion_poll_ns_.load() != 0 ? 1.0 : 0.0, scope_);
+        }
+        if (replay_) {
+            auto add = [&](const char* name, std::uint64_t cur, std::uint64_t& prev) {
+                if (cur > prev) ArmMetrics::counter_add(name, static_cast<double>(cur - prev), scope_);
+                prev = cur;
+            };
+            const auto& st = replay_->stats();
+            add("wxz.arm.replay.replayed_total", st.replayed, replay_reported_.replayed);
+            add("wxz.arm.replay.attached_total", st.attached, replay_reported_.attached);
+            add("wxz.arm.replay.evicted_in_flight_total", st.evicted_in_flight, replay_reported_.evicted_in_flight);
+            ArmMetrics::gauge_set("wxz.arm.replay.entries", static_cast<double>(replay_->size()), scope_);
+        }
+    }
+
+private:
+    static std::int64_t steady_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static std::int64_t to_ns(std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    std::string log_prefix() const { return lane_.arm_id.empty() ? std::string{} : "[" + lane_.arm_id + "] "; }
+
+    // DDS 回调线程：只做轻量入队。
+    void on_command(const ::EventDTO& dto) {
+        const ArmControlTopics& topics = lane_.topics;
+        auto& logger = shared_.logger;
+        const bool v2 = topics.wire_v2 && dto.schema_id == wire::kCmdSchemaV2;
+        if (topics.wire_v2 && !v2 && dto.schema_id != topics.cmd_dto_schema) {
+            logger.log(LogLevel::Warn, log_prefix() + "drop cmd: unexpected schema_id='" + dto.schema_id + "'");
+            return;
+        }
+        Cmd cmd{dto.payload, v2, steady_ns()};
+        if (priority_lane_) {
+            const ops::OpDesc* desc = shared_.processor.peek_op(cmd.raw, v2);
+            if (desc && ops::op_is_priority(desc->id)) {
+                if (!priority_lane_->submit(std::move(cmd))) {
+                    logger.log(LogLevel::Warn, log_prefix() + "priority queue full, drop cmd");
+                    reject_queue_full(v2, "priority_queue_full");
+                    shared_.wakeup.notify();
+                }
+                return;
+            }
+        }
+        if (!lane_.queue->push(std::move(cmd))) {
+            logger.log(LogLevel::Warn, log_prefix() + "queue full, drop cmd");
+            reject_queue_full(v2, "queue_full");
+        }
+        shared_.wakeup.notify();
+    }
+
+    // 重复指令判定（主循环线程）：返回 false 表示不执行——已完成的 id 直接重发缓存的 status，
+    // 仍在途的 id 等待进行中的执行回复。需要执行时 id 为登记的键（投递失败时据此撤销登记）。
+    bool admit_cmd(const Cmd& cmd, std::string& id) {
+        std::string op;
+        if (!shared_.processor.peek_key(cmd.raw, cmd.v2, id, op)) {
+            id.clear();
+            return true;  // 无 id 的指令不参与判定
+        }
+        // 急停/停止/复位始终执行（与是否启用优先通道无关）。
+        if (const ops::OpDesc* desc = ops::find_op(op); desc && ops::op_is_priority(desc->id)) {
+            id.clear();
+            return true;
+        }
+        const EventDTOUtil::KvMap* cached = nullptr;
+        switch (replay_->admit(id, op, std::chrono::steady_clock::now(), cached)) {
+            case ArmReplayCache::Verdict::Execute:
+                return true;
+            case ArmReplayCache::Verdict::Replay:
+                shared_.logger.log(LogLevel::Info, log_prefix() + "duplicate cmd id=" + id + " op=" + op + ": replay status");
+                resp_out_q_.push(StatusOut{*cached, cmd.v2, /*replay=*/true});
+                return false;
+            case ArmReplayCache::Verdict::Attached:
+                shared_.logger.log(LogLevel::Info, log_prefix() + "duplicate cmd id=" + id + " op=" + op + ": still in flight");
+                return false;
+        }
+        return true;
+    }
+
+    void reject_queue_full(bool v2, const char* fault) {
+        resp_out_q_.push(StatusOut{{
+            {"ok", "0"},
+            {"code", std::to_string(static_cast<int>(ArmErrc::QueueFull))},
+            {"err", "queue_full"},
+            {"err_code", std::to_string(static_cast<int>(ArmErrc::QueueFull))},
+        }, v2});
+
+        wxz::core::FaultStatus st;
+        st.fault = fault_name(fault);
+        st.active = true;
+        st.severity = "warn";
+        st.err_code = static_cast<int>(ArmErrc::QueueFull);
+        st.err = "queue_full";
+        shared_.fault_out_q.push(std::move(st));
+    }
+
+    // 从订阅回调收到到开始在 arm_sdk_strand 上执行的耗时：比较不同执行线程布局的尾延迟（p99 等）用。
+    // 指令频率低（每秒至多数十条），逐条上报即可。
+    void observe_dispatch(const Cmd& cmd) {
+        if (cmd.rx_ns == 0) return;
+        ArmMetrics::observe("wxz.arm.cmd.dispatch_ms", static_cast<double>(steady_ns() - cmd.rx_ns) / 1e6, scope_);
+    }
+
+    // 在 arm_sdk_strand 上执行一条指令；启用非阻塞运动时，启动了运动的指令在完成后才回复。
+    void execute_cmd(Cmd cmd) {
+        if (stopping_.load()) return;
+        auto& processor = shared_.processor;
+        auto& logger = shared_.logger;
+        IArmClient& arm = *lane_.arm;
+        StatusOut out;
+        out.v2 = cmd.v2;
+        if (motion_) {
+            const bool async_all = shared_.opts.async_motion;
+            const ops::OpDesc* desc = (motion_->active() || !async_all) ? processor.peek_op(cmd.raw, cmd.v2) : nullptr;
+            if (motion_->active()) {
+                if (desc && ops::op_moves_arm(desc->id)) {
+                    // 等待队列与 CmdQueue 同样以 queue_max 为上限，超出时按 queue_full 拒绝。
+                    if (motion_deferred_.size() >= shared_.opts.queue_max) {
+                        motion_counters_.deferred_rejected.fetch_add(1, std::memory_order_relaxed);
+                        resp_out_q_.push(StatusOut{
+                            processor.reject_command(cmd.raw, cmd.v2, ArmErrc::QueueFull, "queue_full"), cmd.v2});
+                        shared_.wakeup.notify();
+                        return;
+                    }
+                    motion_deferred_.push_back(std::move(cmd));
+                    motion_counters_.deferred.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            if (async_all || (desc && desc->id == ops::ArmOp::MoveLStepwise)) {
+                observe_dispatch(cmd);
+                bool started = false;
+                {
+                    ArmSdkClient::AsyncMotionScope scope(*sdk_);
+                    out.kv = cmd.v2 ? processor.handle_v2_command(cmd.raw, arm, logger)
+                                    : processor.handle_raw_command(cmd.raw, arm, logger);
+                    started = scope.started();
+                }
+                motion_seq_ = sdk_->take_motion_sequence();
+                if (!started && motion_seq_) {
+                    // 首段未进入运动（如仿真）：立即续发后续段，直到某段开始运动或全部下发完。
+                    CRresult r = success;
+                    started = advance_sequence(r);
+                    if (!started) finish_sequence(out, r);
+                }
+                if (started) {
+                    motion_->begin(std::chrono::steady_clock::now());
+                    motion_reply_ = std::move(out);
+                    motion_counters_.started.fetch_add(1, std::memory_order_relaxed);
+                    motion_poll_ns_.store(to_ns(motion_->next_poll()), std::memory_order_release);
+                    shared_.wakeup.notify();
+                    return;
+                }
+            } else {
+                observe_dispatch(cmd);
+                out.kv = cmd.v2 ? processor.handle_v2_command(cmd.raw, arm, logger)
+                                : processor.handle_raw_command(cmd.raw, arm, logger);
+            }
+        } else {
+            observe_dispatch(cmd);
+            out.kv = cmd.v2 ? processor.handle_v2_command(cmd.raw, arm, logger)
+                            : processor.handle_raw_command(cmd.raw, arm, logger);
+        }
+        last_cmd_done_ns_.store(steady_ns(), std::memory_order_release);
+        resp_out_q_.push(std::move(out));
+        shared_.wakeup.notify();
+    }
 
-    auto maybe_publish_fault_from_resp = [&](const EventDTOUtil::KvMap& resp) {
+    // 在 arm_sdk_strand 上推进一次运动跟踪；结束时回复被挂起的 status，并按序执行运动期间排队的运动指令。
+    void poll_motion() {
+        if (stopping_.load()) return;
+        const auto now = std::chrono::steady_clock::now();
+        const auto r = motion_->poll(now);
+        if (!r) {
+            motion_poll_ns_.store(to_ns(motion_->next_poll()), std::memory_order_release);
+            motion_poll_posted_.store(false);
+            shared_.wakeup.notify();
+            return;
+        }
+
+        const auto why = motion_->last_end();
+        const bool interrupted =
+            why == ArmMotionTracker::End::Interrupted || why == ArmMotionTracker::End::StopSignal;
+
+        // 逐点运动：上一段正常结束后续发下一段，整批结束（或失败/被打断）才回复。
+        CRresult result = *r;
+        if (motion_seq_ && result == success && !interrupted) {
+            if (advance_sequence(result)) {
+                motion_->begin(now);
+                motion_poll_ns_.store(to_ns(motion_->next_poll()), std::memory_order_release);
+                motion_poll_posted_.store(false);
+                shared_.wakeup.notify();
+                return;
+            }
+        }
+
+        StatusOut out = std::move(motion_reply_);
+        if (motion_seq_) {
+            finish_sequence(out, result, interrupted);
+        } else {
+            arm_set_sdk_result(out.kv, static_cast<int>(result));
+        }
+        if (interrupted) arm_set_error(out.kv, ArmErrc::MotionInterrupted, "motion_interrupted");
+        if (result == success) {
+            motion_counters_.completed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            motion_counters_.failed.fetch_add(1, std::memory_order_relaxed);
+            shared_.logger.log(LogLevel::Warn,
+                               log_prefix() + "motion failed op=" + Kv::get(out.kv, "op") +
+                                   " end=" + motion_end_name(why) + " code=" + std::to_string(static_cast<int>(result)));
+        }
+        // 每次运动只上报一次（秒级事件），不必经由周期汇总。
+        ArmMetrics::observe("wxz.arm.motion.duration_ms",
+                            static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                    now - motion_->started_at())
+                                                    .count()),
+                            scope_);
+        ArmMetrics::observe("wxz.arm.wait.motion_async.lag_ms",
+                            static_cast<double>(motion_->last_poll_period().count()),
+                            scope_);
+        last_cmd_done_ns_.store(steady_ns(), std::memory_order_release);
+        resp_out_q_.push(std::move(out));
+
+        motion_poll_ns_.store(0, std::memory_order_release);
+        motion_poll_posted_.store(false);
+
+        // 被打断时排队的运动指令一律拒绝，避免急停后继续执行；否则按到达顺序执行（可能再次启动运动）。
+        while (!motion_deferred_.empty() && !motion_->active()) {
+            Cmd next = std::move(motion_deferred_.front());
+            motion_deferred_.pop_front();
+            if (interrupted) {
+                resp_out_q_.push(StatusOut{
+                    shared_.processor.reject_command(next.raw, next.v2, ArmErrc::MotionInterrupted, "motion_interrupted"),
+                    next.v2});
+                continue;
+            }
+            execute_cmd(std::move(next));
+        }
+        shared_.wakeup.notify();
+    }
+
+    // 逐点运动：下发下一段（必要时连续下发多段，直到某段开始运动）。返回 true 表示有一段正在运动；
+    // 返回 false 时 r 为首个失败的结果码，全部下发完毕则为 success。
+    bool advance_sequence(CRresult& r) {
+        auto& seq = *motion_seq_;
+        r = success;
+        while (seq.issued < seq.total) {
+            ArmSdkClient::AsyncMotionScope scope(*sdk_);
+            r = seq.issue(seq.issued);
+            if (r != success) return false;
+            ++seq.issued;
+            if (scope.started()) return true;
+        }
+        return false;
+    }
+
+    // 逐点运动结束：写入结果码与已完成的点数（失败/被打断时不计最后下发的一段），并清除续发信息。
+    void finish_sequence(StatusOut& out, CRresult r, bool interrupted = false) {
+        const auto& seq = *motion_seq_;
+        const std::size_t done = (r == success && !interrupted) ? seq.issued : (seq.issued > 0 ? seq.issued - 1 : 0);
+        out.kv["done"] = std::to_string(done);
+        arm_set_sdk_result(out.kv, static_cast<int>(r));
+        motion_seq_.reset();
+    }
+
+    void maybe_publish_fault_from_resp(const EventDTOUtil::KvMap& resp) {
         // 优先使用新字段：ok/err_code/err；同时兼容历史字段 ok/code。
         const std::string ok_s = Kv::get(resp, "ok");
         const int err_code = Kv::get_int(resp, "err_code", 0);
@@ -81,7 +643,7 @@ void ArmControlLoop::run(std::chrono::milliseconds pop_timeout) {
         }
         if (!ok || err_code != 0) {
             wxz::core::FaultStatus st;
-            st.fault = "arm.command";
+            st.fault = fault_name("command");
             st.active = true;
             st.severity = "error";
             st.err_code = err_code != 0 ? err_code : Kv::get_int(resp, "code", 1);
@@ -90,76 +652,164 @@ void ArmControlLoop::run(std::chrono::milliseconds pop_timeout) {
                 if (!st.err.empty()) st.err += " ";
                 st.err += "(sdk_code=" + sdk_code + ")";
             }
-            if (!node_.base().publish_fault(std::move(st))) {
-                logger_.log(LogLevel::Warn, "fault publish skipped (fault_topic not configured)");
+            if (!shared_.node.base().publish_fault(std::move(st))) {
+                shared_.logger.log(LogLevel::Warn, "fault publish skipped (fault_topic not configured)");
             }
         }
-    };
+    }
 
-    auto publish_status_kv = [&](const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = topics_.status_dto_schema;
-        dto.topic = topics_.status_dto_topic;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, topics_.dto_source);
-        if (auto it = kv.find("id"); it != kv.end() && !it->second.empty()) {
-            dto.event_id = it->second;
+    void publish_status(const StatusOut& out) {
+        const EventDTOUtil::KvMap& kv = out.kv;
+        if (out.v2) {
+            wire::encode(to_status_v2(kv), status_tpl_.begin(wire::kStatusSchemaV2));
+        } else {
+            status_tpl_.begin();
+            status_tpl_.write_kv(kv);
         }
-        if (!status_pub_.publish(dto)) {
-            logger_.log(LogLevel::Warn, "status publish failed");
+        std::string_view event_id;
+        if (auto it = kv.find("id"); it != kv.end()) event_id = it->second;
+        if (!status_tpl_.publish(event_id)) {
+            shared_.logger.log(LogLevel::Warn, log_prefix() + "status publish failed");
         }
-    };
+    }
 
-    wxz::workstation::EventDtoSubscription::Options cmd_sub_opts;
-    cmd_sub_opts.qos = qos;
-    cmd_sub_opts.dto_max_payload = topics_.dto_max_payload;
-    cmd_sub_opts.pool_buffers = Env::get_size("WXZ_CMD_INGRESS_POOL_BUFFERS", std::max<std::size_t>(64, opts_.queue_max * 2));
-    cmd_sub_opts.metrics_scope = opts_.metrics_scope;
-
-    auto cmd_sub = node_.create_subscription_eventdto(
-        topics_.cmd_dto_topic,
-        topics_.cmd_dto_schema,
-        [&](const ::EventDTO& dto) {
-            if (!queue_.push(Cmd{dto.payload})) {
-                logger_.log(LogLevel::Warn, "queue full, drop cmd");
-                resp_out_q.push({
-                    {"ok", "0"},
-                    {"code", std::to_string(static_cast<int>(ArmErrc::QueueFull))},
-                    {"err", "queue_full"},
-                    {"err_code", std::to_string(static_cast<int>(ArmErrc::QueueFull))},
-                });
+    const ArmLane& lane_;
+    LoopShared& shared_;
+    const std::string scope_;
+    ArmSdkClient* const sdk_;
+
+    MpscQueue<StatusOut> resp_out_q_;
+    MpscDrainStats resp_out_reported_;
+    wxz::workstation::EventDtoTemplate status_tpl_;
+
+    std::unique_ptr<wxz::workstation::EventDtoPublisher> state_pub_;
+    std::unique_ptr<wxz::workstation::EventDtoTemplate> state_tpl_;
+    std::chrono::milliseconds state_period_{100};
+    std::chrono::steady_clock::time_point next_state_pub_;
+    std::atomic<std::int64_t> last_cmd_done_ns_{0};
+    std::int64_t last_state_ts_ns_{0};
+    std::uint64_t state_seq_{0};
+
+    // 非阻塞运动（Options::async_motion 与 moveL_stepwise）。motion_/motion_reply_/motion_seq_/motion_deferred_ 只在 arm_sdk_strand 上访问；
+    // 主循环只读 motion_poll_ns_ 决定何时向 strand 投递下一次轮询。
+    std::unique_ptr<ArmMotionTracker> motion_;
+    StatusOut motion_reply_;
+    std::optional<ArmSdkClient::MotionSequence> motion_seq_;  // 进行中的 moveL_stepwise 的续发信息
+    std::deque<Cmd> motion_deferred_;
+    std::atomic<std::int64_t> motion_poll_ns_{0};  // 下一次轮询时刻（steady ns），0 表示没有进行中的运动
+    std::atomic<bool> motion_poll_posted_{false};
+
+    struct MotionCounters {
+        std::atomic<std::uint64_t> started{0};
+        std::atomic<std::uint64_t> completed{0};
+        std::atomic<std::uint64_t> failed{0};
+        std::atomic<std::uint64_t> deferred{0};
+        std::atomic<std::uint64_t> deferred_rejected{0};
+    } motion_counters_;
+
+    struct {
+        std::uint64_t started{0};
+        std::uint64_t completed{0};
+        std::uint64_t failed{0};
+        std::uint64_t deferred{0};
+        std::uint64_t deferred_rejected{0};
+    } motion_reported_;
+
+    // 重复指令判定（Options::replay_cache_max > 0）；只在主循环线程上访问。
+    std::unique_ptr<ArmReplayCache> replay_;
+    ArmReplayCache::Stats replay_reported_;
+
+    // 已投递到 sdk_strand、尚未执行完的指令数（dispatch_cmds 据此限流）。
+    std::atomic<std::size_t> strand_in_flight_{0};
+
+    std::atomic<bool> stopping_{false};
+    std::unique_ptr<ArmPriorityLane> priority_lane_;
+    std::unique_ptr<wxz::workstation::EventDtoSubscription> cmd_sub_;
+};
 
-                wxz::core::FaultStatus st;
-                st.fault = "arm.queue_full";
-                st.active = true;
-                st.severity = "warn";
-                st.err_code = static_cast<int>(ArmErrc::QueueFull);
-                st.err = "queue_full";
-                fault_out_q.push(std::move(st));
-            }
-        },
-        cmd_sub_opts);
+} // namespace
+
+ArmControlLoop::ArmControlLoop(wxz::workstation::Node& node,
+                               wxz::core::Executor& exec,
+                               wxz::core::Strand& arm_sdk_strand,
+                               ArmCommandProcessor& processor,
+                               IArmClient& arm,
+                               CmdQueue& queue,
+                               wxz::workstation::EventDtoPublisher& status_pub,
+                               ArmControlTopics topics,
+                               Options opts,
+                               wxz::core::Logger& logger)
+    : ArmControlLoop(node,
+                     exec,
+                     processor,
+                     {ArmLane{
+                         .arm = &arm,
+                         .queue = &queue,
+                         .sdk_strand = &arm_sdk_strand,
+                         .status_pub = &status_pub,
+                         .topics = std::move(topics),
+                         .priority_arm = opts.priority_arm,
+                     }},
+                     opts,
+                     logger) {}
+
+ArmControlLoop::ArmControlLoop(wxz::workstation::Node& node,
+                               wxz::core::Executor& exec,
+                               ArmCommandProcessor& processor,
+                               std::vector<ArmLane> lanes,
+                               Options opts,
+                               wxz::core::Logger& logger)
+    : node_(node)
+    , exec_(exec)
+    , processor_(processor)
+    , lanes_(std::move(lanes))
+    , opts_(std::move(opts))
+    , logger_(logger) {}
+
+void ArmControlLoop::run(std::chrono::milliseconds idle_wait) {
+    if (lanes_.empty()) return;
+
+    wxz::core::ChannelQoS qos = wxz::core::default_reliable_qos();
+
+    LoopWakeup wakeup(exec_);
+
+    // 跨线程移交：
+    // - DDS 回调线程只做轻量入队（请求/结果）。
+    // - 只有本循环会调用 NodeBase / status 发布器。
+    // - SDK 调用在各臂串行的 arm_sdk_strand 上执行。
+    MpscQueue<wxz::core::FaultStatus> fault_out_q;
+    MpscQueue<std::pair<std::size_t, EventDTOUtil::KvMap>> fault_action_q;  // (通道下标, 请求)
+
+    LoopShared shared{node_, processor_, logger_, wakeup, fault_out_q, opts_};
+    std::vector<std::unique_ptr<LaneRuntime>> lanes;
+    lanes.reserve(lanes_.size());
+    for (const auto& lane : lanes_) lanes.push_back(std::make_unique<LaneRuntime>(lane, shared));
+    for (auto& lane : lanes) lane->start(qos);
 
     wxz::workstation::TextSubscription::Options fault_action_opts;
     fault_action_opts.qos = qos;
     fault_action_opts.max_payload = 2048;
     fault_action_opts.metrics_scope = opts_.metrics_scope;
 
+    // target 为服务 scope 时作用于所有臂；为某臂的 scope 时只作用于该臂。
     auto fault_action_sub = node_.create_subscription_text(
-        topics_.fault_action_topic,
+        lanes_.front().topics.fault_action_topic,
         [&](std::string raw) {
             auto kv = EventDTOUtil::parsePayloadKv(raw);
 
             const std::string target = kv["target"];
             const std::string action = kv["action"];
-            if (target != opts_.metrics_scope) return;
+            if (action != "reset") return;
 
-            if (action == "reset") {
-                logger_.log(LogLevel::Info, "fault/action reset received");
-
-                // 主循环线程会发布 ack，并把 SDK 工作投递到 arm_sdk_strand。
-                fault_action_q.push(std::move(kv));
+            bool matched = false;
+            for (std::size_t i = 0; i < lanes.size(); ++i) {
+                if (target != opts_.metrics_scope && target != lanes[i]->metrics_scope()) continue;
+                matched = true;
+                fault_action_q.push({i, kv});
+            }
+            if (matched) {
+                logger_.log(LogLevel::Info, "fault/action reset received target='" + target + "'");
+                wakeup.notify();
             }
         },
         fault_action_opts);
@@ -167,27 +817,25 @@ void ArmControlLoop::run(std::chrono::milliseconds pop_timeout) {
     (void)fault_action_sub;
 
     auto drain_fault_out = [&] {
-        wxz::core::FaultStatus st;
-        while (fault_out_q.try_pop(st)) {
+        return fault_out_q.drain([&](wxz::core::FaultStatus&& st) {
             if (!node_.base().publish_fault(std::move(st))) {
                 logger_.log(LogLevel::Warn, "fault publish skipped (fault_topic not configured)");
             }
-        }
+        });
     };
 
     auto drain_resp_out = [&] {
-        EventDTOUtil::KvMap resp;
-        while (resp_out_q.try_pop(resp)) {
-            maybe_publish_fault_from_resp(resp);
-            publish_status_kv(resp);
-        }
+        std::size_t n = 0;
+        for (auto& lane : lanes) n += lane->drain_resp_out();
+        return n;
     };
 
+    // 主循环线程会发布 ack，并把 SDK 工作投递到对应臂的 arm_sdk_strand。
     auto handle_fault_actions = [&] {
-        EventDTOUtil::KvMap req;
-        while (fault_action_q.try_pop(req)) {
+        return fault_action_q.drain([&](std::pair<std::size_t, EventDTOUtil::KvMap>&& item) {
+            auto& lane = *lanes[item.first];
             wxz::core::FaultStatus ack;
-            ack.fault = "arm.fault_reset";
+            ack.fault = lane.fault_name("fault_reset");
             ack.active = false;
             ack.severity = "info";
             ack.err_code = 0;
@@ -195,83 +843,93 @@ void ArmControlLoop::run(std::chrono::milliseconds pop_timeout) {
             if (!node_.base().publish_fault(ack)) {
                 logger_.log(LogLevel::Warn, "fault/status ack publish failed");
             }
+            lane.post_fault_reset(std::move(item.second));
+        });
+    };
 
-            const bool queued = arm_sdk_strand_.post([
-                &arm = arm_,
-                &logger = logger_,
-                &fault_out_q,
-                req = std::move(req)
-            ]() mutable {
-                const auto r = arm.fault_reset();
-
-                wxz::core::FaultStatus st;
-                st.fault = req.count("fault") ? req["fault"] : std::string("arm.fault");
-                if (r == 0) {
-                    st.active = false;
-                    st.severity = "info";
-                    st.err_code = 0;
-                    st.err = "fault_reset_ok";
-                    logger.log(LogLevel::Info, "fault_reset ok");
-                } else {
-                    st.active = true;
-                    st.severity = "error";
-                    st.err_code = static_cast<int>(r);
-                    st.err = "fault_reset_failed";
-                    logger.log(LogLevel::Warn, "fault_reset failed code=" + std::to_string(static_cast<int>(r)));
-                }
-                fault_out_q.push(std::move(st));
-            });
-
-            if (!queued) {
-                logger_.log(LogLevel::Warn, "fault_reset dropped: arm_sdk_strand rejected task");
-            }
-        }
+    auto dispatch_cmds = [&] {
+        std::size_t n = 0;
+        for (auto& lane : lanes) n += lane->dispatch_cmds();
+        return n;
     };
 
-    auto dispatch_one_cmd = [&] {
-        if (auto cmd_opt = queue_.try_pop(); cmd_opt) {
-            const bool queued = arm_sdk_strand_.post([
-                &processor = processor_,
-                &arm = arm_,
-                &logger = logger_,
-                &resp_out_q,
-                cmd_raw = std::move(cmd_opt->raw)
-            ]() mutable {
-                EventDTOUtil::KvMap resp = processor.handle_raw_command(cmd_raw, arm, logger);
-                resp_out_q.push(std::move(resp));
-            });
-            if (!queued) {
-                logger_.log(LogLevel::Warn, "cmd dropped: arm_sdk_strand rejected task");
-                resp_out_q.push({
-                    {"ok", "0"},
-                    {"err", "executor_rejected"},
-                    {"code", std::to_string(static_cast<int>(ArmErrc::InvalidArgs))},
-                    {"err_code", std::to_string(static_cast<int>(ArmErrc::InvalidArgs))},
-                });
-            }
+    // 各移交队列的 drain 批量统计：主循环按周期汇总上报（counter 取增量）。
+    MpscDrainStats fault_out_reported;
+    MpscDrainStats fault_action_reported;
+    auto report_queue = [](const char* queue,
+                           std::size_t pending,
+                           const MpscDrainStats& st,
+                           MpscDrainStats& reported,
+                           const std::string& scope) {
+        const std::string prefix = std::string("wxz.arm.") + queue;
+        ArmMetrics::gauge_set(prefix + ".pending", static_cast<double>(pending), scope);
+        ArmMetrics::gauge_set(prefix + ".drain_batch_last", static_cast<double>(st.last_batch), scope);
+        ArmMetrics::gauge_set(prefix + ".drain_batch_max", static_cast<double>(st.max_batch), scope);
+        if (st.drains > reported.drains) {
+            const auto drains = st.drains - reported.drains;
+            const auto items = st.items - reported.items;
+            ArmMetrics::counter_add(prefix + ".drains_total", static_cast<double>(drains), scope);
+            ArmMetrics::counter_add(prefix + ".items_total", static_cast<double>(items), scope);
+            ArmMetrics::observe(prefix + ".drain_batch_avg", static_cast<double>(items) / static_cast<double>(drains),
+                                scope);
         }
+        reported = st;
     };
 
-    (void)cmd_sub;
+    constexpr auto kMetricsPeriod = std::chrono::seconds(1);
+    auto next_metrics_report = std::chrono::steady_clock::now() + kMetricsPeriod;
+    auto maybe_report_metrics = [&] {
+        const auto now = std::chrono::steady_clock::now();
+        if (now < next_metrics_report) return;
+        next_metrics_report = now + kMetricsPeriod;
+        report_queue("fault_out_q", fault_out_q.size(), fault_out_q.drain_stats(), fault_out_reported,
+                     opts_.metrics_scope);
+        report_queue("fault_action_q", fault_action_q.size(), fault_action_q.drain_stats(), fault_action_reported,
+                     opts_.metrics_scope);
+        for (auto& lane : lanes) lane->report_metrics(report_queue);
+    };
 
-    const auto spin_slice = (pop_timeout > std::chrono::milliseconds(5)) ? std::chrono::milliseconds(5) : pop_timeout;
+    // 每轮最多连续执行的就绪任务数：避免任务风暴时 tick/drain 被饿死。
+    constexpr std::size_t kMaxReadyTasksPerTurn = 64;
 
     while (node_.base().running()) {
         node_.base().tick();
 
-        // 发布 DDS 回调 / strand 产生的结果。
-        drain_fault_out();
-        drain_resp_out();
+        // 取空所有已就绪的工作：结果/故障发布、fault action、命令派发。
+        std::size_t work = 0;
+        work += drain_fault_out();
+        work += drain_resp_out();
+        work += handle_fault_actions();
+        work += dispatch_cmds();
+
+        // 非阻塞地执行 executor 中已就绪的回调/任务（ingress + 共用主 executor 的 sdk strand + rpc）。
+        for (std::size_t i = 0; i < kMaxReadyTasksPerTurn && exec_.spin_once(std::chrono::milliseconds(0)); ++i) {
+            ++work;
+        }
 
-        // 处理 fault action（主线程发 ack，SDK 调用在 strand 上执行）。
-        handle_fault_actions();
+        for (auto& lane : lanes) {
+            lane->maybe_poll_motion();
+            lane->maybe_publish_state();
+        }
+        maybe_report_metrics();
 
-        // 每轮最多取出并派发一条命令。
-        dispatch_one_cmd();
+        if (work > 0) continue;
 
-        // 每轮驱动一个待执行的回调/任务（ingress + sdk + rpc，如它们绑定到该 executor）。
-        (void)exec_.spin_once(spin_slice);
+        // 空闲：阻塞在 executor 上，直到有新任务、被 wakeup 唤醒或到达 idle_wait（驱动 tick 的周期任务）。
+        // 启用 /arm/state 或有进行中的非阻塞运动时，等待时间不超过下一次发布/轮询时刻。
+        auto wait = idle_wait;
+        for (const auto& lane : lanes) lane->clamp_idle_wait(wait);
+        if (wakeup.begin_idle()) {
+            (void)exec_.spin_once(wait);
+            wakeup.end_idle();
+        }
     }
+
+    // 各臂 strand（可能在独立线程上）上的任务引用 LaneRuntime：等屏障执行完再析构；
+    // 共用主 executor 的 strand 由这里继续驱动。
+    std::atomic<std::size_t> pending{0};
+    for (auto& lane : lanes) lane->stop(pending);
+    while (pending.load() != 0) (void)exec_.spin_once(std::chrono::milliseconds(10));
 }
 
 } // namespace wxz::workstation::arm_control::internal
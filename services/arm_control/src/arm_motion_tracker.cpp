@@ -0,0 +1,95 @@
+#include "internal/arm_motion_tracker.h"
+
+#include <iostream>
+
+#include "internal/arm_runtime_tunables.h"
+#include "internal/arm_wait.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+namespace {
+
+// 与阻塞下发的 fallback-wait 相同的节拍（adaptive_poll_period，上限分别为 20/50ms）。
+constexpr auto kMinPollPeriod = std::chrono::milliseconds(5);
+constexpr auto kStartPollPeriod = std::chrono::milliseconds(20);
+constexpr auto kMovePollPeriod = std::chrono::milliseconds(50);
+
+} // namespace
+
+const char* motion_end_name(ArmMotionTracker::End e) {
+    switch (e) {
+        case ArmMotionTracker::End::None: return "none";
+        case ArmMotionTracker::End::Completed: return "completed";
+        case ArmMotionTracker::End::NotStarted: return "not_started";
+        case ArmMotionTracker::End::Timeout: return "timeout";
+        case ArmMotionTracker::End::StopSignal: return "stop_signal";
+        case ArmMotionTracker::End::Interrupted: return "interrupted";
+        case ArmMotionTracker::End::SdkError: return "sdk_error";
+    }
+    return "unknown";
+}
+
+void ArmMotionTracker::begin(Clock::time_point now) {
+    const ArmRuntimeTunables& tun = arm_.tunables();
+    phase_ = Phase::Starting;
+    last_end_ = End::None;
+    started_ = now;
+    deadline_ = now + std::chrono::milliseconds(tun.move_start_grace_ms);
+    complete_timeout_ = std::chrono::milliseconds(tun.move_complete_timeout_ms);
+    schedule(now, kStartPollPeriod);
+}
+
+void ArmMotionTracker::schedule(Clock::time_point now, std::chrono::milliseconds max_period) {
+    last_period_ = adaptive_poll_period(now - started_, kMinPollPeriod, max_period);
+    next_poll_ = now + last_period_;
+}
+
+CRresult ArmMotionTracker::finish(End why, CRresult r) {
+    arm_.finish_motion();
+    phase_ = Phase::Idle;
+    last_end_ = why;
+    return r;
+}
+
+std::optional<CRresult> ArmMotionTracker::poll(Clock::time_point now) {
+    if (phase_ == Phase::Idle) return std::nullopt;
+
+    if (arm_.motion_interrupted()) return finish(End::Interrupted, CR_FAILED);
+    if (arm_.IsStopSignal()) {
+        (void)arm_.stop_motion();
+        return finish(End::StopSignal, CR_FAILED);
+    }
+
+    bool moving = false;
+    const CRresult r = arm_.poll_motion(moving);
+    if (r != success) return finish(End::SdkError, r);
+
+    if (phase_ == Phase::Starting) {
+        if (moving) {
+            phase_ = Phase::Moving;
+            deadline_ = now + complete_timeout_;
+            schedule(now, kMovePollPeriod);
+            return std::nullopt;
+        }
+        if (now < deadline_) {
+            schedule(now, kStartPollPeriod);
+            return std::nullopt;
+        }
+        // 与阻塞下发的 fallback-wait 一致：start_grace 内未观察到运动即失败。
+        // 空闲且就绪的控制器也可能是指令被静默忽略/拒绝，不能据此判定完成；
+        // 真实的短距离运动在 5ms 起步的轮询下会被观察到。
+        std::cerr << "motion not observed within start grace" << "\n";
+        return finish(End::NotStarted, move_error);
+    }
+
+    if (!moving) return finish(End::Completed, success);
+    if (now >= deadline_) {
+        // 超时后仍在运动：先停下，避免下一条运动指令与之重叠。
+        (void)arm_.stop_motion();
+        return finish(End::Timeout, operate_timeout);
+    }
+    schedule(now, kMovePollPeriod);
+    return std::nullopt;
+}
+
+} // namespace wxz::workstation::arm_control::internal
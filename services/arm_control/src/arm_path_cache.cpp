@@ -0,0 +1,269 @@
+#include "internal/arm_path_cache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <utility>
+
+#include "internal/arm_metrics.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+namespace {
+
+bool stat_file(const std::string& file, std::uint64_t& size, std::int64_t& mtime_ns) {
+    struct stat st {};
+    if (::stat(file.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return false;
+    size = static_cast<std::uint64_t>(st.st_size);
+    mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    return true;
+}
+
+// FNV-1a 64：路径文件为 KB~MB 级文本，哈希开销远小于 SDK 解析；冲突另由 size 兜底。
+std::uint64_t fnv1a64(const unsigned char* p, std::size_t n) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// mmap 源文件计算内容哈希：不经用户态缓冲拷贝，页缓存命中时不产生磁盘 I/O。
+std::optional<std::uint64_t> hash_file(const std::string& file, std::uint64_t size) {
+    if (size == 0) return fnv1a64(nullptr, 0);
+    const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::nullopt;
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return std::nullopt;
+    (void)::madvise(p, size, MADV_SEQUENTIAL);
+    const std::uint64_t h = fnv1a64(static_cast<const unsigned char*>(p), size);
+    ::munmap(p, size);
+    return h;
+}
+
+double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+ArmPathCache::ArmPathCache(Options opts, wxz::core::Logger& logger)
+    : opts_(std::move(opts)), logger_(logger) {
+    if (opts_.max_entries == 0) opts_.max_entries = 1;
+}
+
+ArmPathCache::~ArmPathCache() {
+    stopping_.store(true);
+    if (preload_.joinable()) preload_.join();
+}
+
+CRresult ArmPathCache::acquire(const std::string& file, std::size_t max_points, Lease& out) {
+    out.reset();
+    const std::string& scope = opts_.metrics_scope;
+
+    std::uint64_t size = 0;
+    std::int64_t mtime_ns = 0;
+    std::optional<std::uint64_t> hash;
+    if (stat_file(file, size, mtime_ns)) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            const auto it = by_path_.find(file);
+            if (it != by_path_.end() && it->second.size == size && it->second.mtime_ns == mtime_ns) {
+                if ((out = find_locked(it->second.hash, size, max_points))) {
+                    ArmMetrics::counter_add("wxz.arm.path_cache.hit_total", 1.0, scope);
+                    return success;
+                }
+            }
+        }
+        hash = hash_file(file, size);
+    }
+
+    if (!hash) {
+        // 无法 stat/读取：交给 SDK 解析得到与原先一致的错误码，不缓存。解析同样串行（见 parse_mu_）。
+        std::lock_guard<std::mutex> parse_lock(parse_mu_);
+        std::shared_ptr<Entry> entry;
+        const CRresult r = parse(file, max_points, entry);
+        out = std::move(entry);
+        return r;
+    }
+
+    // 同一内容只解析一次：并发未命中的调用在 parse_mu_ 上排队，拿到锁后先复查。
+    std::lock_guard<std::mutex> parse_lock(parse_mu_);
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if ((out = find_locked(*hash, size, max_points))) {
+            by_path_[file] = PathKey{*hash, size, mtime_ns};
+            ArmMetrics::counter_add("wxz.arm.path_cache.hit_total", 1.0, scope);
+            return success;
+        }
+    }
+
+    std::shared_ptr<Entry> entry;
+    const CRresult r = parse(file, max_points, entry);
+    if (r != success) return r;
+    entry->hash = *hash;
+    entry->size = size;
+    ArmMetrics::counter_add("wxz.arm.path_cache.miss_total", 1.0, scope);
+
+    // 哈希与解析之间文件被改写：本次结果照常使用，但不缓存。
+    std::uint64_t size2 = 0;
+    std::int64_t mtime2 = 0;
+    if (stat_file(file, size2, mtime2) && size2 == size && mtime2 == mtime_ns) {
+        std::lock_guard<std::mutex> lock(mu_);
+        insert_locked(entry);
+        by_path_[file] = PathKey{*hash, size, mtime_ns};
+        ArmMetrics::gauge_set("wxz.arm.path_cache.entries", static_cast<double>(lru_.size()), scope);
+    }
+    out = std::move(entry);
+    return success;
+}
+
+CRresult ArmPathCache::parse(const std::string& file, std::size_t max_points, std::shared_ptr<Entry>& out) {
+    Buffer buf;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        buf = take_buffer_locked(max_points);
+    }
+
+    PathData data{};
+    data.pathPoints = buf.points.get();
+
+    char path_buf[1024];
+    std::snprintf(path_buf, sizeof(path_buf), "%s", file.c_str());
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const CRresult r = ::cr_path_file2pathData(path_buf, &data);
+    ArmMetrics::observe("wxz.arm.path_cache.parse_ms", ms_since(t0), opts_.metrics_scope);
+    if (r != success) {
+        std::lock_guard<std::mutex> lock(mu_);
+        give_buffer_locked(std::move(buf));
+        return r;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->points = std::move(buf.points);
+    entry->capacity = buf.capacity;
+    entry->data = data;
+    out = std::move(entry);
+    return success;
+}
+
+ArmPathCache::Lease ArmPathCache::find_locked(std::uint64_t hash, std::uint64_t size, std::size_t max_points) {
+    const auto it = by_hash_.find(hash);
+    if (it == by_hash_.end()) return nullptr;
+    const auto& entry = *it->second;
+    if (entry->size != size || entry->capacity < max_points) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return entry;
+}
+
+void ArmPathCache::insert_locked(std::shared_ptr<Entry> entry) {
+    auto evict = [this](LruList::iterator it) {
+        const std::uint64_t hash = (*it)->hash;
+        by_hash_.erase(hash);
+        for (auto p = by_path_.begin(); p != by_path_.end();) {
+            p = (p->second.hash == hash) ? by_path_.erase(p) : std::next(p);
+        }
+        // 仍被 path_download 持有的条目由最后一个持有者释放，缓冲不回池。
+        if (it->use_count() == 1) give_buffer_locked(Buffer{std::move((*it)->points), (*it)->capacity});
+        lru_.erase(it);
+    };
+
+    // 同内容的旧条目（容量不足而重新解析）直接替换。
+    if (const auto old = by_hash_.find(entry->hash); old != by_hash_.end()) evict(old->second);
+
+    lru_.push_front(std::move(entry));
+    by_hash_[lru_.front()->hash] = lru_.begin();
+    while (lru_.size() > opts_.max_entries) {
+        evict(std::prev(lru_.end()));
+        ArmMetrics::counter_add("wxz.arm.path_cache.eviction_total", 1.0, opts_.metrics_scope);
+    }
+}
+
+ArmPathCache::Buffer ArmPathCache::take_buffer_locked(std::size_t max_points) {
+    // 取能容纳 max_points 的最小空闲缓冲；没有则新分配（与原实现相同，不做清零）。
+    auto best = pool_.end();
+    for (auto it = pool_.begin(); it != pool_.end(); ++it) {
+        if (it->capacity >= max_points && (best == pool_.end() || it->capacity < best->capacity)) best = it;
+    }
+    if (best != pool_.end()) {
+        Buffer buf = std::move(*best);
+        pool_.erase(best);
+        return buf;
+    }
+    return Buffer{std::unique_ptr<PathPoint[]>(new PathPoint[max_points]), max_points};
+}
+
+void ArmPathCache::give_buffer_locked(Buffer buf) {
+    if (!buf.points || opts_.pool_max == 0) return;
+    if (pool_.size() >= opts_.pool_max) {
+        // 池满：丢弃最小的一块，保留大缓冲以覆盖更多请求。
+        const auto smallest = std::min_element(pool_.begin(), pool_.end(),
+                                               [](const Buffer& a, const Buffer& b) { return a.capacity < b.capacity; });
+        if (smallest->capacity >= buf.capacity) return;
+        pool_.erase(smallest);
+    }
+    pool_.push_back(std::move(buf));
+}
+
+void ArmPathCache::preload_dir(const std::string& dir, std::size_t max_points, unsigned threads) {
+    if (preload_.joinable()) preload_.join();
+    preload_ = std::thread([this, dir, max_points, threads] { run_preload(dir, max_points, threads); });
+}
+
+void ArmPathCache::run_preload(std::string dir, std::size_t max_points, unsigned threads) {
+    std::vector<std::string> files;
+    if (DIR* d = ::opendir(dir.c_str())) {
+        while (const dirent* e = ::readdir(d)) {
+            if (e->d_name[0] == '.') continue;
+            std::string path = dir + "/" + e->d_name;
+            std::uint64_t size = 0;
+            std::int64_t mtime_ns = 0;
+            if (stat_file(path, size, mtime_ns)) files.push_back(std::move(path));
+        }
+        ::closedir(d);
+    } else {
+        logger_.log(LogLevel::Warn, "path preload: cannot open dir '" + dir + "'");
+        return;
+    }
+    std::sort(files.begin(), files.end());
+    if (files.size() > opts_.max_entries) {
+        logger_.log(LogLevel::Warn, "path preload: " + std::to_string(files.size()) + " files exceed cache size " +
+                                        std::to_string(opts_.max_entries) + ", only the last ones stay cached");
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> ok{0};
+    auto worker = [&] {
+        for (std::size_t i = next++; i < files.size() && !stopping_.load(); i = next++) {
+            Lease lease;
+            if (acquire(files[i], max_points, lease) == success) {
+                ok.fetch_add(1);
+            } else {
+                logger_.log(LogLevel::Warn, "path preload: parse failed '" + files[i] + "'");
+            }
+        }
+    };
+
+    const std::size_t n = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(files.size(), 1));
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < n; ++i) workers.emplace_back(worker);
+    worker();
+    for (auto& t : workers) t.join();
+
+    logger_.log(LogLevel::Info, "path preload dir='" + dir + "' files=" + std::to_string(files.size()) +
+                                    " ok=" + std::to_string(ok.load()) +
+                                    " ms=" + std::to_string(static_cast<long long>(ms_since(t0))));
+}
+
+} // namespace wxz::workstation::arm_control::internal
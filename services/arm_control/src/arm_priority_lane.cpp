@@ -0,0 +1,75 @@
+#include "internal/arm_priority_lane.h"
+
+#include <chrono>
+#include <utility>
+
+#include "internal/arm_command_processor.h"
+#include "internal/arm_metrics.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+ArmPriorityLane::ArmPriorityLane(ArmCommandProcessor& processor,
+                                 IArmClient& arm,
+                                 IArmClient& primary,
+                                 Options opts,
+                                 wxz::core::Logger& logger)
+    : processor_(processor)
+    , arm_(arm)
+    , primary_(primary)
+    , opts_(std::move(opts))
+    , logger_(logger)
+    , queue_(opts_.queue_max) {
+    auto* sdk = dynamic_cast<ArmSdkClient*>(&arm_);
+    auto* sdk_primary = dynamic_cast<ArmSdkClient*>(&primary_);
+    if (sdk && sdk_primary) sdk->set_stop_peer(sdk_primary);
+}
+
+ArmPriorityLane::~ArmPriorityLane() {
+    stop();
+}
+
+void ArmPriorityLane::start(ReplyFn on_reply) {
+    if (thread_.joinable()) return;
+    on_reply_ = std::move(on_reply);
+    running_.store(true);
+    thread_ = std::thread([this] { run(); });
+    logger_.log(LogLevel::Info, "priority lane started queue_max=" + std::to_string(opts_.queue_max));
+}
+
+void ArmPriorityLane::stop() {
+    running_.store(false);
+    if (thread_.joinable()) thread_.join();
+}
+
+void ArmPriorityLane::run() {
+    while (running_.load()) {
+        auto cmd = queue_.pop_for(std::chrono::milliseconds(100), running_);
+        if (!cmd) continue;
+
+        auto handle = [&](IArmClient& arm) {
+            return cmd->v2 ? processor_.handle_v2_command(cmd->raw, arm, logger_)
+                           : processor_.handle_raw_command(cmd->raw, arm, logger_);
+        };
+        auto kv = handle(arm_);
+        if (!arm_.connected()) {
+            logger_.log(LogLevel::Warn, "priority lane session unavailable, falling back to primary client");
+            ArmMetrics::counter_add("wxz.arm.priority.fallback_total", 1.0, opts_.metrics_scope);
+            kv = handle(primary_);
+        }
+
+        // 停止类指令罕见：逐条上报即可，不必周期汇总。
+        if (cmd->rx_ns != 0) {
+            const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+            ArmMetrics::observe("wxz.arm.priority.latency_ms",
+                                static_cast<double>(now_ns - cmd->rx_ns) / 1e6,
+                                opts_.metrics_scope);
+        }
+        ArmMetrics::counter_add("wxz.arm.priority.handled_total", 1.0, opts_.metrics_scope);
+
+        if (on_reply_) on_reply_(std::move(kv), cmd->v2);
+    }
+}
+
+} // namespace wxz::workstation::arm_control::internal
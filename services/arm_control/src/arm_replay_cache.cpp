@@ -0,0 +1,76 @@
+#include "internal/arm_replay_cache.h"
+
+#include <utility>
+
+namespace wxz::workstation::arm_control::internal {
+
+ArmReplayCache::Verdict ArmReplayCache::admit(const std::string& id,
+                                              const std::string& op,
+                                              std::chrono::steady_clock::time_point now,
+                                              const EventDTOUtil::KvMap*& cached) {
+    cached = nullptr;
+    auto it = entries_.find(id);
+    if (it != entries_.end() && it->second.op == op) {
+        Entry& e = it->second;
+        if (!e.done) {
+            ++stats_.attached;
+            return Verdict::Attached;
+        }
+        if (now < e.expires) {
+            ++stats_.replayed;
+            cached = &e.resp;
+            return Verdict::Replay;
+        }
+    }
+
+    // 新 id、已过期或 op 不同：重新登记（旧的 order_ 项因 seq 不符在淘汰时跳过）。
+    Entry& e = entries_[id];
+    e = Entry{};
+    e.op = op;
+    e.seq = next_seq_++;
+    order_.emplace_back(id, e.seq);
+    evict_overflow();
+    return Verdict::Execute;
+}
+
+void ArmReplayCache::complete(const std::string& id,
+                              const EventDTOUtil::KvMap& resp,
+                              std::chrono::steady_clock::time_point now) {
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.done) return;
+    it->second.done = true;
+    it->second.expires = now + opts_.ttl;
+    it->second.resp = resp;
+}
+
+void ArmReplayCache::forget(const std::string& id) {
+    auto it = entries_.find(id);
+    if (it != entries_.end() && !it->second.done) entries_.erase(it);
+}
+
+void ArmReplayCache::evict_overflow() {
+    // order_ 里可能残留已覆盖/移除条目的旧登记：先丢掉它们，保证其长度与条目数同阶。
+    while (!order_.empty()) {
+        auto& [id, seq] = order_.front();
+        auto it = entries_.find(id);
+        const bool stale = it == entries_.end() || it->second.seq != seq;
+        if (!stale && entries_.size() <= opts_.max_entries) break;
+        if (!stale) {
+            if (!it->second.done) ++stats_.evicted_in_flight;
+            entries_.erase(it);
+        }
+        order_.pop_front();
+    }
+
+    // 队首条目长期在途时，中间的旧登记无法从队首清掉：超过两倍容量时整体压缩一次。
+    if (order_.size() > 2 * opts_.max_entries + 16) {
+        std::deque<std::pair<std::string, std::uint64_t>> live;
+        for (auto& item : order_) {
+            auto it = entries_.find(item.first);
+            if (it != entries_.end() && it->second.seq == item.second) live.push_back(std::move(item));
+        }
+        order_.swap(live);
+    }
+}
+
+} // namespace wxz::workstation::arm_control::internal
@@ -1,25 +1,99 @@
 #include "internal/arm_rpc_handlers.h"
 
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <string>
 
 #include "framework/typed_rpc.h"
 #include "internal/arm_command_processor.h"
 #include "internal/arm_control_internal.h"
+#include "internal/arm_runtime_tunables.h"
 #include "internal/rpc_kv_codec.h"
 #include "workstation/arm_control_rpc.h"
 
 namespace wxz::workstation::arm_control::internal {
+namespace {
+
+using Json = wxz::workstation::RpcService::Json;
+
+Json tunables_to_json(const ArmRuntimeTunables& t) {
+    return Json{
+        {"start_di_index", t.start_di_index},
+        {"stop_di_index", t.stop_di_index},
+        {"path_index", t.path_index},
+        {"allow_large_angle", t.allow_large_angle},
+        {"allow_large_joint", t.allow_large_joint},
+        {"dry_run", t.dry_run},
+        {"move_start_grace_ms", t.move_start_grace_ms},
+        {"move_complete_timeout_ms", t.move_complete_timeout_ms},
+        {"state_max_age_ms", t.state_max_age_ms},
+        {"precheck_max_age_ms", t.precheck_max_age_ms},
+        {"generation", t.generation},
+    };
+}
+
+/// 把 params 中出现的字段覆盖到 t 上；未知字段或类型不符时返回该字段名。
+std::string apply_tunables_patch(const Json& params, ArmRuntimeTunables& t) {
+    if (params.is_null()) return {};
+    if (!params.is_object()) return "params";
+    for (const auto& [key, v] : params.items()) {
+        int* i = nullptr;
+        bool* b = nullptr;
+        if (key == "start_di_index") i = &t.start_di_index;
+        else if (key == "stop_di_index") i = &t.stop_di_index;
+        else if (key == "path_index") i = &t.path_index;
+        else if (key == "move_start_grace_ms") i = &t.move_start_grace_ms;
+        else if (key == "move_complete_timeout_ms") i = &t.move_complete_timeout_ms;
+        else if (key == "state_max_age_ms") i = &t.state_max_age_ms;
+        else if (key == "precheck_max_age_ms") i = &t.precheck_max_age_ms;
+        else if (key == "allow_large_angle") b = &t.allow_large_angle;
+        else if (key == "allow_large_joint") b = &t.allow_large_joint;
+        else if (key == "dry_run") b = &t.dry_run;
+        else return key;
+
+        if (i) {
+            if (!v.is_number_integer()) return key;
+            const auto n = v.get<std::int64_t>();
+            if (n < std::numeric_limits<int>::min() || n > std::numeric_limits<int>::max()) return key;
+            *i = static_cast<int>(n);
+        } else if (v.is_boolean()) {
+            *b = v.get<bool>();
+        } else if (v.is_number_integer() && (v.get<std::int64_t>() == 0 || v.get<std::int64_t>() == 1)) {
+            *b = (v.get<std::int64_t>() == 1);
+        } else {
+            return key;
+        }
+    }
+    return {};
+}
+
+/// 执行一条 arm.command 形式的指令（params 含 {"op":"..."}）；params 不合法时返回 std::nullopt。
+///
+/// 描述表中可类型化的 op 由 JSON 直接构造 CommandV2 分发（不经 KV 文本编码/解析）；
+/// 字符串参数、扩展 op 等其它情况转换为 KV 文本，复用既有的领域处理逻辑。
+std::optional<EventDTOUtil::KvMap> run_command(const Json& params,
+                                               ArmCommandProcessor& processor,
+                                               IArmClient& arm,
+                                               wxz::core::Logger& logger) {
+    wire::CommandV2 typed;
+    if (build_cmd_v2_from_params(params, typed)) {
+        return processor.handle_typed_command(typed, params["op"].get_ref<const std::string&>(), arm, logger);
+    }
+    const auto raw_opt = build_raw_kv_from_params(params);
+    if (!raw_opt || params["op"].get_ref<const std::string&>().empty()) return std::nullopt;
+    return processor.handle_raw_command(*raw_opt, arm, logger);
+}
+
+}  // namespace
 
 void install_arm_rpc_handlers(wxz::workstation::RpcService& rpc_server,
                               ArmCommandProcessor& processor,
                               IArmClient& arm,
                               wxz::core::Logger& logger) {
-    using Json = wxz::workstation::RpcService::Json;
-
     rpc_server.add_ping_handler("arm.ping");
 
-    // 通用命令入口：params 至少需要包含 {"op":"..."}。
-    // 其它字段会被转换为 KV，并复用既有的领域处理逻辑。
+    // 通用命令入口：params 至少需要包含 {"op":"..."}（执行方式见 run_command）。
     // typed wrapper 仅提升可读性：不改变底层 DTO/RPC 与 wire format。
     wxz::framework::typed_rpc::add_handler<wxz::workstation::arm_control::rpc::CommandRequest,
                                           wxz::workstation::arm_control::rpc::CommandReply>(
@@ -27,26 +101,96 @@ void install_arm_rpc_handlers(wxz::workstation::RpcService& rpc_server,
         std::string(wxz::workstation::arm_control::rpc::kOpCommand),
         [&](const wxz::workstation::arm_control::rpc::CommandRequest& req)
             -> wxz::framework::typed_rpc::Result<wxz::workstation::arm_control::rpc::CommandReply> {
-            const auto raw_opt = build_raw_kv_from_params(req.args);
-            if (!raw_opt || req.op.empty()) {
+            auto kv = run_command(req.args, processor, arm, logger);
+            if (!kv) {
                 wxz::framework::typed_rpc::Result<wxz::workstation::arm_control::rpc::CommandReply> out;
                 out.status = wxz::workstation::Status::error(1, "missing_or_invalid_params.op");
                 return out;
             }
 
-            EventDTOUtil::KvMap kv = processor.handle_raw_command(*raw_opt, arm, logger);
+            // 保持历史行为：RPC 传输/handler 成功用 ok=true 表示；业务失败信息由 kv 内字段承载。
+            wxz::framework::typed_rpc::Result<wxz::workstation::arm_control::rpc::CommandReply> out;
+            out.status = wxz::workstation::Status::ok_status();
+            out.value.kv = kv_to_json(std::move(*kv));
+            return out;
+        });
 
-            Json kv_json = Json::object();
-            for (const auto& [k, v] : kv) {
-                kv_json[k] = v;
+    // 批量命令：handler 已调度在 arm_sdk_strand 上，各条指令在同一次调用内连续执行，中间不插入其它 SDK 工作。
+    // 单条指令不合法（缺 op 等）记为该条失败（bad_request），不影响整个请求的 status。
+    wxz::framework::typed_rpc::add_handler<wxz::workstation::arm_control::rpc::BatchRequest,
+                                          wxz::workstation::arm_control::rpc::BatchReply>(
+        rpc_server,
+        std::string(wxz::workstation::arm_control::rpc::kOpBatch),
+        [&](const wxz::workstation::arm_control::rpc::BatchRequest& req)
+            -> wxz::framework::typed_rpc::Result<wxz::workstation::arm_control::rpc::BatchReply> {
+            wxz::framework::typed_rpc::Result<wxz::workstation::arm_control::rpc::BatchReply> out;
+            if (req.commands.empty()) {
+                out.status = wxz::workstation::Status::error(1, "missing_or_invalid_params.commands");
+                return out;
+            }
+            if (req.commands.size() > wxz::workstation::arm_control::rpc::kMaxBatchCommands) {
+                out.status = wxz::workstation::Status::error(1, "too_many_commands");
+                return out;
             }
 
-            // 保持历史行为：RPC 传输/handler 成功用 ok=true 表示；业务失败信息由 kv 内字段承载。
-            wxz::framework::typed_rpc::Result<wxz::workstation::arm_control::rpc::CommandReply> out;
+            auto& results = out.value.results;
+            results.reserve(req.commands.size());
+            for (std::size_t i = 0; i < req.commands.size(); ++i) {
+                auto kv = run_command(req.commands[i].args, processor, arm, logger);
+                if (!kv) {
+                    kv.emplace();
+                    arm_set_error(*kv, ArmErrc::BadRequest, "missing_or_invalid_params.op");
+                }
+                const auto ok_it = kv->find("ok");
+                const bool ok = ok_it != kv->end() && ok_it->second == "1";
+                results.emplace_back().kv = kv_to_json(std::move(*kv));
+                if (ok) continue;
+                if (out.value.first_error < 0) out.value.first_error = static_cast<int>(i);
+                if (req.stop_on_error && i + 1 < req.commands.size()) {
+                    out.value.stopped = true;
+                    logger.log(LogLevel::Warn, "arm.batch stopped at index " + std::to_string(i) + " of " +
+                                                   std::to_string(req.commands.size()));
+                    break;
+                }
+            }
             out.status = wxz::workstation::Status::ok_status();
-            out.value.kv = std::move(kv_json);
             return out;
         });
+
+    // 运行期可调参数：params 中的字段覆盖最新快照后整体发布（空 params 仅返回当前快照）。
+    // 只作用于本服务所属臂的仓库（多臂时各臂的 arm.set_tunables 互不影响）。
+    // 覆盖与校验在仓库写锁内完成（并发的 set_tunables 不会丢失对方的修改）；校验失败时不发布，
+    // 热路径读到的始终是某一个完整版本。
+    auto* sdk = dynamic_cast<ArmSdkClient*>(&arm);
+    ArmRuntimeTunablesStore* store = sdk ? &sdk->tunables_store() : &arm_runtime_tunables();
+    rpc_server.add_handler(std::string(wxz::workstation::arm_control::rpc::kOpSetTunables), [&, store](const Json& params) {
+        wxz::workstation::RpcService::Reply rep;
+
+        if (!params.is_null() && !params.is_object()) {
+            rep.status = wxz::workstation::Status::error(1, "invalid_params.params");
+            return rep;
+        }
+
+        const ArmRuntimeTunables* cur = &store->current();
+        if (params.is_object() && !params.empty()) {
+            std::string err;
+            cur = store->update(
+                [&](ArmRuntimeTunables& t) {
+                    const std::string bad = apply_tunables_patch(params, t);
+                    return bad.empty() ? std::string{} : "invalid_params." + bad;
+                },
+                err);
+            if (!cur) {
+                rep.status = wxz::workstation::Status::error(1, err);
+                return rep;
+            }
+            logger.log(LogLevel::Info, "arm.set_tunables generation=" + std::to_string(cur->generation) + " " +
+                                           params.dump());
+        }
+        rep.status = wxz::workstation::Status::ok_status();
+        rep.result = tunables_to_json(*cur);
+        return rep;
+    });
 }
 
 } // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,239 @@
+#include "internal/arm_rt.h"
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "internal/arm_control_internal.h"
+#include "internal/arm_metrics.h"
+
+#include "strand.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+namespace {
+
+std::string errno_text(const char* what, int err) {
+    return std::string(what) + ": " + std::strerror(err);
+}
+
+std::string limit_text(int resource) {
+    struct rlimit rl {};
+    if (::getrlimit(resource, &rl) != 0) return "?";
+    return rl.rlim_cur == RLIM_INFINITY ? std::string("unlimited") : std::to_string(rl.rlim_cur);
+}
+
+// 逐页写栈：在当前栈帧下方占用 bytes 字节并触摸，使这些页在 mlockall 下常驻，之后的深调用不再缺页。
+__attribute__((noinline)) void prefault_stack(std::size_t bytes) {
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto* p = static_cast<volatile unsigned char*>(alloca(bytes));
+    for (std::size_t i = 0; i < bytes; i += page) p[i] = 0;
+}
+
+// 在调用线程的 arena 中分块申请并触摸 bytes 字节后全部释放：M_TRIM_THRESHOLD=-1 时这些页留在该 arena 的
+// 空闲链表里，之后本线程的分配直接复用（已 mlock 的）页。分块是因为非主 arena 的单个 heap 有上限（64 位为 64MB），
+// 且 M_MMAP_MAX=0 时超出的大块分配会失败或落到别的 arena。
+std::size_t reserve_thread_heap(std::size_t bytes) {
+    constexpr std::size_t kChunk = 1024 * 1024;
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    chunks.reserve(bytes / kChunk + 1);
+    std::size_t reserved = 0;
+    while (reserved < bytes) {
+        const std::size_t n = std::min(kChunk, bytes - reserved);
+        std::unique_ptr<unsigned char[]> block(new (std::nothrow) unsigned char[n]);
+        if (!block) break;
+        auto* p = static_cast<volatile unsigned char*>(block.get());
+        for (std::size_t i = 0; i < n; i += page) p[i] = 0;
+        chunks.push_back(std::move(block));
+        reserved += n;
+    }
+    return reserved;
+}
+
+} // namespace
+
+void arm_rt_setup_process(const ArmRtOptions& opts, ArmRtStatus& status) {
+    // 先固定 malloc 行为，再由各 SDK 线程预留：释放后的内存留在堆中供后续分配复用，不再经 mmap/brk 向内核要页。
+    (void)::mallopt(M_TRIM_THRESHOLD, -1);
+    (void)::mallopt(M_MMAP_MAX, 0);
+
+    if (opts.mlock) {
+        if (::mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            status.mlocked = true;
+        } else {
+            status.problems.push_back(errno_text("mlockall", errno) + " (RLIMIT_MEMLOCK=" + limit_text(RLIMIT_MEMLOCK) + ")");
+        }
+    } else {
+        status.mlocked = true;
+    }
+}
+
+void arm_rt_setup_thread(const ArmRtOptions& opts, ArmRtStatus& status) {
+    sched_param sp {};
+    sp.sched_priority = std::clamp(opts.fifo_priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    if (const int rc = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &sp); rc != 0) {
+        status.problems.push_back(errno_text("pthread_setschedparam(SCHED_FIFO)", rc) +
+                                  " (RLIMIT_RTPRIO=" + limit_text(RLIMIT_RTPRIO) + ")");
+    } else {
+        // 自检：读回实际策略，防止被容器/cgroup 静默降级。
+        int policy = 0;
+        sched_param got {};
+        status.fifo = ::pthread_getschedparam(::pthread_self(), &policy, &got) == 0 && policy == SCHED_FIFO;
+        if (!status.fifo) status.problems.push_back("SCHED_FIFO not in effect after setschedparam");
+    }
+
+    if (opts.stack_prefault > 0) {
+        pthread_attr_t attr;
+        std::size_t stack_size = 0;
+        if (::pthread_getattr_np(::pthread_self(), &attr) == 0) {
+            void* addr = nullptr;
+            (void)::pthread_attr_getstack(&attr, &addr, &stack_size);
+            (void)::pthread_attr_destroy(&attr);
+        }
+        // 留出余量，避免预触摸本身溢出栈。
+        if (stack_size != 0 && opts.stack_prefault + 64 * 1024 > stack_size) {
+            status.problems.push_back("stack prefault " + std::to_string(opts.stack_prefault) +
+                                      " exceeds thread stack " + std::to_string(stack_size));
+        } else {
+            prefault_stack(opts.stack_prefault);
+            status.stack_prefaulted = true;
+        }
+    } else {
+        status.stack_prefaulted = true;
+    }
+
+    if (opts.heap_reserve > 0) {
+        status.heap_reserved_bytes = reserve_thread_heap(opts.heap_reserve);
+        status.heap_reserved = status.heap_reserved_bytes == opts.heap_reserve;
+        if (!status.heap_reserved) {
+            status.problems.push_back("heap reserve stopped at " + std::to_string(status.heap_reserved_bytes) + " of " +
+                                      std::to_string(opts.heap_reserve) + " bytes");
+        }
+    } else {
+        status.heap_reserved = true;
+    }
+}
+
+void arm_rt_report(const ArmRtOptions& opts, const ArmRtStatus& status, const std::string& metrics_scope,
+                   wxz::core::Logger& logger) {
+    const bool ok = status.ok();
+    std::string line = "rt mode " + std::string(ok ? "active" : "degraded") +
+                       " fifo_prio=" + std::to_string(opts.fifo_priority) +
+                       " mlock=" + std::to_string(status.mlocked ? 1 : 0) +
+                       " heap_reserve=" + std::to_string(status.heap_reserved_bytes) + "/" +
+                       std::to_string(opts.heap_reserve) + "(sdk thread arena)" +
+                       " stack_prefault=" + std::to_string(opts.stack_prefault);
+    for (const auto& p : status.problems) line += "; " + p;
+    logger.log(ok ? LogLevel::Info : LogLevel::Warn, line);
+    ArmMetrics::gauge_set("wxz.arm.rt.active", ok ? 1.0 : 0.0, metrics_scope);
+}
+
+ArmDispatchProbe::ArmDispatchProbe(wxz::core::Strand& strand, Options opts, wxz::core::Logger& logger)
+    : strand_(strand), opts_(std::move(opts)), logger_(logger) {
+    if (opts_.period.count() <= 0) opts_.period = std::chrono::milliseconds(10);
+    samples_us_.reserve(static_cast<std::size_t>(opts_.report_period / opts_.period) + 16);
+}
+
+ArmDispatchProbe::~ArmDispatchProbe() {
+    stop();
+}
+
+void ArmDispatchProbe::start() {
+    if (thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = false;
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+void ArmDispatchProbe::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void ArmDispatchProbe::run() {
+    using clock = std::chrono::steady_clock;
+    auto to_ns = [](clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    };
+
+    auto next_report = clock::now() + opts_.report_period;
+    std::int64_t posted_ns = 0;  // 在途探测的投递时刻；0 表示没有在途探测
+
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+        lock.unlock();
+        if (posted_ns != 0) {
+            const std::int64_t ran = ran_ns_.load(std::memory_order_acquire);
+            if (ran != 0) {
+                samples_us_.push_back((ran - posted_ns) / 1000);
+                posted_ns = 0;
+            }
+        }
+        if (posted_ns == 0) {
+            ran_ns_.store(0, std::memory_order_relaxed);
+            posted_ns = to_ns(clock::now());
+            if (!strand_.post([this] {
+                    const auto now = clock::now().time_since_epoch();
+                    ran_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(),
+                                  std::memory_order_release);
+                })) {
+                posted_ns = 0;
+            }
+        }
+        if (clock::now() >= next_report) {
+            next_report += opts_.report_period;
+            report();
+        }
+        lock.lock();
+        cv_.wait_for(lock, opts_.period, [this] { return stop_; });
+    }
+    lock.unlock();
+
+    // 在途探测任务引用 this：等它执行完再返回（SDK 线程停止时 post 的任务不再执行，最多等一个上报周期）。
+    const auto deadline = clock::now() + opts_.report_period;
+    while (posted_ns != 0 && ran_ns_.load(std::memory_order_acquire) == 0 && clock::now() < deadline) {
+        std::this_thread::sleep_for(opts_.period);
+    }
+}
+
+void ArmDispatchProbe::report() {
+    if (samples_us_.empty()) return;
+    auto pct = [&](double q) {
+        const std::size_t k = std::min(samples_us_.size() - 1, static_cast<std::size_t>(q * samples_us_.size()));
+        std::nth_element(samples_us_.begin(), samples_us_.begin() + static_cast<std::ptrdiff_t>(k), samples_us_.end());
+        return samples_us_[k];
+    };
+    const std::int64_t p50 = pct(0.50);
+    const std::int64_t p99 = pct(0.99);
+    const std::int64_t p999 = pct(0.999);
+    const std::int64_t max = *std::max_element(samples_us_.begin(), samples_us_.end());
+
+    logger_.log(LogLevel::Info,
+                "dispatch probe" + (opts_.label.empty() ? std::string{} : " arm=" + opts_.label) +
+                    " rt=" + (opts_.rt ? "on" : "off") + " n=" + std::to_string(samples_us_.size()) +
+                    " p50_us=" + std::to_string(p50) + " p99_us=" + std::to_string(p99) +
+                    " p999_us=" + std::to_string(p999) + " max_us=" + std::to_string(max));
+    ArmMetrics::gauge_set("wxz.arm.rt.dispatch_p50_us", static_cast<double>(p50), opts_.metrics_scope);
+    ArmMetrics::gauge_set("wxz.arm.rt.dispatch_p99_us", static_cast<double>(p99), opts_.metrics_scope);
+    ArmMetrics::gauge_set("wxz.arm.rt.dispatch_p999_us", static_cast<double>(p999), opts_.metrics_scope);
+    ArmMetrics::gauge_set("wxz.arm.rt.dispatch_max_us", static_cast<double>(max), opts_.metrics_scope);
+    samples_us_.clear();
+}
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,71 @@
+#include "internal/arm_runtime_tunables.h"
+
+#include <utility>
+
+#include "internal/arm_control_internal.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+ArmRuntimeTunables load_arm_runtime_tunables_from_env() {
+    ArmRuntimeTunables t;
+    t.start_di_index = Env::get_int("WXZ_ARM_START_DI_INDEX", 0);
+    t.stop_di_index = Env::get_int("WXZ_ARM_STOP_DI_INDEX", 1);
+    t.path_index = Env::get_int("WXZ_ARM_PATH_INDEX", 0);
+    t.allow_large_angle = Env::get_bool("WXZ_ARM_ALLOW_LARGE_ANGLE", false);
+    t.allow_large_joint = Env::get_bool("WXZ_ARM_ALLOW_LARGE_JOINT", false);
+    t.dry_run = Env::get_bool("WXZ_ARM_DRY_RUN", false);
+    t.move_start_grace_ms = Env::get_int("WXZ_ARM_MOVE_START_GRACE_MS", 400);
+    t.move_complete_timeout_ms = Env::get_int("WXZ_ARM_MOVE_COMPLETE_TIMEOUT_MS", 600000);
+    t.state_max_age_ms = Env::get_int("WXZ_ARM_STATE_MAX_AGE_MS", 250);
+    t.precheck_max_age_ms = Env::get_int("WXZ_ARM_PRECHECK_MAX_AGE_MS", 100);
+    return t;
+}
+
+const char* validate_arm_runtime_tunables(const ArmRuntimeTunables& t) {
+    if (t.start_di_index < 0) return "start_di_index";
+    if (t.stop_di_index < 0) return "stop_di_index";
+    if (t.path_index < 0) return "path_index";
+    if (t.move_start_grace_ms < 0) return "move_start_grace_ms";
+    if (t.move_complete_timeout_ms <= 0) return "move_complete_timeout_ms";
+    if (t.state_max_age_ms < 0) return "state_max_age_ms";
+    if (t.precheck_max_age_ms < 0) return "precheck_max_age_ms";
+    return nullptr;
+}
+
+ArmRuntimeTunablesStore::ArmRuntimeTunablesStore(ArmRuntimeTunables initial) {
+    initial.generation = 0;
+    versions_.push_back(std::make_unique<const ArmRuntimeTunables>(std::move(initial)));
+    cur_.store(versions_.back().get(), std::memory_order_release);
+}
+
+const ArmRuntimeTunables& ArmRuntimeTunablesStore::publish(ArmRuntimeTunables next) {
+    std::lock_guard<std::mutex> lock(write_mu_);
+    return publish_locked(std::move(next));
+}
+
+const ArmRuntimeTunables* ArmRuntimeTunablesStore::update(const Patch& patch, std::string& err) {
+    std::lock_guard<std::mutex> lock(write_mu_);
+    ArmRuntimeTunables next = *versions_.back();
+    err = patch(next);
+    if (!err.empty()) return nullptr;
+    if (const char* field = validate_arm_runtime_tunables(next)) {
+        err = std::string("out_of_range.") + field;
+        return nullptr;
+    }
+    return &publish_locked(std::move(next));
+}
+
+const ArmRuntimeTunables& ArmRuntimeTunablesStore::publish_locked(ArmRuntimeTunables next) {
+    next.generation = versions_.back()->generation + 1;
+    versions_.push_back(std::make_unique<const ArmRuntimeTunables>(std::move(next)));
+    const ArmRuntimeTunables* p = versions_.back().get();
+    cur_.store(p, std::memory_order_release);
+    return *p;
+}
+
+ArmRuntimeTunablesStore& arm_runtime_tunables() {
+    static ArmRuntimeTunablesStore store(load_arm_runtime_tunables_from_env());
+    return store;
+}
+
+} // namespace wxz::workstation::arm_control::internal
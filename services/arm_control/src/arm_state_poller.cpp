@@ -0,0 +1,98 @@
+#include "internal/arm_state_poller.h"
+
+#include <utility>
+
+#include "internal/arm_control_internal.h"
+#include "internal/arm_metrics.h"
+
+namespace wxz::workstation::arm_control::internal {
+
+ArmStatePoller::ArmStatePoller(ArmSdkClient& arm, Options opts, wxz::core::Logger& logger)
+    : arm_(arm), opts_(std::move(opts)), logger_(logger) {
+    if (opts_.period.count() <= 0) opts_.period = std::chrono::milliseconds(100);
+}
+
+ArmStatePoller::~ArmStatePoller() {
+    stop();
+}
+
+void ArmStatePoller::start() {
+    if (thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = false;
+    }
+    thread_ = std::thread([this] { run(); });
+    logger_.log(LogLevel::Info, "state poller started period_ms=" + std::to_string(opts_.period.count()));
+}
+
+void ArmStatePoller::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void ArmStatePoller::run() {
+    constexpr auto kMetricsPeriod = std::chrono::seconds(1);
+
+    Counters counters;
+    Counters reported;
+    auto last_ok = std::chrono::steady_clock::time_point{};
+    auto next_sample = std::chrono::steady_clock::now();
+    auto next_report = next_sample + kMetricsPeriod;
+
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+        lock.unlock();
+        switch (arm_.sample_state()) {
+            case ArmSdkClient::SampleResult::Ok:
+                ++counters.ok;
+                last_ok = std::chrono::steady_clock::now();
+                break;
+            case ArmSdkClient::SampleResult::Busy: ++counters.busy; break;
+            case ArmSdkClient::SampleResult::Disconnected: ++counters.disconnected; break;
+            case ArmSdkClient::SampleResult::Failed: ++counters.failed; break;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_report) {
+            next_report = now + kMetricsPeriod;
+            const auto cs = arm_.state_cache_stats();
+            counters.cache_hits = cs.hits;
+            counters.cache_misses = cs.misses;
+            report_metrics(counters, reported, last_ok);
+        }
+
+        // 固定节拍：本轮耗时计入周期；落后超过一个周期时不追赶。
+        next_sample += opts_.period;
+        if (next_sample < now) next_sample = now + opts_.period;
+        lock.lock();
+        cv_.wait_until(lock, next_sample, [this] { return stop_; });
+    }
+}
+
+void ArmStatePoller::report_metrics(const Counters& now,
+                                    Counters& reported,
+                                    std::chrono::steady_clock::time_point last_ok) {
+    const std::string& scope = opts_.metrics_scope;
+    auto add = [&](const char* name, std::uint64_t cur, std::uint64_t prev) {
+        if (cur > prev) ArmMetrics::counter_add(name, static_cast<double>(cur - prev), scope);
+    };
+    add("wxz.arm.state_poll.samples_total", now.ok, reported.ok);
+    add("wxz.arm.state_poll.busy_total", now.busy, reported.busy);
+    add("wxz.arm.state_poll.disconnected_total", now.disconnected, reported.disconnected);
+    add("wxz.arm.state_poll.failed_total", now.failed, reported.failed);
+    add("wxz.arm.state_cache.hit_total", now.cache_hits, reported.cache_hits);
+    add("wxz.arm.state_cache.miss_total", now.cache_misses, reported.cache_misses);
+    reported = now;
+
+    if (last_ok != std::chrono::steady_clock::time_point{}) {
+        const auto age = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - last_ok);
+        ArmMetrics::gauge_set("wxz.arm.state_poll.age_ms", static_cast<double>(age.count()), scope);
+    }
+}
+
+} // namespace wxz::workstation::arm_control::internal
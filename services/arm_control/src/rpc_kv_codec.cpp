@@ -1,8 +1,12 @@
 #include "internal/rpc_kv_codec.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <utility>
 
+#include "workstation/arm_ops.h"
+
 namespace wxz::workstation::arm_control::internal {
 
 std::string json_to_scalar(const Json& v) {
@@ -47,4 +51,72 @@ std::optional<std::string> build_raw_kv_from_params(const Json& params) {
     return raw;
 }
 
+namespace {
+
+bool json_to_f64x6(const Json& v, std::array<double, 6>& out) {
+    if (!v.is_array() || v.size() != out.size()) return false;
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        if (!v[i].is_number()) return false;
+        out[i] = v[i].get<double>();
+    }
+    return true;
+}
+
+bool json_to_f64(const Json& v, double& out) {
+    if (!v.is_number()) return false;
+    out = v.get<double>();
+    return true;
+}
+
+}  // namespace
+
+bool build_cmd_v2_from_params(const Json& params, wire::CommandV2& out) {
+    namespace ops = wxz::workstation::arm_control::ops;
+    if (!params.is_object()) return false;
+    auto it = params.find("op");
+    if (it == params.end() || !it->is_string()) return false;
+    const ops::OpDesc* desc = ops::find_op(it->get_ref<const std::string&>());
+    if (!desc || !wire::op_supports_v2(*desc)) return false;
+
+    out = wire::CommandV2{};
+    out.op = desc->id;
+    for (auto& [k, v] : params.items()) {
+        if (k == "op") continue;
+        if (k == "id") {
+            if (!v.is_string() || !out.id.assign(v.get_ref<const std::string&>())) return false;
+            continue;
+        }
+        const std::uint16_t field = wire::cmd_field_for(k);
+        bool ok = true;
+        switch (field) {
+            case wire::kFieldPose: ok = json_to_f64x6(v, out.pose); break;
+            case wire::kFieldJointpos: ok = json_to_f64x6(v, out.jointpos); break;
+            case wire::kFieldSpeed: ok = json_to_f64(v, out.speed); break;
+            case wire::kFieldAcc: ok = json_to_f64(v, out.acc); break;
+            case wire::kFieldJerk: ok = json_to_f64(v, out.jerk); break;
+            case wire::kFieldTimeoutMs: {
+                ok = v.is_number_integer() && v.get<std::int64_t>() >= std::numeric_limits<std::int32_t>::min() &&
+                     v.get<std::int64_t>() <= std::numeric_limits<std::int32_t>::max();
+                if (ok) out.timeout_ms = static_cast<std::int32_t>(v.get<std::int64_t>());
+                break;
+            }
+            case wire::kFieldEnable: {
+                ok = v.is_boolean() || (v.is_number_integer() && (v.get<std::int64_t>() == 0 || v.get<std::int64_t>() == 1));
+                if (ok) out.enable = v.is_boolean() ? v.get<bool>() : v.get<std::int64_t>() == 1;
+                break;
+            }
+            default: continue;
+        }
+        if (!ok) return false;
+        out.fields |= field;
+    }
+    return true;
+}
+
+Json kv_to_json(EventDTOUtil::KvMap&& kv) {
+    Json out = Json::object();
+    for (auto& [k, v] : kv) out[k] = std::move(v);
+    return out;
+}
+
 } // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,51 @@
+#include "internal/wakeup_fd.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <thread>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace wxz::workstation::arm_control::internal {
+
+WakeupFd::WakeupFd() : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+WakeupFd::~WakeupFd() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void WakeupFd::notify() {
+    if (fd_ < 0) return;
+    const std::uint64_t one = 1;
+    // EAGAIN 表示计数已饱和：等待方必然会被唤醒，忽略即可。
+    (void)!::write(fd_, &one, sizeof(one));
+}
+
+bool WakeupFd::wait_for(std::chrono::milliseconds timeout) {
+    if (fd_ < 0) {
+        std::this_thread::sleep_for(timeout);
+        return false;
+    }
+
+    pollfd pfd{};
+    pfd.fd = fd_;
+    pfd.events = POLLIN;
+    int rc = 0;
+    do {
+        rc = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc <= 0) return false;
+    drain();
+    return true;
+}
+
+void WakeupFd::drain() {
+    if (fd_ < 0) return;
+    std::uint64_t v = 0;
+    (void)!::read(fd_, &v, sizeof(v));
+}
+
+} // namespace wxz::workstation::arm_control::internal
@@ -0,0 +1,193 @@
+// CmdQueue 争用基准：无锁环（当前实现）与旧 mutex + condition_variable + std::queue 实现的对比。
+//
+// N 个生产者线程（模拟 DDS 回调）并发 push，1 个消费者线程按主循环的方式 pop_for。两种负载：
+// - saturate：生产者不停 push，队列满时计一次拒绝并让出 CPU 后重试；报告吞吐与入队→出队延迟
+// - paced：每个生产者按固定频率 push，队列满时直接丢弃（等同 queue_full）；报告入队→出队延迟
+//
+// 用法：arm_cmd_queue_bench [producers] [messages_per_producer] [queue_max] [paced_rate_hz]
+//       （默认 4 200000 64 2000；paced 每个生产者运行 2 秒）
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "internal/arm_control_internal.h"
+#include "legacy_cmd_queue.h"
+
+namespace arm = wxz::workstation::arm_control::internal;
+
+namespace {
+
+using arm_bench::Clock;
+using arm_bench::now_ns;
+
+constexpr auto kPacedDuration = std::chrono::seconds(2);
+constexpr auto kPopTimeout = std::chrono::milliseconds(10);
+
+// 典型的 moveL 文本指令长度（超出 SSO，push 时与线上一样会发生一次字符串分配）。
+const std::string kPayload =
+    "op=moveL;id=bench;pose=500.125,-12.5,480.0,3.14159,0.0012,-1.5708;speed=50;acc=100;dec=100";
+
+struct Config {
+    std::size_t producers{4};
+    std::size_t messages{200000};
+    std::size_t queue_max{64};
+    std::size_t rate_hz{2000};
+};
+
+struct Result {
+    std::size_t received{0};
+    std::uint64_t rejected{0};
+    double seconds{0.0};
+    arm_bench::LatencySamples latency;
+};
+
+arm::Cmd make_cmd() {
+    arm::Cmd cmd;
+    cmd.raw = kPayload;
+    cmd.rx_ns = now_ns();
+    return cmd;
+}
+
+// 消费者：与主循环一样以 pop_for 阻塞等待；生产者全部结束且队列取空后返回。
+template <class Queue>
+void consume(Queue& q, const std::atomic<bool>& producers_done, Result& out) {
+    std::atomic<bool> running{true};
+    for (;;) {
+        if (auto cmd = q.pop_for(kPopTimeout, running)) {
+            out.latency.add(now_ns() - cmd->rx_ns);
+            ++out.received;
+            continue;
+        }
+        if (producers_done.load(std::memory_order_acquire)) {
+            while (auto cmd = q.try_pop()) {
+                out.latency.add(now_ns() - cmd->rx_ns);
+                ++out.received;
+            }
+            return;
+        }
+    }
+}
+
+template <class Queue>
+Result run_saturate(const Config& cfg) {
+    Queue q(cfg.queue_max);
+    Result res{.latency = arm_bench::LatencySamples(cfg.producers * cfg.messages)};
+    std::atomic<bool> go{false};
+    std::atomic<bool> producers_done{false};
+    std::atomic<std::uint64_t> rejected{0};
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < cfg.producers; ++p) {
+        producers.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::uint64_t local_rejected = 0;
+            for (std::size_t i = 0; i < cfg.messages; ++i) {
+                while (!q.push(make_cmd())) {
+                    ++local_rejected;
+                    std::this_thread::yield();
+                }
+            }
+            rejected.fetch_add(local_rejected);
+        });
+    }
+
+    const auto t0 = Clock::now();
+    std::thread consumer([&] { consume(q, producers_done, res); });
+    go.store(true, std::memory_order_release);
+    for (auto& t : producers) t.join();
+    producers_done.store(true, std::memory_order_release);
+    consumer.join();
+    res.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    res.rejected = rejected.load();
+    return res;
+}
+
+template <class Queue>
+Result run_paced(const Config& cfg) {
+    Queue q(cfg.queue_max);
+    const auto per_producer = static_cast<std::size_t>(cfg.rate_hz * kPacedDuration.count());
+    Result res{.latency = arm_bench::LatencySamples(cfg.producers * per_producer)};
+    std::atomic<bool> producers_done{false};
+    std::atomic<std::uint64_t> rejected{0};
+    const auto period = std::chrono::nanoseconds(1000000000LL / static_cast<long long>(cfg.rate_hz ? cfg.rate_hz : 1));
+    const auto start = Clock::now() + std::chrono::milliseconds(10);
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < cfg.producers; ++p) {
+        producers.emplace_back([&, p] {
+            // 各生产者错开相位，避免所有线程在同一时刻 push。
+            auto next = start + period * p / cfg.producers;
+            for (std::size_t i = 0; i < per_producer; ++i) {
+                std::this_thread::sleep_until(next);
+                if (!q.push(make_cmd())) rejected.fetch_add(1);
+                next += period;
+            }
+        });
+    }
+
+    std::thread consumer([&] { consume(q, producers_done, res); });
+    for (auto& t : producers) t.join();
+    producers_done.store(true, std::memory_order_release);
+    consumer.join();
+    res.seconds = std::chrono::duration<double>(kPacedDuration).count();
+    res.rejected = rejected.load();
+    return res;
+}
+
+void print_saturate(const char* name, Result& r) {
+    std::printf("  %-28s %10.0f msg/s  rejected(retried)=%llu\n", name,
+                r.seconds > 0.0 ? static_cast<double>(r.received) / r.seconds : 0.0,
+                static_cast<unsigned long long>(r.rejected));
+    r.latency.print("  push->pop latency");
+}
+
+void print_paced(const char* name, Result& r) {
+    std::printf("  %-28s received=%zu dropped(queue_full)=%llu\n", name, r.received,
+                static_cast<unsigned long long>(r.rejected));
+    r.latency.print("  push->pop latency");
+}
+
+std::size_t arg_or(int argc, char** argv, int i, std::size_t def) {
+    return argc > i ? static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)) : def;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+    cfg.producers = arg_or(argc, argv, 1, cfg.producers);
+    cfg.messages = arg_or(argc, argv, 2, cfg.messages);
+    cfg.queue_max = arg_or(argc, argv, 3, cfg.queue_max);
+    cfg.rate_hz = arg_or(argc, argv, 4, cfg.rate_hz);
+    if (cfg.producers == 0 || cfg.queue_max == 0 || cfg.rate_hz == 0) {
+        std::fprintf(stderr, "producers, queue_max and paced_rate_hz must be > 0\n");
+        return 2;
+    }
+
+    std::printf("arm_cmd_queue_bench: producers=%zu messages_per_producer=%zu queue_max=%zu paced_rate_hz=%zu\n",
+                cfg.producers, cfg.messages, cfg.queue_max, cfg.rate_hz);
+
+    std::printf("saturate:\n");
+    {
+        auto legacy = run_saturate<arm_legacy::CmdQueue>(cfg);
+        print_saturate("mutex+deque", legacy);
+        auto ring = run_saturate<arm::CmdQueue>(cfg);
+        print_saturate("lock-free ring", ring);
+    }
+
+    std::printf("paced:\n");
+    {
+        auto legacy = run_paced<arm_legacy::CmdQueue>(cfg);
+        print_paced("mutex+deque", legacy);
+        auto ring = run_paced<arm::CmdQueue>(cfg);
+        print_paced("lock-free ring", ring);
+    }
+    return 0;
+}
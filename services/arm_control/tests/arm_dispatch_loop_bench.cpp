@@ -0,0 +1,240 @@
+// 主循环派发延迟基准：旧的 5ms 时间片轮询与当前唤醒驱动循环的对比。
+//
+// 两种循环都用真实的 Executor(threads=0) + Strand（SDK strand 共用主循环线程，即单臂默认布局）、CmdQueue、
+// ArmCommandProcessor 与假 IArmClient（moveL 忙等 sdk_us 模拟 SDK 调用耗时）；生产者线程模拟 DDS 回调定频 push。
+// - slice：每轮取一条指令投递到 strand，再 spin_once(5ms)（改造前的 run()）
+// - wakeup：取空队列（strand 在途上限 2）、非阻塞执行就绪任务，空闲时经 LoopWakeup 阻塞等待（当前 run()）
+// 报告 dispatch（入队→strand 上开始执行）与 turnaround（入队→主循环取到结果）的 p50/p99/p99.9。
+//
+// 用法：arm_dispatch_loop_bench [rate_hz] [seconds] [sdk_us] [burst]（默认 200 3 100 1；每个节拍连续 push burst 条）
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "executor.h"
+#include "logger.h"
+#include "strand.h"
+
+#include "bench_util.h"
+#include "internal/arm_command_processor.h"
+#include "internal/arm_control_internal.h"
+#include "internal/lockfree_queue.h"
+#include "internal/loop_wakeup.h"
+
+namespace arm = wxz::workstation::arm_control::internal;
+
+namespace {
+
+using arm_bench::Clock;
+using arm_bench::now_ns;
+
+constexpr std::size_t kQueueMax = 64;
+constexpr std::size_t kStrandInFlightMax = 2;        // WXZ_ARM_STRAND_INFLIGHT_MAX 默认值
+constexpr std::size_t kMaxReadyTasksPerTurn = 64;    // 与 ArmControlLoop::run 一致
+constexpr auto kSlice = std::chrono::milliseconds(5);
+constexpr auto kIdleWait = std::chrono::milliseconds(200);
+
+struct Config {
+    std::size_t rate_hz{200};
+    std::size_t seconds{3};
+    std::int64_t sdk_us{100};
+    std::size_t burst{1};
+};
+
+class FakeArm final : public arm::IArmClient {
+public:
+    explicit FakeArm(std::int64_t sdk_us) : sdk_ns_(sdk_us * 1000) {}
+
+    CRresult moveL(const std::array<double, 6>&, const std::array<double, 6>&, double, double, double) override {
+        busy();
+        return success;
+    }
+    CRresult moveJ(const std::array<double, 6>&, double) override {
+        busy();
+        return success;
+    }
+    CRresult power_on_enable(wxz::core::Logger const&) override { return success; }
+    CRresult get_robot_mode(int& out_mode) override {
+        out_mode = 0;
+        return success;
+    }
+    CRresult fault_reset() override { return success; }
+    CRresult slow_speed(bool) override { return success; }
+    CRresult quick_stop(bool) override { return success; }
+    CRresult emergency_stop(wxz::core::Logger const&) override { return success; }
+    CRresult path_download(const std::string&, int, int, std::size_t) override { return success; }
+
+private:
+    // 忙等而非 sleep：SDK 调用占住 strand 所在线程，与真实阻塞调用一样推迟主循环的下一轮。
+    void busy() const {
+        const std::int64_t until = now_ns() + sdk_ns_;
+        while (now_ns() < until) {
+        }
+    }
+
+    std::int64_t sdk_ns_;
+};
+
+/// 一次运行的共享状态：生产者线程只 push（及 notify），其余都在主循环线程上。
+struct Bench {
+    explicit Bench(const Config& c)
+        : cfg(c), exec(make_exec()), strand(exec), arm(c.sdk_us), queue(kQueueMax),
+          dispatch(c.rate_hz * c.seconds * c.burst), turnaround(c.rate_hz * c.seconds * c.burst) {
+        (void)exec.start();
+    }
+
+    static wxz::core::Executor::Options make_exec() {
+        wxz::core::Executor::Options opts;
+        opts.threads = 0;
+        return opts;
+    }
+
+    const Config& cfg;
+    wxz::core::Executor exec;
+    wxz::core::Strand strand;
+    wxz::core::Logger& logger{wxz::core::Logger::getInstance()};
+    arm::ArmCommandProcessor processor;
+    FakeArm arm;
+    arm::CmdQueue queue;
+    arm::MpscQueue<std::int64_t> done_q;  // strand 上完成的指令（rx_ns），主循环 drain 时记 turnaround
+
+    std::atomic<bool> producer_done{false};
+    std::atomic<std::size_t> in_flight{0};
+    std::size_t pushed{0};
+    std::size_t rejected{0};
+    std::size_t completed{0};
+    arm_bench::LatencySamples dispatch;
+    arm_bench::LatencySamples turnaround;
+
+    bool finished() const { return producer_done.load(std::memory_order_acquire) && completed == pushed; }
+
+    // strand 任务：记录 dispatch 延迟并执行指令（SDK 调用在 FakeArm 中忙等）。
+    bool post_cmd(arm::Cmd cmd) {
+        in_flight.fetch_add(1, std::memory_order_acq_rel);
+        return strand.post([this, cmd = std::move(cmd)] {
+            dispatch.add(now_ns() - cmd.rx_ns);
+            (void)processor.handle_raw_command(cmd.raw, arm, logger);
+            done_q.push(cmd.rx_ns);
+            in_flight.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    std::size_t drain_done() {
+        return done_q.drain([&](std::int64_t&& rx_ns) {
+            turnaround.add(now_ns() - rx_ns);
+            ++completed;
+        });
+    }
+};
+
+std::string move_cmd(std::size_t i) {
+    return "op=moveL;id=m" + std::to_string(i) + ";pose=500,0,500,3.14,0,0;jointpos=0,0,1.57,0,1.57,0;speed=10";
+}
+
+// 模拟 DDS 回调线程：每个节拍 push burst 条，满则丢弃（等同 queue_full）；notify 为空时不唤醒（旧循环）。
+template <class Notify>
+std::thread start_producer(Bench& b, Notify notify) {
+    return std::thread([&b, notify] {
+        const auto period = std::chrono::nanoseconds(1000000000LL / static_cast<long long>(b.cfg.rate_hz));
+        const std::size_t ticks = b.cfg.rate_hz * b.cfg.seconds;
+        auto next = Clock::now() + std::chrono::milliseconds(20);
+        std::size_t seq = 0;
+        std::size_t pushed = 0;
+        std::size_t rejected = 0;
+        for (std::size_t t = 0; t < ticks; ++t) {
+            std::this_thread::sleep_until(next);
+            next += period;
+            for (std::size_t k = 0; k < b.cfg.burst; ++k) {
+                if (b.queue.push(arm::Cmd{move_cmd(seq++), false, now_ns()})) {
+                    ++pushed;
+                    notify();
+                } else {
+                    ++rejected;
+                }
+            }
+        }
+        b.pushed = pushed;
+        b.rejected = rejected;
+        b.producer_done.store(true, std::memory_order_release);
+        notify();
+    });
+}
+
+// 改造前的 run()：每轮最多派发一条指令，然后在 executor 上等待一个 5ms 时间片。
+void run_slice_loop(Bench& b) {
+    auto producer = start_producer(b, [] {});
+    while (!b.finished()) {
+        (void)b.drain_done();
+        if (auto cmd = b.queue.try_pop()) (void)b.post_cmd(std::move(*cmd));
+        (void)b.exec.spin_once(kSlice);
+    }
+    producer.join();
+}
+
+// 当前 run()：取空所有就绪工作，无工作时才经 LoopWakeup 阻塞等待。
+void run_wakeup_loop(Bench& b) {
+    arm::LoopWakeup wakeup(b.exec);
+    auto producer = start_producer(b, [&wakeup] { wakeup.notify(); });
+    while (!b.finished()) {
+        std::size_t work = b.drain_done();
+        while (b.in_flight.load(std::memory_order_acquire) < kStrandInFlightMax) {
+            auto cmd = b.queue.try_pop();
+            if (!cmd) break;
+            (void)b.post_cmd(std::move(*cmd));
+            ++work;
+        }
+        for (std::size_t i = 0; i < kMaxReadyTasksPerTurn && b.exec.spin_once(std::chrono::milliseconds(0)); ++i) {
+            ++work;
+        }
+        if (work > 0) continue;
+        if (wakeup.begin_idle()) {
+            (void)b.exec.spin_once(kIdleWait);
+            wakeup.end_idle();
+        }
+    }
+    producer.join();
+}
+
+void report(const char* name, Bench& b) {
+    std::printf("%s: pushed=%zu rejected(queue_full)=%zu completed=%zu\n", name, b.pushed, b.rejected, b.completed);
+    b.dispatch.print("dispatch (rx -> strand)");
+    b.turnaround.print("turnaround (rx -> result)");
+}
+
+std::size_t arg_or(int argc, char** argv, int i, std::size_t def) {
+    return argc > i ? static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)) : def;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+    cfg.rate_hz = arg_or(argc, argv, 1, cfg.rate_hz);
+    cfg.seconds = arg_or(argc, argv, 2, cfg.seconds);
+    cfg.sdk_us = static_cast<std::int64_t>(arg_or(argc, argv, 3, static_cast<std::size_t>(cfg.sdk_us)));
+    cfg.burst = arg_or(argc, argv, 4, cfg.burst);
+    if (cfg.rate_hz == 0 || cfg.burst == 0) {
+        std::fprintf(stderr, "rate_hz and burst must be > 0\n");
+        return 2;
+    }
+
+    std::printf("arm_dispatch_loop_bench: rate_hz=%zu seconds=%zu sdk_us=%lld burst=%zu\n", cfg.rate_hz, cfg.seconds,
+                static_cast<long long>(cfg.sdk_us), cfg.burst);
+    {
+        Bench b(cfg);
+        run_slice_loop(b);
+        report("slice (5ms spin_once)", b);
+    }
+    {
+        Bench b(cfg);
+        run_wakeup_loop(b);
+        report("wakeup-driven", b);
+    }
+    return 0;
+}
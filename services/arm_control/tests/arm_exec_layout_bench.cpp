@@ -0,0 +1,293 @@
+// 执行线程布局基准：ExecLane 单线程布局（ingress / SDK strand 都跑在主循环 executor 上）与多线程布局
+// （ingress 与每臂 SDK strand 各自独占线程，可绑核）在同一负载下的尾延迟对比。
+//
+// 负载（两种布局完全相同，按固定节拍生成，可复现）：
+// - 臂 a：约 50% 占空比的阻塞 moveL（SDK 调用 sleep move_ms，模拟等待控制器完成运动）
+// - 臂 b：rate_hz 的短指令（SDK 调用忙等 100us）
+// - 生产者线程模拟 DDS 回调：把原始指令投递到 ingress strand，解析 op 后入对应臂的 CmdQueue 并唤醒主循环
+// - 可选 busy_threads 个后台忙等线程制造 CPU 争用
+// 主循环按 ArmControlLoop::run 的方式取结果、按在途上限派发到各臂 SDK strand、执行就绪任务，空闲时经 LoopWakeup 等待。
+// 报告臂 b 的 dispatch（入 ingress→SDK strand 上开始执行）与 turnaround（→主循环取到结果）的 p50/p99/p99.9。
+//
+// 用法：arm_exec_layout_bench [seconds] [rate_hz] [move_ms] [busy_threads] [cpus]
+//       （默认 3 200 20 0 ""；cpus 为多线程布局下 ingress,sdk-a,sdk-b 的绑核列表，如 "1,2,3"）
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "executor.h"
+#include "logger.h"
+#include "strand.h"
+
+#include "bench_util.h"
+#include "internal/arm_command_processor.h"
+#include "internal/arm_control_internal.h"
+#include "internal/lockfree_queue.h"
+#include "internal/loop_wakeup.h"
+#include "workstation/exec_topology.h"
+
+namespace arm = wxz::workstation::arm_control::internal;
+namespace ws = wxz::workstation;
+
+namespace {
+
+using arm_bench::Clock;
+using arm_bench::now_ns;
+
+constexpr std::size_t kQueueMax = 64;
+constexpr std::size_t kStrandInFlightMax = 2;      // WXZ_ARM_STRAND_INFLIGHT_MAX 默认值
+constexpr std::size_t kMaxReadyTasksPerTurn = 64;  // 与 ArmControlLoop::run 一致
+constexpr auto kIdleWait = std::chrono::milliseconds(200);
+constexpr std::int64_t kShortSdkNs = 100 * 1000;
+
+struct Config {
+    std::size_t seconds{3};
+    std::size_t rate_hz{200};
+    std::size_t move_ms{20};
+    std::size_t busy_threads{0};
+    std::vector<int> cpus;  // ingress, sdk-a, sdk-b
+};
+
+/// moveL：blocking_ms>0 时 sleep（阻塞等待控制器），否则忙等 100us（短 SDK 调用）。
+class FakeArm final : public arm::IArmClient {
+public:
+    explicit FakeArm(std::size_t blocking_ms) : blocking_(std::chrono::milliseconds(blocking_ms)) {}
+
+    CRresult moveL(const std::array<double, 6>&, const std::array<double, 6>&, double, double, double) override {
+        if (blocking_.count() > 0) {
+            std::this_thread::sleep_for(blocking_);
+        } else {
+            const std::int64_t until = now_ns() + kShortSdkNs;
+            while (now_ns() < until) {
+            }
+        }
+        return success;
+    }
+    CRresult moveJ(const std::array<double, 6>&, double) override { return success; }
+    CRresult power_on_enable(wxz::core::Logger const&) override { return success; }
+    CRresult get_robot_mode(int& out_mode) override {
+        out_mode = 0;
+        return success;
+    }
+    CRresult fault_reset() override { return success; }
+    CRresult slow_speed(bool) override { return success; }
+    CRresult quick_stop(bool) override { return success; }
+    CRresult emergency_stop(wxz::core::Logger const&) override { return success; }
+    CRresult path_download(const std::string&, int, int, std::size_t) override { return success; }
+
+private:
+    std::chrono::milliseconds blocking_;
+};
+
+struct Done {
+    std::size_t arm{0};
+    std::int64_t rx_ns{0};
+};
+
+/// 一条臂：CmdQueue + SDK ExecLane。dispatch 样本只在该臂的 SDK strand 上写入。
+struct ArmSide {
+    ArmSide(std::size_t blocking_ms, std::size_t samples) : arm(blocking_ms), queue(kQueueMax), dispatch(samples),
+                                                           turnaround(samples) {}
+
+    FakeArm arm;
+    arm::CmdQueue queue;
+    std::unique_ptr<ws::ExecLane> lane;
+    std::atomic<std::size_t> in_flight{0};
+    std::atomic<std::size_t> pushed{0};
+    std::atomic<std::size_t> rejected{0};
+    std::size_t completed{0};
+    arm_bench::LatencySamples dispatch;
+    arm_bench::LatencySamples turnaround;
+};
+
+struct LayoutResult {
+    std::unique_ptr<ArmSide> a;
+    std::unique_ptr<ArmSide> b;
+};
+
+std::string move_cmd(char arm_id, std::size_t i) {
+    return std::string("op=moveL;id=") + arm_id + std::to_string(i) +
+           ";pose=500,0,500,3.14,0,0;jointpos=0,0,1.57,0,1.57,0;speed=10";
+}
+
+int cpu_at(const Config& cfg, std::size_t i) { return i < cfg.cpus.size() ? cfg.cpus[i] : -1; }
+
+LayoutResult run_layout(const Config& cfg, bool dedicated) {
+    auto& logger = wxz::core::Logger::getInstance();
+    arm::ArmCommandProcessor processor;
+
+    wxz::core::Executor::Options exec_opts;
+    exec_opts.threads = 0;
+    wxz::core::Executor exec(exec_opts);
+    (void)exec.start();
+    arm::LoopWakeup wakeup(exec);
+
+    const std::size_t b_total = cfg.rate_hz * cfg.seconds;
+    LayoutResult res{
+        .a = std::make_unique<ArmSide>(cfg.move_ms, b_total),
+        .b = std::make_unique<ArmSide>(0, b_total),
+    };
+    std::array<ArmSide*, 2> sides{res.a.get(), res.b.get()};
+
+    ws::ExecLane ingress(exec, ws::ExecThreadSpec{.dedicated = dedicated, .cpu = cpu_at(cfg, 0), .name = "ingress"},
+                         logger);
+    res.a->lane = std::make_unique<ws::ExecLane>(
+        exec, ws::ExecThreadSpec{.dedicated = dedicated, .cpu = cpu_at(cfg, 1), .name = "sdk-a"}, logger);
+    res.b->lane = std::make_unique<ws::ExecLane>(
+        exec, ws::ExecThreadSpec{.dedicated = dedicated, .cpu = cpu_at(cfg, 2), .name = "sdk-b"}, logger);
+
+    arm::MpscQueue<Done> done_q;
+    std::atomic<std::size_t> ingress_pending{0};
+    std::atomic<bool> producers_done{false};
+    std::atomic<bool> busy_stop{false};
+
+    std::vector<std::thread> busy;
+    for (std::size_t i = 0; i < cfg.busy_threads; ++i) {
+        busy.emplace_back([&] {
+            while (!busy_stop.load(std::memory_order_relaxed)) {
+            }
+        });
+    }
+
+    // 模拟 DDS 回调：原始指令投递到 ingress strand，在那里解析 op 并入队（等同订阅回调的 ingress 处理）。
+    auto ingest = [&](std::size_t idx, std::string raw, std::int64_t rx_ns) {
+        ingress_pending.fetch_add(1);
+        const bool posted = ingress.strand().post([&, idx, raw = std::move(raw), rx_ns]() mutable {
+            ArmSide& side = *sides[idx];
+            (void)processor.peek_op(raw, false);
+            if (side.queue.push(arm::Cmd{std::move(raw), false, rx_ns})) {
+                side.pushed.fetch_add(1);
+            } else {
+                side.rejected.fetch_add(1);
+            }
+            ingress_pending.fetch_sub(1);
+            wakeup.notify();
+        });
+        if (!posted) ingress_pending.fetch_sub(1);
+    };
+
+    // 臂 b 每个节拍一条；臂 a 每 2*move_ms 一条（约 50% 占空比）。
+    std::thread producer([&] {
+        const auto period = std::chrono::nanoseconds(1000000000LL / static_cast<long long>(cfg.rate_hz));
+        const auto a_period = std::chrono::milliseconds(2 * std::max<std::size_t>(1, cfg.move_ms));
+        const auto start = Clock::now() + std::chrono::milliseconds(20);
+        auto next = start;
+        auto next_a = start;
+        std::size_t a_seq = 0;
+        for (std::size_t i = 0; i < b_total; ++i) {
+            std::this_thread::sleep_until(next);
+            next += period;
+            if (cfg.move_ms > 0 && Clock::now() >= next_a) {
+                ingest(0, move_cmd('a', a_seq++), now_ns());
+                next_a += a_period;
+            }
+            ingest(1, move_cmd('b', i), now_ns());
+        }
+        producers_done.store(true);
+        wakeup.notify();
+    });
+
+    auto dispatch = [&](std::size_t idx) {
+        ArmSide& side = *sides[idx];
+        std::size_t n = 0;
+        while (side.in_flight.load(std::memory_order_acquire) < kStrandInFlightMax) {
+            auto cmd = side.queue.try_pop();
+            if (!cmd) break;
+            ++n;
+            side.in_flight.fetch_add(1, std::memory_order_acq_rel);
+            (void)side.lane->strand().post([&, idx, cmd = std::move(*cmd)] {
+                ArmSide& s = *sides[idx];
+                s.dispatch.add(now_ns() - cmd.rx_ns);
+                (void)processor.handle_raw_command(cmd.raw, s.arm, logger);
+                done_q.push(Done{idx, cmd.rx_ns});
+                s.in_flight.fetch_sub(1, std::memory_order_acq_rel);
+                wakeup.notify();
+            });
+        }
+        return n;
+    };
+
+    auto finished = [&] {
+        if (!producers_done.load() || ingress_pending.load() != 0) return false;
+        for (auto* s : sides) {
+            if (s->completed != s->pushed.load()) return false;
+        }
+        return true;
+    };
+
+    while (!finished()) {
+        std::size_t work = done_q.drain([&](Done&& d) {
+            ArmSide& s = *sides[d.arm];
+            s.turnaround.add(now_ns() - d.rx_ns);
+            ++s.completed;
+        });
+        work += dispatch(0);
+        work += dispatch(1);
+        for (std::size_t i = 0; i < kMaxReadyTasksPerTurn && exec.spin_once(std::chrono::milliseconds(0)); ++i) {
+            ++work;
+        }
+        if (work > 0) continue;
+        if (wakeup.begin_idle()) {
+            (void)exec.spin_once(kIdleWait);
+            wakeup.end_idle();
+        }
+    }
+
+    producer.join();
+    busy_stop.store(true);
+    for (auto& t : busy) t.join();
+    ingress.stop();
+    // 非独占的 lane 建在本函数的 exec 上：在 exec 析构前释放（独占的在此等待线程退出）。
+    for (auto* s : sides) s->lane.reset();
+    return res;
+}
+
+void report(const char* name, LayoutResult& r) {
+    std::printf("%s:\n", name);
+    std::printf("  arm a (blocking moveL): completed=%zu rejected(queue_full)=%zu\n", r.a->completed,
+                r.a->rejected.load());
+    std::printf("  arm b (short cmds):     completed=%zu rejected(queue_full)=%zu\n", r.b->completed,
+                r.b->rejected.load());
+    r.b->dispatch.print("arm b dispatch");
+    r.b->turnaround.print("arm b turnaround");
+}
+
+std::size_t arg_or(int argc, char** argv, int i, std::size_t def) {
+    return argc > i ? static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)) : def;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Config cfg;
+    cfg.seconds = arg_or(argc, argv, 1, cfg.seconds);
+    cfg.rate_hz = arg_or(argc, argv, 2, cfg.rate_hz);
+    cfg.move_ms = arg_or(argc, argv, 3, cfg.move_ms);
+    cfg.busy_threads = arg_or(argc, argv, 4, cfg.busy_threads);
+    if (argc > 5) cfg.cpus = ws::parse_cpu_list(argv[5]);
+    if (cfg.rate_hz == 0) {
+        std::fprintf(stderr, "rate_hz must be > 0\n");
+        return 2;
+    }
+
+    std::printf("arm_exec_layout_bench: seconds=%zu rate_hz=%zu move_ms=%zu busy_threads=%zu cpus=%s\n", cfg.seconds,
+                cfg.rate_hz, cfg.move_ms, cfg.busy_threads, argc > 5 ? argv[5] : "-");
+    {
+        auto r = run_layout(cfg, /*dedicated=*/false);
+        report("single-thread (all strands on the main loop)", r);
+    }
+    {
+        auto r = run_layout(cfg, /*dedicated=*/true);
+        report("multi-thread (dedicated ingress / sdk-a / sdk-b)", r);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// 数值解析基准：from_chars 实现与旧 stod/stoi 实现的单次耗时对比（ns/op，取多轮最小值）。
+//
+// 用法：arm_parse_numeric_bench [iterations]（默认 1000000，每项跑 5 轮）
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#include "internal/arm_control_internal.h"
+#include "legacy_numeric_parse.h"
+
+namespace arm = wxz::workstation::arm_control::internal;
+
+namespace {
+
+constexpr int kRounds = 5;
+
+// 防止结果被优化掉。
+volatile double g_sink = 0.0;
+
+template <class Fn>
+double min_ns_per_op(std::uint64_t iterations, Fn&& fn) {
+    double best = 0.0;
+    for (int r = 0; r < kRounds; ++r) {
+        double acc = 0.0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < iterations; ++i) acc += fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        g_sink = g_sink + acc;
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+template <class T>
+double first(const std::optional<T>& v) {
+    return v ? static_cast<double>(*v) : 0.0;
+}
+
+double first(const std::optional<std::array<double, 6>>& v) { return v ? (*v)[0] : 0.0; }
+
+void report(const char* name, double legacy_ns, double new_ns) {
+    std::printf("  %-22s legacy=%8.1f ns  from_chars=%8.1f ns  speedup=%.2fx\n", name, legacy_ns, new_ns,
+                new_ns > 0.0 ? legacy_ns / new_ns : 0.0);
+}
+
+template <class LegacyFn, class NewFn>
+void bench(const char* name, std::string_view in, std::uint64_t iterations, LegacyFn legacy, NewFn next) {
+    const double a = min_ns_per_op(iterations, [&] { return first(legacy(in)); });
+    const double b = min_ns_per_op(iterations, [&] { return first(next(in)); });
+    report(name, a, b);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::printf("arm_parse_numeric_bench: iterations=%llu rounds=%d\n", static_cast<unsigned long long>(iterations),
+                kRounds);
+
+    // 典型 moveL 负载：pose 与 jointpos 各一条 6 维 CSV。
+    constexpr std::string_view kPose = "500.125,-12.5,480.0,3.14159,0.0012,-1.5708";
+    constexpr std::string_view kJoints = "0.1,-0.5,1.57,0.0,1.5707963,-0.25";
+
+    bench("parse_csv6(pose)", kPose, iterations, arm_legacy::parse_csv6, arm::parse_csv6);
+    bench("parse_csv6(jointpos)", kJoints, iterations, arm_legacy::parse_csv6, arm::parse_csv6);
+    bench("parse_double", "123.456", iterations, arm_legacy::parse_double, arm::parse_double);
+    bench("parse_int", "30000", iterations, arm_legacy::parse_int, arm::parse_int);
+    bench("parse_size", "10000", iterations, arm_legacy::parse_size, arm::parse_size);
+    return 0;
+}
@@ -0,0 +1,277 @@
+// 数值解析（from_chars 实现）与旧 stod/stoi 实现的等价性模糊测试。
+//
+// 用固定种子生成数字/十六进制浮点/特殊值/带前后缀噪声的 token 与 CSV，逐条对比新旧结果。
+// 允许的差异只有提交说明中列出的几类（均为非法输入），其余任何不一致都算失败：
+// - trailing_garbage：CSV token 带尾随字符（"1.5abc"、"1..2"），旧实现按前缀接受，新实现拒绝
+// - underflow：次正规数（及下溢），旧实现因 ERANGE 拒绝，新实现接受
+// - negative_size：parse_size 的负数，旧 stoul 回绕成大数，新实现拒绝
+//
+// 用法：arm_parse_numeric_test [iterations]（默认 200000）
+
+#include <array>
+#include <cctype>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "internal/arm_control_internal.h"
+#include "legacy_numeric_parse.h"
+
+namespace arm = wxz::workstation::arm_control::internal;
+
+namespace {
+
+int g_failures = 0;
+
+struct Counts {
+    std::uint64_t same{0};
+    std::uint64_t trailing_garbage{0};
+    std::uint64_t underflow{0};
+    std::uint64_t negative_size{0};
+};
+
+void fail(const char* what, std::string_view in) {
+    if (g_failures < 20) std::fprintf(stderr, "FAIL: %s input='%.*s'\n", what, static_cast<int>(in.size()), in.data());
+    ++g_failures;
+}
+
+void check(bool cond, const char* what) {
+    if (!cond) fail(what, "");
+}
+
+bool same_double(double a, double b) {
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    return a == b && std::signbit(a) == std::signbit(b);
+}
+
+bool same_double(const std::optional<double>& a, const std::optional<double>& b) {
+    if (!a || !b) return !a && !b;
+    return same_double(*a, *b);
+}
+
+// 次正规数，以及十进制值略低于 DBL_MIN、舍入后恰为 DBL_MIN 的情况（strtod 同样报 ERANGE）。
+bool is_underflow(double v) { return std::fabs(v) <= DBL_MIN; }
+
+std::string_view trim_spaces(std::string_view s) {
+    while (!s.empty() && s.front() == ' ') s.remove_prefix(1);
+    while (!s.empty() && s.back() == ' ') s.remove_suffix(1);
+    return s;
+}
+
+// 旧 parse_csv6 只要求 token 有可解析的前缀（stod 不校验消费长度）。
+bool legacy_prefix_ok(std::string_view tok) {
+    try {
+        (void)std::stod(std::string(tok));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void compare_double(std::string_view in, Counts& c) {
+    const auto a = arm_legacy::parse_double(in);
+    const auto b = arm::parse_double(in);
+    if (same_double(a, b)) {
+        ++c.same;
+    } else if (!a && b && is_underflow(*b)) {
+        ++c.underflow;
+    } else {
+        fail("parse_double differs", in);
+    }
+}
+
+void compare_int(std::string_view in, Counts& c) {
+    const auto a = arm_legacy::parse_int(in);
+    const auto b = arm::parse_int(in);
+    if (a == b) {
+        ++c.same;
+    } else {
+        fail("parse_int differs", in);
+    }
+}
+
+void compare_size(std::string_view in, Counts& c) {
+    const auto a = arm_legacy::parse_size(in);
+    const auto b = arm::parse_size(in);
+    if (a == b) {
+        ++c.same;
+        return;
+    }
+    std::string_view body = in;
+    while (!body.empty() && std::isspace(static_cast<unsigned char>(body.front()))) body.remove_prefix(1);
+    if (a && !b && !body.empty() && body.front() == '-') {
+        ++c.negative_size;
+    } else {
+        fail("parse_size differs", in);
+    }
+}
+
+void compare_csv6(std::string_view in, Counts& c) {
+    const auto a = arm_legacy::parse_csv6(in);
+    const auto b = arm::parse_csv6(in);
+    if (a && b) {
+        for (std::size_t i = 0; i < 6; ++i) {
+            if (!same_double((*a)[i], (*b)[i])) {
+                fail("parse_csv6 value differs", in);
+                return;
+            }
+        }
+        ++c.same;
+        return;
+    }
+    if (!a && !b) {
+        ++c.same;
+        return;
+    }
+
+    // 不一致：按 token（旧实现的切分方式，只看前 6 个）找出可解释的原因。
+    bool garbage = false;
+    bool underflow = false;
+    std::string_view rest = in;
+    for (int i = 0; i < 6; ++i) {
+        const std::size_t end = rest.find(',');
+        const std::string_view tok = trim_spaces(rest.substr(0, end));
+        if (legacy_prefix_ok(tok) && !arm_legacy::parse_double(tok)) garbage = true;
+        const auto v = arm::parse_double(tok);
+        if (v && is_underflow(*v) && !arm_legacy::parse_double(tok)) underflow = true;
+        if (end == std::string_view::npos) break;
+        rest.remove_prefix(end + 1);
+    }
+    if (a && !b && garbage) {
+        ++c.trailing_garbage;
+    } else if (!a && b && underflow) {
+        ++c.underflow;
+    } else {
+        fail("parse_csv6 differs", in);
+    }
+}
+
+class Gen {
+public:
+    explicit Gen(std::uint64_t seed) : rng_(seed) {}
+
+    std::string token() {
+        std::string t;
+        switch (pick(9)) {
+            case 0: t = fmt("%.17g", random_double()); break;
+            case 1: t = fmt("%a", random_double()); break;
+            case 2: t = fmt("%.3f", uniform(-2000.0, 2000.0)); break;
+            case 3: t = std::to_string(static_cast<std::int64_t>(rng_()) >> pick(64)); break;
+            case 4: t = fmt("%ge%d", uniform(1.0, 9.9), static_cast<int>(pick(40)) - 330); break;  // 次正规/下溢附近
+            case 5: t = kSpecials[pick(sizeof(kSpecials) / sizeof(kSpecials[0]))]; break;
+            case 6: t = std::to_string(pick(100000)); break;
+            case 7: t = noise(1 + pick(6)); break;
+            default: t = fmt("%.6g", uniform(-4.0, 4.0)); break;
+        }
+        if (pick(8) == 0) t.insert(0, kPrefixes[pick(sizeof(kPrefixes) / sizeof(kPrefixes[0]))]);
+        if (pick(8) == 0) t += kSuffixes[pick(sizeof(kSuffixes) / sizeof(kSuffixes[0]))];
+        if (pick(16) == 0 && !t.empty()) t[pick(t.size())] = kAlphabet[pick(sizeof(kAlphabet) - 1)];
+        return t;
+    }
+
+    std::string csv() {
+        const std::size_t n = pick(10) == 0 ? 1 + pick(9) : 6;
+        std::string s;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i) s += ',';
+            if (pick(6) == 0) s += ' ';
+            s += token();
+            if (pick(6) == 0) s += ' ';
+        }
+        return s;
+    }
+
+private:
+    static constexpr const char* kSpecials[] = {"inf", "-inf", "nan", "NaN", "infinity", "-0", "0", "1e400",
+                                                "-1e400", "4.9e-324", "2.2250738585072014e-308", "0x1p-1074",
+                                                "0x", ".", "+", "-", "e5", ".5", "5.", "nan(123)"};
+    static constexpr const char* kPrefixes[] = {" ", "\t", "+", "-", "+-", "0x", " +", "\n"};
+    static constexpr const char* kSuffixes[] = {"abc", " ", "\t", ".", "e", "x", ".5", "e+", "p1", ",", "|"};
+    static constexpr char kAlphabet[] = "0123456789+-.eEpPxX abc\t";
+
+    std::size_t pick(std::size_t n) { return static_cast<std::size_t>(rng_() % n); }
+    double uniform(double lo, double hi) { return std::uniform_real_distribution<double>(lo, hi)(rng_); }
+
+    double random_double() {
+        std::uint64_t bits = rng_();
+        double d;
+        static_assert(sizeof(d) == sizeof(bits));
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+
+    std::string noise(std::size_t n) {
+        std::string s;
+        for (std::size_t i = 0; i < n; ++i) s += kAlphabet[pick(sizeof(kAlphabet) - 1)];
+        return s;
+    }
+
+    template <class... A>
+    static std::string fmt(const char* f, A... a) {
+        char buf[64];
+        const int n = std::snprintf(buf, sizeof(buf), f, a...);
+        return std::string(buf, n > 0 ? static_cast<std::size_t>(n) : 0);
+    }
+
+    std::mt19937_64 rng_;
+};
+
+// 提交说明中列出的行为：兼容的前缀与明确的差异。
+void test_documented_cases() {
+    check(arm::parse_double("0x1p3") == 8.0 && arm_legacy::parse_double("0x1p3") == 8.0, "hex float accepted by both");
+    check(arm::parse_double("-0x1.8p1") == -3.0 && arm_legacy::parse_double("-0x1.8p1") == -3.0, "negative hex float");
+    check(arm::parse_double(" +1.5") == 1.5 && arm_legacy::parse_double(" +1.5") == 1.5, "leading space and '+'");
+    check(arm::parse_int("+7") == 7 && arm_legacy::parse_int("+7") == 7, "int with '+'");
+    check(!arm::parse_int("2147483648") && !arm_legacy::parse_int("2147483648"), "int overflow rejected");
+    check(!arm::parse_double("1.5 ") && !arm_legacy::parse_double("1.5 "), "trailing space rejected");
+
+    const auto hex_csv = arm::parse_csv6("0x1p3,1,2,3,4,5");
+    check(hex_csv && (*hex_csv)[0] == 8.0 && arm_legacy::parse_csv6("0x1p3,1,2,3,4,5"), "hex float in csv");
+
+    check(arm_legacy::parse_csv6("1.5abc,0,0,0,0,0") && !arm::parse_csv6("1.5abc,0,0,0,0,0"),
+          "csv trailing garbage: legacy accepts, new rejects");
+    check(arm_legacy::parse_csv6("1..2,0,0,0,0,0") && !arm::parse_csv6("1..2,0,0,0,0,0"),
+          "csv double dot: legacy accepts, new rejects");
+    check(arm_legacy::parse_size("-1") && !arm::parse_size("-1"), "negative size: legacy wraps, new rejects");
+
+    const auto sub = arm::parse_double("4.9e-324");
+    check(sub && *sub > 0.0 && is_underflow(*sub), "subnormal accepted");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    test_documented_cases();
+
+    Gen gen(0x5eed5eedULL);
+    Counts dbl, i32, sz, csv;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        const std::string tok = gen.token();
+        compare_double(tok, dbl);
+        compare_int(tok, i32);
+        compare_size(tok, sz);
+        compare_csv6(gen.csv(), csv);
+    }
+
+    std::printf("arm_parse_numeric_test: iterations=%llu\n", static_cast<unsigned long long>(iterations));
+    std::printf("  parse_double same=%llu underflow=%llu\n", static_cast<unsigned long long>(dbl.same),
+                static_cast<unsigned long long>(dbl.underflow));
+    std::printf("  parse_int    same=%llu\n", static_cast<unsigned long long>(i32.same));
+    std::printf("  parse_size   same=%llu negative_size=%llu\n", static_cast<unsigned long long>(sz.same),
+                static_cast<unsigned long long>(sz.negative_size));
+    std::printf("  parse_csv6   same=%llu trailing_garbage=%llu underflow=%llu\n",
+                static_cast<unsigned long long>(csv.same), static_cast<unsigned long long>(csv.trailing_garbage),
+                static_cast<unsigned long long>(csv.underflow));
+    std::printf("%s\n", g_failures == 0 ? "ok" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+// 优先通道的急停延迟测试：普通队列已满且 SDK 线程被阻塞运动占住时，emergency_stop 仍须在时限内执行。
+//
+// 用假的 IArmClient 模拟同一控制器上的两个会话（主会话执行 moveL 时阻塞，直到控制器收到停止或运动超时），
+// 普通路径按 arm_sdk_strand 的方式串行消费 CmdQueue；emergency_stop 经 ArmPriorityLane 提交。
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "logger.h"
+
+#include "internal/arm_command_processor.h"
+#include "internal/arm_control_internal.h"
+#include "internal/arm_priority_lane.h"
+
+namespace arm = wxz::workstation::arm_control::internal;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kQueueMax = 64;
+constexpr auto kMoveDuration = std::chrono::seconds(5);     // 未被停止时单次 moveL 的阻塞时长
+constexpr auto kStopBound = std::chrono::milliseconds(50);  // 急停从提交到执行的上限
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// 两个会话共享的控制器状态。
+struct FakeController {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool moving{false};
+    bool stopped{false};
+    Clock::time_point stopped_at{};
+};
+
+class FakeArm final : public arm::IArmClient {
+public:
+    explicit FakeArm(FakeController& ctl) : ctl_(ctl) {}
+
+    CRresult moveL(const std::array<double, 6>&, const std::array<double, 6>&, double, double, double) override {
+        std::unique_lock<std::mutex> lock(ctl_.mu);
+        if (ctl_.stopped) return arm::CR_FAILED;
+        ctl_.moving = true;
+        ctl_.cv.notify_all();
+        const bool stopped = ctl_.cv.wait_for(lock, kMoveDuration, [&] { return ctl_.stopped; });
+        ctl_.moving = false;
+        return stopped ? arm::CR_FAILED : success;
+    }
+
+    CRresult moveJ(const std::array<double, 6>&, double) override { return success; }
+    CRresult power_on_enable(wxz::core::Logger const&) override { return success; }
+    CRresult get_robot_mode(int& out_mode) override {
+        out_mode = 0;
+        return success;
+    }
+    CRresult fault_reset() override { return success; }
+    CRresult slow_speed(bool) override { return success; }
+    CRresult quick_stop(bool enable) override { return enable ? stop() : success; }
+    CRresult emergency_stop(wxz::core::Logger const&) override { return stop(); }
+    CRresult path_download(const std::string&, int, int, std::size_t) override { return success; }
+
+private:
+    CRresult stop() {
+        std::lock_guard<std::mutex> lock(ctl_.mu);
+        if (!ctl_.stopped) {
+            ctl_.stopped = true;
+            ctl_.stopped_at = Clock::now();
+        }
+        ctl_.cv.notify_all();
+        return success;
+    }
+
+    FakeController& ctl_;
+};
+
+arm::Cmd make_cmd(std::string raw) {
+    return arm::Cmd{std::move(raw), false, now_ns()};
+}
+
+std::string move_cmd(int i) {
+    return "op=moveL;id=m" + std::to_string(i) +
+           ";pose=500,0,500,3.14,0,0;jointpos=0,0,1.57,0,1.57,0;speed=10";
+}
+
+}  // namespace
+
+int main() {
+    auto& logger = wxz::core::Logger::getInstance();
+    arm::ArmCommandProcessor processor;
+    FakeController ctl;
+    FakeArm primary(ctl);
+    FakeArm priority_session(ctl);
+
+    // 普通路径：单线程串行执行 CmdQueue 中的指令（等价于 arm_sdk_strand）。
+    arm::CmdQueue queue(kQueueMax);
+    std::atomic<bool> running{true};
+    std::thread strand([&] {
+        while (running.load()) {
+            if (auto cmd = queue.pop_for(std::chrono::milliseconds(10), running)) {
+                (void)processor.handle_raw_command(cmd->raw, primary, logger);
+            }
+        }
+    });
+
+    // 第一条 moveL 开始阻塞后把队列填满。
+    (void)queue.push(make_cmd(move_cmd(0)));
+    {
+        std::unique_lock<std::mutex> lock(ctl.mu);
+        if (!ctl.cv.wait_for(lock, std::chrono::seconds(2), [&] { return ctl.moving; })) {
+            std::fprintf(stderr, "FAIL: blocking move did not start\n");
+            running.store(false);
+            strand.join();
+            return 1;
+        }
+    }
+    int queued = 0;
+    while (queue.push(make_cmd(move_cmd(queued + 1)))) ++queued;
+
+    arm::ArmPriorityLane lane(processor, priority_session, primary, arm::ArmPriorityLane::Options{}, logger);
+    std::promise<EventDTOUtil::KvMap> reply;
+    auto reply_fut = reply.get_future();
+    lane.start([&](EventDTOUtil::KvMap kv, bool) { reply.set_value(std::move(kv)); });
+
+    const auto submitted = Clock::now();
+    const bool accepted = lane.submit(make_cmd("op=emergency_stop;id=estop"));
+    const bool replied = reply_fut.wait_for(std::chrono::seconds(2)) == std::future_status::ready;
+
+    Clock::time_point stopped_at;
+    {
+        std::lock_guard<std::mutex> lock(ctl.mu);
+        stopped_at = ctl.stopped_at;
+    }
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(stopped_at - submitted);
+
+    // 收尾：控制器保持停止，积压的 moveL 立即失败，普通路径随即排空。
+    lane.stop();
+    running.store(false);
+    strand.join();
+
+    int failures = 0;
+    auto check = [&](bool cond, const char* what) {
+        if (!cond) {
+            std::fprintf(stderr, "FAIL: %s\n", what);
+            ++failures;
+        }
+    };
+    check(queued >= static_cast<int>(kQueueMax), "command queue not saturated");
+    check(accepted, "priority lane rejected emergency_stop");
+    check(replied, "emergency_stop produced no reply");
+    check(stopped_at != Clock::time_point{}, "emergency_stop did not reach the controller");
+    check(stopped_at == Clock::time_point{} || latency <= kStopBound, "emergency_stop exceeded latency bound");
+    if (replied) {
+        const auto kv = reply_fut.get();
+        auto it = kv.find("ok");
+        check(it != kv.end() && it->second == "1", "emergency_stop reply not ok");
+    }
+
+    std::printf("arm_priority_stop_latency_test: queued=%d latency_us=%lld bound_us=%lld %s\n",
+                queued,
+                static_cast<long long>(latency.count()),
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(kStopBound).count()),
+                failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// 二进制 arm 帧经 EventDTO CDR 编解码的往返测试。
+//
+// v2 指令/status 与 /arm/state 样本都放在 EventDTO.payload（CDR string）里传输；
+// 这里用真实的 encode_event_dto_cdr/decode_event_dto_cdr 验证帧不含 NUL 且能原样还原。
+// 开启 WXZ_ARM_WIRE_V2 前应在目标 Fast-CDR 版本上通过本测试。
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "dto/event_dto.h"
+#include "dto/event_dto_cdr.h"
+#include "workstation/arm_wire.h"
+
+namespace wire = wxz::workstation::arm_control::wire;
+namespace ops = wxz::workstation::arm_control::ops;
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool cond, const char* what) {
+    if (!cond) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++g_failures;
+    }
+}
+
+// payload 经 CDR 往返后取回；失败返回 false。
+bool cdr_roundtrip(std::string_view schema, const std::string& payload, std::string& out) {
+    ::EventDTO dto;
+    dto.version = 1;
+    dto.schema_id = std::string(schema);
+    dto.topic = "/arm/test";
+    dto.payload = payload;
+    dto.source = "arm_wire_dto_roundtrip_test";
+
+    std::vector<std::uint8_t> buf;
+    if (!wxz::dto::encode_event_dto_cdr(dto, buf)) return false;
+    ::EventDTO back;
+    if (!wxz::dto::decode_event_dto_cdr(buf.data(), buf.size(), back)) return false;
+    out = back.payload;
+    return back.schema_id == dto.schema_id;
+}
+
+void test_command() {
+    wire::CommandV2 cmd;
+    cmd.op = ops::ArmOp{};  // 枚举值 0：头部必含 0x00
+    cmd.fields = wire::kFieldPose | wire::kFieldSpeed | wire::kFieldTimeoutMs | wire::kFieldEnable;
+    cmd.id.assign("cmd-1");
+    cmd.pose = {0.0, 0.1, -0.2, 0.0, 3.14159, 0.0};
+    cmd.speed = 0.0;
+    cmd.timeout_ms = 0;
+    cmd.enable = false;
+
+    std::string payload;
+    wire::encode(cmd, payload);
+    check(payload.find('\0') == std::string::npos, "command frame contains NUL");
+
+    std::string back;
+    check(cdr_roundtrip(wire::kCmdSchemaV2, payload, back), "command CDR round trip");
+    check(back == payload, "command payload changed by CDR");
+
+    wire::CommandV2 got;
+    check(wire::decode(back, got), "command decode");
+    check(got.op == cmd.op && got.fields == cmd.fields && got.id.view() == cmd.id.view(), "command header");
+    check(got.pose == cmd.pose && got.speed == cmd.speed && got.timeout_ms == cmd.timeout_ms, "command fields");
+}
+
+void test_status() {
+    wire::StatusV2 st;
+    st.set(wire::StatusV2::kHasOp);
+    st.set(wire::StatusV2::kHasJoints);
+    st.op = ops::ArmOp{};
+    st.id.assign("cmd-1");
+    st.err_code = 0;
+    st.jointpos = {0.0, 0.0, 1.5, 0.0, 0.0, -1.5};
+    st.jointpos_deg = {0.0, 0.0, 85.9, 0.0, 0.0, -85.9};
+
+    std::string payload;
+    wire::encode(st, payload);
+    check(payload.find('\0') == std::string::npos, "status frame contains NUL");
+
+    std::string back;
+    check(cdr_roundtrip(wire::kStatusSchemaV2, payload, back), "status CDR round trip");
+
+    wire::StatusV2 got;
+    check(wire::decode(back, got), "status decode");
+    check(got.flags == st.flags && got.id.view() == st.id.view(), "status header");
+    check(got.jointpos == st.jointpos && got.jointpos_deg == st.jointpos_deg, "status joints");
+}
+
+void test_state() {
+    wire::StateV1 st;
+    st.seq = 1;
+    st.ts_ms = 0;
+    st.mode = 0;
+    st.jointpos = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    std::string payload;
+    wire::encode(st, payload);
+    check(payload.find('\0') == std::string::npos, "state frame contains NUL");
+
+    std::string back;
+    check(cdr_roundtrip(wire::kStateSchemaV1, payload, back), "state CDR round trip");
+
+    wire::StateV1 got;
+    check(wire::decode(back, got), "state decode");
+    check(got.seq == st.seq && got.jointpos == st.jointpos, "state fields");
+}
+
+}  // namespace
+
+int main() {
+    test_command();
+    test_status();
+    test_state();
+    if (g_failures == 0) std::printf("arm_wire_dto_roundtrip_test: ok\n");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// arm_control 基准的公共小工具：steady_clock 时间戳与延迟分位数统计。
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace arm_bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/// 延迟样本（ns）；单线程写入，结束后统一排序取分位数。
+class LatencySamples {
+public:
+    explicit LatencySamples(std::size_t reserve = 0) { ns_.reserve(reserve); }
+
+    void add(std::int64_t ns) { ns_.push_back(ns); }
+    std::size_t count() const { return ns_.size(); }
+
+    /// 打印 p50/p99/p99.9/max（us）；会对样本排序。
+    void print(const char* name) {
+        if (ns_.empty()) {
+            std::printf("  %-28s n=0\n", name);
+            return;
+        }
+        std::sort(ns_.begin(), ns_.end());
+        std::printf("  %-28s n=%-9zu p50=%9.1f us  p99=%9.1f us  p99.9=%9.1f us  max=%9.1f us\n", name, ns_.size(),
+                    us_at(0.50), us_at(0.99), us_at(0.999), static_cast<double>(ns_.back()) / 1e3);
+    }
+
+private:
+    double us_at(double q) const {
+        const auto idx = static_cast<std::size_t>(q * static_cast<double>(ns_.size() - 1));
+        return static_cast<double>(ns_[idx]) / 1e3;
+    }
+
+    std::vector<std::int64_t> ns_;
+};
+
+}  // namespace arm_bench
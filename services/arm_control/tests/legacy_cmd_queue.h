@@ -0,0 +1,62 @@
+#pragma once
+
+// 改用无锁环之前的 CmdQueue 实现（mutex + condition_variable + std::queue，逻辑原样保留），供基准对照。
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <queue>
+
+#include "internal/arm_control_internal.h"
+
+namespace arm_legacy {
+
+using wxz::workstation::arm_control::internal::Cmd;
+
+class CmdQueue {
+public:
+    explicit CmdQueue(std::size_t max_size) : max_size_(max_size) {}
+
+    bool push(Cmd cmd) {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (q_.size() >= max_size_) return false;
+        q_.push(std::move(cmd));
+        cv_.notify_one();
+        return true;
+    }
+
+    std::optional<Cmd> try_pop() {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (q_.empty()) return std::nullopt;
+        Cmd cmd = std::move(q_.front());
+        q_.pop();
+        return cmd;
+    }
+
+    std::optional<Cmd> pop_for(std::chrono::milliseconds timeout, const std::atomic<bool>& running) {
+        return pop_for(timeout, [&] { return running.load(); });
+    }
+
+    std::optional<Cmd> pop_for(std::chrono::milliseconds timeout, const std::function<bool()>& running) {
+        std::unique_lock<std::mutex> lock(mu_);
+        if (!cv_.wait_for(lock, timeout, [&] { return !q_.empty() || !running(); })) {
+            return std::nullopt;
+        }
+        if (q_.empty()) return std::nullopt;
+        Cmd cmd = std::move(q_.front());
+        q_.pop();
+        return cmd;
+    }
+
+private:
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::queue<Cmd> q_;
+    std::size_t max_size_{64};
+};
+
+}  // namespace arm_legacy
@@ -0,0 +1,72 @@
+#pragma once
+
+// 改用 std::from_chars 之前的数值解析实现（原样保留），供等价性测试与基准对照。
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace arm_legacy {
+
+inline std::optional<std::array<double, 6>> parse_csv6(std::string_view s) {
+    std::array<double, 6> out{};
+    std::size_t start = 0;
+    int idx = 0;
+    while (idx < 6) {
+        std::size_t end = s.find(',', start);
+        std::string token(end == std::string_view::npos ? s.substr(start) : s.substr(start, end - start));
+        while (!token.empty() && token.front() == ' ') token.erase(token.begin());
+        while (!token.empty() && token.back() == ' ') token.pop_back();
+        if (token.empty()) return std::nullopt;
+        try {
+            out[static_cast<std::size_t>(idx)] = std::stod(token);
+        } catch (...) {
+            return std::nullopt;
+        }
+        ++idx;
+        if (end == std::string_view::npos) break;
+        start = end + 1;
+    }
+    if (idx != 6) return std::nullopt;
+    return out;
+}
+
+inline std::optional<double> parse_double(std::string_view sv) {
+    const std::string s(sv);
+    try {
+        std::size_t idx = 0;
+        double v = std::stod(s, &idx);
+        if (idx != s.size()) return std::nullopt;
+        return v;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+inline std::optional<int> parse_int(std::string_view sv) {
+    const std::string s(sv);
+    try {
+        std::size_t idx = 0;
+        int v = std::stoi(s, &idx);
+        if (idx != s.size()) return std::nullopt;
+        return v;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+inline std::optional<std::size_t> parse_size(std::string_view sv) {
+    const std::string s(sv);
+    try {
+        std::size_t idx = 0;
+        auto v = static_cast<std::size_t>(std::stoul(s, &idx));
+        if (idx != s.size()) return std::nullopt;
+        return v;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+}  // namespace arm_legacy
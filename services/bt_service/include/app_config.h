@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <string>
 
+#include "workstation/exec_topology.h"
+
 namespace wxz::workstation::bt_service {
 
 /// 机械臂控制相关配置（cmd/status topic 与超时）。
@@ -12,6 +14,12 @@ struct ArmConfig {
     std::string cmd_dto_schema;
     std::string status_dto_topic;
     std::uint64_t timeout_ms{30000};
+    int wire_v2{0};  // 1：能用 ws.arm_command.v2 表达的指令改发二进制负载
+    std::uint64_t retransmit_ms{0};  // >0：等待 status 期间按此周期以同一 id 重发指令（有副作用的指令仅在 arm_control 声明 dedup 后重发）
+
+    // /arm/state 周期状态样本（空 topic 表示不订阅，状态节点始终失败）。
+    std::string state_topic;
+    std::uint64_t state_max_age_ms{500};  // 状态节点可接受的样本最大年龄（按接收时刻计）
 };
 
 /// 系统告警 DTO 发布相关配置。
@@ -55,6 +63,13 @@ struct RpcConfig {
     std::string service_name;
 };
 
+/// 执行线程布局（见 workstation/exec_topology.h）。默认全部由主循环线程驱动。
+struct ExecConfig {
+    wxz::workstation::ExecThreadSpec ingress;  // /arm/status、/arm/state 订阅回调（只写带锁的缓存）
+    wxz::workstation::ExecThreadSpec rpc;      // RPC handler；改动行为树的请求仍移交主循环执行
+    int main_cpu{-1};                          // 主循环（tick）线程绑核；<0 不绑
+};
+
 /// bt_service 总配置。
 struct AppConfig {
     int domain{0};
@@ -73,6 +88,7 @@ struct AppConfig {
     BtConfig bt;
     DtoConfig dto;
     RpcConfig rpc;
+    ExecConfig exec;
 };
 
 /// 从环境变量/默认值加载 bt_service 配置。
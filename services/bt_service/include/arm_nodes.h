@@ -5,33 +5,38 @@
 
 #include <behaviortree_cpp_v3/bt_factory.h>
 
-#include "workstation/node.h"
+#include "workstation/dto_template.h"
 
 namespace wxz::workstation::bt_service {
 
 struct ArmRespCache;
+struct ArmStateCache;
 struct TraceContext;
 
 /// arm_control 相关 BT 节点的依赖集合（topic/schema、发布通道、缓存等）。
 struct ArmNodeDeps {
-    wxz::workstation::EventDtoPublisher* arm_cmd_dto_pub{nullptr};
-    std::string arm_cmd_dto_topic;
-    std::string arm_cmd_dto_schema;
+    /// /arm/command 发布模板（topic/schema/source 已预置）。
+    wxz::workstation::EventDtoTemplate* arm_cmd_pub{nullptr};
+    bool arm_cmd_wire_v2{false};  // 可表达的指令改用 ws.arm_command.v2（其余仍按模板默认 schema 发送 KV）
 
-    wxz::workstation::EventDtoPublisher* system_alert_dto_pub{nullptr};
-    std::string system_alert_dto_topic;
-    std::string system_alert_dto_schema;
-
-    std::string dto_source;
+    /// system alert 发布模板；为空时不发 alert。
+    wxz::workstation::EventDtoTemplate* system_alert_pub{nullptr};
 
     ArmRespCache* arm_cache{nullptr};
     std::uint64_t arm_timeout_ms{30'000};
+    /// >0：等待 /arm/status 期间按此周期以同一 id 重发指令（arm_control 按 id 去重，重复的指令不会再次执行）。
+    std::uint64_t arm_retransmit_ms{0};
     TraceContext* trace_ctx{nullptr};
+
+    /// /arm/state 最新样本；为空时不注册状态节点。
+    ArmStateCache* arm_state{nullptr};
+    std::uint64_t arm_state_max_age_ms{500};
 };
 
-/// 向工厂注册 arm_control 相关 BT 节点。
+/// 向工厂注册 arm_control 相关 BT 节点（按 ops::kOps 描述表逐项生成），
+/// 以及读取 /arm/state 本地缓存的状态节点（ArmState*，不经 /arm/command 往返）。
 ///
-/// deps 通过值传递（内部复制/保存必要字段）。调用方需保证 deps 指针字段在运行期有效。
+/// deps 通过值传递，内部保存为一份只读共享对象供所有节点实例引用。调用方需保证 deps 指针字段在运行期有效。
 void register_arm_control_nodes(BT::BehaviorTreeFactory& factory, ArmNodeDeps deps);
 
 }  // namespace wxz::workstation::bt_service
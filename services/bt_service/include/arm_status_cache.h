@@ -14,6 +14,7 @@ class Strand;
 namespace wxz::workstation::bt_service {
 
 class ArmRespCache;
+struct ArmStateCache;
 
 /// 安装机械臂 status DTO 的订阅回调，并将结果写入 ArmRespCache。
 ///
@@ -29,4 +30,14 @@ std::unique_ptr<wxz::workstation::EventDtoSubscription> install_arm_status_cache
 	std::size_t pool_buffers,
 	ArmRespCache& arm_cache);
 
+/// 安装 /arm/state（ws.arm_state.v1）订阅，把最新样本写入 ArmStateCache。
+///
+/// 并发约束同上；返回的订阅句柄需由调用方持有。
+std::unique_ptr<wxz::workstation::EventDtoSubscription> install_arm_state_cache_updater(
+	wxz::workstation::Node& node,
+	const std::string& state_topic,
+	wxz::core::Strand& ingress_strand,
+	std::size_t dto_max_payload,
+	ArmStateCache& state_cache);
+
 }  // namespace wxz::workstation::bt_service
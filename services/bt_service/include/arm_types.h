@@ -5,9 +5,11 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "dto/event_dto.h"
+#include "workstation/arm_wire.h"
 
 namespace wxz::workstation::bt_service {
 
@@ -36,7 +38,7 @@ struct TraceContext {
 /// 将 trace/request 相关字段写入 DTO KV。
 void fill_trace_fields(EventDTOUtil::KvMap& kv, TraceContext* ctx, const std::string& request_id);
 
-/// 机械臂响应的归一化表示（从 DTO KV 中提取并保留原始 KV）。
+/// 机械臂响应的归一化表示（v1 保留原始 KV 负载，v2 保留解码后的类型化 status）。
 struct ArmResp {
     std::string ok;
     std::string code;
@@ -44,13 +46,31 @@ struct ArmResp {
     std::string err;
     std::string sdk_code;
     std::uint64_t ts_ms{0};
-    EventDTOUtil::KvMap kv;
+
+    /// v1：原始 KV 负载（`k=v;...`）；其它字段由 get_or 按需读取，不预先拆成 map。
+    std::string payload;
+
+    /// v2：解码后的 status（此时 payload 为空）。
+    std::optional<wxz::workstation::arm_control::wire::StatusV2> v2;
+
+    /// 读取响应字段（v1 查原始负载，v2 按需格式化类型化字段）；不存在则返回 def。
+    std::string get_or(std::string_view key, const std::string& def) const;
+
+    /// 由 v2 status 构造（ok/code/err_code/err/sdk_code 按 v1 的文本形式填充）。
+    static ArmResp from_v2(const wxz::workstation::arm_control::wire::StatusV2& st);
 };
 
 /// 以 request_id 为 key 的响应缓存（供 BT 节点查询）。
 struct ArmRespCache {
     std::mutex mu;
     std::unordered_map<std::string, ArmResp> by_id;
+    std::uint64_t last_put_ms{0};  // 最近一次写入的单调时钟时间
+
+    /// 最近一条 /arm/status 是否声明了 dedup（arm_control 启用了按 id 去重，重发指令不会再次执行）。
+    std::atomic<bool> server_dedup{false};
+
+    /// 最近一次收到 /arm/status 的单调时钟时间（尚未收到为 0）。
+    std::uint64_t last_put();
 
     /// 写入一条响应（覆盖同 id 的旧值）。
     void put(const std::string& id, ArmResp r);
@@ -59,13 +79,27 @@ struct ArmRespCache {
     std::optional<ArmResp> get(const std::string& id);
 };
 
+/// /arm/state 最新样本缓存（供状态条件节点本地读取，无需经 /arm/command 往返）。
+struct ArmStateCache {
+    struct Entry {
+        wxz::workstation::arm_control::wire::StateV1 state;
+        std::uint64_t rx_ms{0};  // 接收时刻（单调时钟）
+    };
+
+    std::mutex mu;
+    std::optional<Entry> latest;
+
+    /// 写入一条样本；seq 与 ts_ms 均不比当前新的样本（重复/乱序）被丢弃。
+    void put(const wxz::workstation::arm_control::wire::StateV1& st);
+
+    /// 最新样本；尚未收到时返回 std::nullopt。
+    std::optional<Entry> get();
+};
+
 /// 在 ok 与 err_code 表达冲突时，优先采用 err_code 的成功语义。
 bool prefer_err_code_success(const std::string& ok, const std::string& err_code);
 
 /// 将字符串按“真值”解析（如 "1"/"true" 等）。
 bool is_truthy(const std::string& v);
 
-/// 从 KV 中读取 key；不存在则返回 def。
-std::string kv_get_or(const EventDTOUtil::KvMap& kv, const char* key, const std::string& def);
-
 }  // namespace wxz::workstation::bt_service
@@ -14,6 +14,7 @@ namespace wxz::workstation::bt_service {
 struct AppConfig;
 struct DdsChannels;
 class ArmRespCache;
+struct ArmStateCache;
 struct TraceContext;
 
 }  // namespace wxz::workstation::bt_service
@@ -24,11 +25,17 @@ class Strand;
 
 namespace wxz::workstation::bt_service {
 
+/// setup_arm_control_bt 创建的订阅；持有期间缓存持续更新。
+struct ArmControlSubscriptions {
+    std::unique_ptr<wxz::workstation::EventDtoSubscription> status;
+    std::unique_ptr<wxz::workstation::EventDtoSubscription> state;  // cfg.arm.state_topic 为空时为空
+};
+
 /// 将 arm_control 相关功能“接线”到 BT 系统：
 /// - 创建/注册 BT 节点
-/// - 订阅 arm status 并写入缓存
+/// - 订阅 arm status / arm state 并写入缓存
 /// - 配置 trace 上下文与超时
-std::unique_ptr<wxz::workstation::EventDtoSubscription> setup_arm_control_bt(
+ArmControlSubscriptions setup_arm_control_bt(
     BT::BehaviorTreeFactory& factory,
     const AppConfig& cfg,
     wxz::workstation::Node& node,
@@ -36,6 +43,7 @@ std::unique_ptr<wxz::workstation::EventDtoSubscription> setup_arm_control_bt(
     wxz::core::Strand& arm_status_ingress_strand,
     std::size_t arm_status_pool_buffers,
     ArmRespCache& arm_cache,
+    ArmStateCache& arm_state_cache,
     TraceContext& trace_ctx);
 
 }  // namespace wxz::workstation::bt_service
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "workstation/dto_template.h"
 #include "workstation/node.h"
 
 namespace wxz::workstation::bt_service {
@@ -9,9 +10,17 @@ namespace wxz::workstation::bt_service {
 struct AppConfig;
 
 /// bt_service 使用的 DDS 通道集合（发布/订阅）。
+///
+/// 每个发布器配一个预构建的 DTO 模板；模板只在 BT tick 线程上使用。
 struct DdsChannels {
     std::unique_ptr<wxz::workstation::EventDtoPublisher> arm_cmd_dto_pub;
     std::unique_ptr<wxz::workstation::EventDtoPublisher> system_alert_dto_pub;
+
+    std::unique_ptr<wxz::workstation::EventDtoTemplate> arm_cmd_tpl;
+    std::unique_ptr<wxz::workstation::EventDtoTemplate> system_alert_tpl;
+
+    /// 上报各发布模板的计数（发布数/失败数/堆分配次数）。
+    void report_metrics(const std::string& scope);
 };
 
 /// 根据配置创建 bt_service 所需的 DDS 通道。
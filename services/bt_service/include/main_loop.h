@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "workstation/node.h"
 
 namespace wxz::workstation::bt_service {
@@ -10,8 +12,11 @@ class BtTreeRunner;
 ///
 /// 在循环中按 tick_ms 频率 tick 行为树，并由 node.executor() 统一驱动异步任务（spin_once）。
 /// 该函数通常在 run() 内被调用，直到节点退出/收到停止信号。
+///
+/// on_report 非空时约每秒在循环线程上调用一次（用于汇总上报 metrics）。
 void run_bt_main_loop(wxz::workstation::Node& node,
 					  BtTreeRunner& tree_runner,
-					  int tick_ms);
+					  int tick_ms,
+					  const std::function<void()>& on_report = {});
 
 }  // namespace wxz::workstation::bt_service
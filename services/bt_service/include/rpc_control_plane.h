@@ -2,12 +2,12 @@
 
 #include <memory>
 
+#include "workstation/exec_topology.h"
 #include "workstation/node.h"
 #include "workstation/service.h"
 
 namespace wxz::core {
 class Logger;
-class Strand;
 }  // namespace wxz::core
 
 namespace wxz::workstation::bt_service {
@@ -19,10 +19,12 @@ class BtTreeRunner;
 ///
 /// - 当配置禁用（enable=0）或 start 失败时，返回 nullptr。
 /// - 返回的 server 必须在其依赖对象析构前停止（stop）。
+/// - handler 在 rpc_lane 的 strand 上执行；rpc_lane 独占线程时，改动行为树的请求（bt.reload）
+///   经 node.executor() 移交给主循环线程执行并等待结果，不与 tick 并发。
 std::unique_ptr<wxz::workstation::RpcService> start_bt_rpc_control_plane(const AppConfig& cfg,
                                                                       wxz::workstation::Node& node,
                                                                       BtTreeRunner& tree_runner,
-                                                                      wxz::core::Strand& rpc_strand,
+                                                                      wxz::workstation::ExecLane& rpc_lane,
                                                                       wxz::core::Logger& logger);
 
 }  // namespace wxz::workstation::bt_service
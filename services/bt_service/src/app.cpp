@@ -31,6 +31,7 @@
 #include "node_wiring.h"
 #include "rpc_control_plane.h"
 
+#include "workstation/exec_topology.h"
 #include "workstation/node.h"
 
 namespace {
@@ -207,6 +208,7 @@ static int bt_service_main_impl() {
                    std::to_string(cfg.bt.tick_ms) + " reload_ms=" + std::to_string(cfg.bt.reload_ms));
 
     wxz::workstation::bt_service::ArmRespCache arm_cache;
+    wxz::workstation::bt_service::ArmStateCache arm_state_cache;
     wxz::workstation::bt_service::TraceContext trace_ctx;
 
     // ROS2 风格：订阅回调统一投递到同一个由外部驱动的 Executor。
@@ -215,8 +217,16 @@ static int bt_service_main_impl() {
     exec_opts.threads = 0;
     wxz::core::Executor exec(exec_opts);
     (void)exec.start();
-    wxz::core::Strand arm_status_ingress_strand(exec);
-    wxz::core::Strand rpc_strand(exec);
+
+    // 可选：把 ingress / RPC strand 移到独占线程（可绑核），主循环只剩 tick 与 NodeBase。
+    if (std::string err; !wxz::workstation::place_current_thread(cfg.exec.main_cpu, "bt-main", &err)) {
+        logger.log(wxz::core::LogLevel::Warn, "main thread placement failed: " + err);
+    }
+    wxz::workstation::ExecLane ingress_lane(exec, cfg.exec.ingress, logger);
+    wxz::workstation::ExecLane rpc_lane(exec, cfg.exec.rpc, logger);
+    wxz::core::Strand& arm_status_ingress_strand = ingress_lane.strand();
+    logger.log(wxz::core::LogLevel::Info,
+               "threads ingress=" + ingress_lane.describe() + " rpc=" + rpc_lane.describe());
 
     wxz::workstation::Node node(wxz::workstation::Node::Options{
         wxz::workstation::bt_service::make_bt_node_config(cfg, logger),
@@ -244,25 +254,30 @@ static int bt_service_main_impl() {
         auto channels = wxz::workstation::bt_service::make_dds_channels(cfg, node);
 
         BT::BehaviorTreeFactory factory;
-        auto arm_status_sub = wxz::workstation::bt_service::setup_arm_control_bt(factory,
+        auto arm_subs = wxz::workstation::bt_service::setup_arm_control_bt(factory,
                                              cfg,
                                              node,
                                              channels,
                                              arm_status_ingress_strand,
                                              arm_status_pool_buffers,
                                              arm_cache,
+                                             arm_state_cache,
                                              trace_ctx);
-        (void)arm_status_sub;
+        (void)arm_subs;
 
         auto tree_runner = wxz::workstation::bt_service::make_bt_tree_runner(factory, cfg.bt, logger);
 
-        auto rpc_server = wxz::workstation::bt_service::start_bt_rpc_control_plane(cfg, node, *tree_runner, rpc_strand, logger);
+        auto rpc_server = wxz::workstation::bt_service::start_bt_rpc_control_plane(cfg, node, *tree_runner, rpc_lane, logger);
 
-        wxz::workstation::bt_service::run_bt_main_loop(node, *tree_runner, cfg.bt.tick_ms);
+        wxz::workstation::bt_service::run_bt_main_loop(node, *tree_runner, cfg.bt.tick_ms, [&channels] {
+            channels.report_metrics("workstation_bt_service");
+        });
 
         if (rpc_server) rpc_server->stop();
     }
 
+    rpc_lane.stop();
+    ingress_lane.stop();
     exec.stop();
 
     if (fault_recovery) fault_recovery->stop();
@@ -1,5 +1,6 @@
 #include "app_config.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -17,6 +18,11 @@ AppConfig load_app_config_from_env() {
     cfg.arm.cmd_dto_schema = wxz::core::getenv_str("WXZ_ARM_CMD_DTO_SCHEMA", "ws.arm_command.v1");
     cfg.arm.status_dto_topic = wxz::core::getenv_str("WXZ_P1_ARM_STATUS_TOPIC", "/arm/status");
     cfg.arm.timeout_ms = static_cast<std::uint64_t>(wxz::core::getenv_int("WXZ_ARM_CMD_TIMEOUT_MS", 30000));
+    cfg.arm.wire_v2 = wxz::core::getenv_int("WXZ_ARM_WIRE_V2", 0);
+    cfg.arm.retransmit_ms = static_cast<std::uint64_t>(std::max(0, wxz::core::getenv_int("WXZ_ARM_CMD_RETRANSMIT_MS", 0)));
+    cfg.arm.state_topic = wxz::core::getenv_str("WXZ_ARM_STATE_TOPIC", "/arm/state");
+    cfg.arm.state_max_age_ms =
+        static_cast<std::uint64_t>(std::max(1, wxz::core::getenv_int("WXZ_BT_ARM_STATE_MAX_AGE_MS", 500)));
 
     cfg.dto.source = wxz::core::getenv_str("WXZ_DTO_SOURCE", "workstation_bt_service");
     cfg.dto.max_payload = static_cast<std::size_t>(wxz::core::getenv_int("WXZ_DTO_MAX_PAYLOAD", 8192));
@@ -53,6 +59,10 @@ AppConfig load_app_config_from_env() {
     cfg.rpc.reply_topic = wxz::core::getenv_str("WXZ_BT_RPC_REPLY_TOPIC", "/svc/bt_service/rpc/reply");
     cfg.rpc.service_name = wxz::core::getenv_str("WXZ_BT_RPC_SERVICE_NAME", "workstation_bt_service");
 
+    cfg.exec.ingress = wxz::workstation::exec_thread_spec_from_env("WXZ_BT_INGRESS", "bt-ingress");
+    cfg.exec.rpc = wxz::workstation::exec_thread_spec_from_env("WXZ_BT_RPC", "bt-rpc");
+    cfg.exec.main_cpu = wxz::core::getenv_int("WXZ_BT_MAIN_CPU", -1);
+
     return cfg;
 }
 
@@ -1,412 +1,276 @@
 #include "arm_nodes.h"
 
+#include <array>
+#include <charconv>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 
 #include "service_common.h"
 #include "dto/event_dto.h"
 #include "arm_types.h"
+#include "workstation/arm_ops.h"
+#include "workstation/arm_wire.h"
 
 namespace wxz::workstation::bt_service {
 namespace {
 
-class ArmMoveLAction : public BT::StatefulActionNode {
-public:
-    ArmMoveLAction(const std::string& name,
-                   const BT::NodeConfiguration& config,
-                   wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                   std::string cmd_dto_topic,
-                   std::string cmd_dto_schema,
-                   wxz::workstation::EventDtoPublisher* alert_pub,
-                   std::string alert_topic,
-                   std::string alert_schema,
-                   std::string dto_source,
-                   ArmRespCache* resp_cache,
-                   std::uint64_t timeout_ms,
-                   TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          alert_pub_(alert_pub),
-          alert_topic_(std::move(alert_topic)),
-          alert_schema_(std::move(alert_schema)),
-          dto_source_(std::move(dto_source)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
+namespace ops = wxz::workstation::arm_control::ops;
+namespace wire = wxz::workstation::arm_control::wire;
 
-    static BT::PortsList providedPorts() {
-        return {
-            BT::InputPort<std::string>("pose"),
-            BT::InputPort<std::string>("jointpos"),
-            BT::InputPort<std::string>("speed"),
-            BT::InputPort<std::string>("acc"),
-            BT::InputPort<std::string>("jerk"),
-        };
+const char* arg_type_name(ops::ArgType t) {
+    switch (t) {
+        case ops::ArgType::String: return "string";
+        case ops::ArgType::Bool: return "bool";
+        case ops::ArgType::Int: return "int";
+        case ops::ArgType::Double: return "double";
+        case ops::ArgType::Csv6: return "csv6";
+        case ops::ArgType::Csv6List: return "csv6|csv6|...";
     }
+    return "string";
+}
 
-    BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        deadline_ms_ = now_monotonic_ms() + timeout_ms_;
-        alert_sent_ = false;
+std::string port_description(const ops::ArgDesc& arg) {
+    std::string d = arg_type_name(arg.type);
+    if (arg.required) {
+        d += ", required";
+    } else if (!arg.bt_default.empty()) {
+        d += ", default ";
+        d += arg.bt_default;
+    }
+    return d;
+}
 
-        const std::string pose = getInput<std::string>("pose").value_or("");
-        const std::string jointpos = getInput<std::string>("jointpos").value_or("");
-        const std::string speed = getInput<std::string>("speed").value_or("30");
-        const std::string acc = getInput<std::string>("acc").value_or("30");
-        const std::string jerk = getInput<std::string>("jerk").value_or("60");
+// v2 编码用的文本解析：只接受 arm_control 的 v1 解析同样会接受的写法；
+// 其它写法（如 '+' 前缀、十六进制、多余 token）让整条指令回退为 v1，由 arm_control 给出原有的错误语义。
 
-        if (pose.empty() || jointpos.empty()) {
-            publish_alert_once("E_ARM_BAD_INPUT",
-                               std::string("missing required input: ") + (pose.empty() ? "pose" : "jointpos"),
-                               nullptr);
-            return BT::NodeStatus::FAILURE;
-        }
+std::string_view trim_spaces(std::string_view s) {
+    while (!s.empty() && s.front() == ' ') s.remove_prefix(1);
+    while (!s.empty() && s.back() == ' ') s.remove_suffix(1);
+    return s;
+}
 
-        EventDTOUtil::KvMap kv;
-        kv["op"] = "moveL";
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-        kv["pose"] = pose;
-        kv["jointpos"] = jointpos;
-        kv["speed"] = speed;
-        kv["acc"] = acc;
-        kv["jerk"] = jerk;
+template <class T>
+bool parse_exact(std::string_view s, T& out) {
+    if (s.empty()) return false;
+    const char* const last = s.data() + s.size();
+    const auto [ptr, ec] = std::from_chars(s.data(), last, out);
+    return ec == std::errc{} && ptr == last;
+}
 
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
-        return BT::NodeStatus::RUNNING;
+bool parse_csv6(std::string_view s, std::array<double, 6>& out) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const std::size_t end = s.find(',');
+        if ((end == std::string_view::npos) != (i + 1 == out.size())) return false;
+        if (!parse_exact(trim_spaces(s.substr(0, end)), out[i])) return false;
+        if (end != std::string_view::npos) s.remove_prefix(end + 1);
     }
+    return true;
+}
 
-    BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) {
-            publish_alert_once("E_ARM_TIMEOUT", "timeout waiting for /arm/status", nullptr);
-            return BT::NodeStatus::FAILURE;
+/// 把已解析好的 KV 指令参数转成 v2；有任一字段无法类型化时返回 false。
+bool build_cmd_v2(const ops::OpDesc& op, const std::string& id, const EventDTOUtil::KvMap& kv, wire::CommandV2& cmd) {
+    cmd.op = op.id;
+    if (!cmd.id.assign(id)) return false;
+    for (const auto& arg : op.args) {
+        const auto it = kv.find(std::string(arg.key));
+        if (it == kv.end()) continue;
+        const std::string_view v = it->second;
+        const std::uint16_t field = wire::cmd_field_for(arg.key);
+        bool ok = true;
+        switch (field) {
+            case wire::kFieldPose: ok = parse_csv6(v, cmd.pose); break;
+            case wire::kFieldJointpos: ok = parse_csv6(v, cmd.jointpos); break;
+            case wire::kFieldSpeed: ok = parse_exact(v, cmd.speed); break;
+            case wire::kFieldAcc: ok = parse_exact(v, cmd.acc); break;
+            case wire::kFieldJerk: ok = parse_exact(v, cmd.jerk); break;
+            case wire::kFieldTimeoutMs: ok = parse_exact(v, cmd.timeout_ms); break;
+            case wire::kFieldEnable: cmd.enable = (v == "1" || v == "true"); break;
+            default: ok = false; break;
         }
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        if (prefer_err_code_success(r->ok, r->err_code)) return BT::NodeStatus::SUCCESS;
-        publish_alert_once("E_ARM_EXEC_FAIL", "arm command failed", &(*r));
-        return BT::NodeStatus::FAILURE;
+        if (!ok) return false;
+        cmd.fields |= field;
     }
+    return true;
+}
 
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
+BT::PortsList make_ports(const ops::OpDesc& op) {
+    BT::PortsList ports;
+    for (const auto& arg : op.args) {
+        ports.insert(BT::InputPort<std::string>(std::string(arg.key), port_description(arg)));
     }
-
-private:
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    wxz::workstation::EventDtoPublisher* alert_pub_{nullptr};
-    std::string alert_topic_;
-    std::string alert_schema_;
-    std::string dto_source_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{30'000};
-    TraceContext* trace_ctx_{nullptr};
-
-    std::string id_;
-    std::uint64_t deadline_ms_{0};
-    bool alert_sent_{false};
-
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, dto_source_);
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
+    if (op.bt_timeout_port) {
+        ports.insert(BT::InputPort<std::string>("timeout_ms", "int, overrides node timeout (ms)"));
     }
-
-    void publish_alert_once(const std::string& error_code, const std::string& message, const ArmResp* resp) {
-        if (alert_sent_) return;
-        if (!alert_pub_) return;
-
-        EventDTOUtil::KvMap kv;
-        kv["alert_level"] = "ERROR";
-        kv["node_name"] = name();
-        kv["error_code"] = error_code;
-        kv["message"] = message;
-        kv["op"] = "moveL";
-        kv["id"] = id_;
-        kv["ts_ms"] = std::to_string(wxz::core::now_epoch_ms());
-        fill_trace_fields(kv, trace_ctx_, id_);
-        if (resp) {
-            if (!resp->sdk_code.empty()) kv["sdk_code"] = resp->sdk_code;
-            if (!resp->err_code.empty()) kv["arm_err_code"] = resp->err_code;
-            if (!resp->err.empty()) kv["arm_err"] = resp->err;
-            if (!resp->code.empty()) kv["arm_code"] = resp->code;
-        }
-
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = alert_schema_;
-        dto.topic = alert_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, dto_source_);
-        dto.event_id = id_;
-
-        if (alert_pub_->publish(dto)) {
-            std::cerr << "[workstation_bt_service][INF] arm alert published code=" << error_code
-                      << " op=moveL node=" << name() << " id=" << id_ << "\n";
-        }
-        alert_sent_ = true;
+    for (const auto& f : op.result_fields) {
+        if (f.output_port) ports.insert(BT::OutputPort<std::string>(std::string(f.key)));
     }
-};
+    return ports;
+}
 
-class ArmPowerOnAction : public BT::StatefulActionNode {
+/// 由 ops::OpDesc 驱动的 arm 指令节点：向 /arm/command 下发一条指令，再按 id 等待 /arm/status 响应。
+///
+/// 端口、默认值、成功判定与 alert 码均来自描述表；节点实例只保存自身状态，依赖为所有实例共享的只读对象。
+class ArmOpAction : public BT::StatefulActionNode {
 public:
-    ArmPowerOnAction(const std::string& name,
-                     const BT::NodeConfiguration& config,
-                     wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                     std::string cmd_dto_topic,
-                     std::string cmd_dto_schema,
-                     wxz::workstation::EventDtoPublisher* alert_pub,
-                     std::string alert_topic,
-                     std::string alert_schema,
-                     std::string dto_source,
-                     ArmRespCache* resp_cache,
-                     std::uint64_t timeout_ms,
-                     TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          alert_pub_(alert_pub),
-          alert_topic_(std::move(alert_topic)),
-          alert_schema_(std::move(alert_schema)),
-          dto_source_(std::move(dto_source)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() { return {}; }
+    ArmOpAction(const std::string& name,
+                const BT::NodeConfiguration& config,
+                const ops::OpDesc& op,
+                std::string_view wire_op,
+                std::shared_ptr<const ArmNodeDeps> deps)
+        : BT::StatefulActionNode(name, config)
+        , op_(op)
+        , wire_op_(wire_op)
+        , deps_(std::move(deps))
+        , use_v2_(deps_->arm_cmd_wire_v2 && wire::op_supports_v2(op)) {}
 
     BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
+        if (!deps_->arm_cmd_pub || !deps_->arm_cache) return BT::NodeStatus::FAILURE;
 
         id_ = make_id();
-        deadline_ms_ = now_monotonic_ms() + timeout_ms_;
+        deadline_ms_ = now_monotonic_ms() + timeout_ms();
         alert_sent_ = false;
 
         EventDTOUtil::KvMap kv;
-        kv["op"] = "power_on_enable";
+        kv["op"] = std::string(wire_op_);
         kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
+        fill_trace_fields(kv, deps_->trace_ctx, id_);
+
+        for (const auto& arg : op_.args) {
+            const std::string key(arg.key);
+            const auto in = getInput<std::string>(key);
+            std::string v = in ? *in : std::string(arg.bt_default);
+            if (v.empty()) {
+                if (!arg.required) continue;
+                publish_alert_once("E_ARM_BAD_INPUT", "missing required input: " + key, nullptr);
+                return BT::NodeStatus::FAILURE;
+            }
+            kv[key] = std::move(v);
+        }
 
         if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
+        if (deps_->arm_retransmit_ms > 0) {
+            sent_kv_ = std::move(kv);
+            next_retransmit_ms_ = now_monotonic_ms() + deps_->arm_retransmit_ms;
+        }
         return BT::NodeStatus::RUNNING;
     }
 
     BT::NodeStatus onRunning() override {
         if (now_monotonic_ms() > deadline_ms_) {
-            publish_alert_once("E_ARM_POWER_ON_TIMEOUT", "timeout waiting for /arm/status", nullptr);
+            publish_alert_once(op_.alerts.timeout, "timeout waiting for /arm/status", nullptr);
+            return BT::NodeStatus::FAILURE;
+        }
+        auto r = deps_->arm_cache->get(id_);
+        if (!r) {
+            maybe_retransmit();
+            return BT::NodeStatus::RUNNING;
+        }
+        if (!prefer_err_code_success(r->ok, r->err_code)) {
+            publish_alert_once(op_.alerts.fail, std::string(op_.alerts.fail_message), &(*r));
             return BT::NodeStatus::FAILURE;
         }
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        if (prefer_err_code_success(r->ok, r->err_code)) return BT::NodeStatus::SUCCESS;
-        publish_alert_once("E_ARM_POWER_ON_FAIL", "arm power_on_enable failed", &(*r));
+
+        switch (op_.result) {
+            case ops::ResultKind::Status:
+                return BT::NodeStatus::SUCCESS;
+            case ops::ResultKind::BoolValue:
+                return is_truthy(r->get_or("value", "0")) ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
+            case ops::ResultKind::Fields:
+                return take_result_fields(*r);
+        }
         return BT::NodeStatus::FAILURE;
     }
 
     void onHalted() override {
         id_.clear();
         deadline_ms_ = 0;
+        sent_kv_.clear();
     }
 
 private:
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    wxz::workstation::EventDtoPublisher* alert_pub_{nullptr};
-    std::string alert_topic_;
-    std::string alert_schema_;
-    std::string dto_source_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{30'000};
-    TraceContext* trace_ctx_{nullptr};
+    const ops::OpDesc& op_;
+    std::string_view wire_op_;
+    std::shared_ptr<const ArmNodeDeps> deps_;
+    const bool use_v2_;
 
     std::string id_;
     std::uint64_t deadline_ms_{0};
     bool alert_sent_{false};
-
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, dto_source_);
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
-    }
-
-    void publish_alert_once(const std::string& error_code, const std::string& message, const ArmResp* resp) {
-        if (alert_sent_) return;
-        if (!alert_pub_) return;
-
-        EventDTOUtil::KvMap kv;
-        kv["alert_level"] = "ERROR";
-        kv["node_name"] = name();
-        kv["error_code"] = error_code;
-        kv["message"] = message;
-        kv["op"] = "power_on_enable";
-        kv["id"] = id_;
-        kv["ts_ms"] = std::to_string(wxz::core::now_epoch_ms());
-        fill_trace_fields(kv, trace_ctx_, id_);
-        if (resp) {
-            if (!resp->sdk_code.empty()) kv["sdk_code"] = resp->sdk_code;
-            if (!resp->err_code.empty()) kv["arm_err_code"] = resp->err_code;
-            if (!resp->err.empty()) kv["arm_err"] = resp->err;
-            if (!resp->code.empty()) kv["arm_code"] = resp->code;
+    EventDTOUtil::KvMap sent_kv_;  // 仅启用重发时保留
+    std::uint64_t next_retransmit_ms_{0};
+
+    // 指令或其 status 丢失时以同一 id 重发：arm_control 对已完成的 id 直接重发缓存的 status，对在途的 id 不再执行。
+    // 只有 arm_control 在 status 中声明了 dedup 时才重发有副作用的指令；未声明时（去重关闭或尚未收到任何 status）
+    // 只重发只读查询，避免运动等指令被再次执行。优先通道 op（急停/quickStop/fault_reset）在 arm_control 侧
+    // 不经去重缓存，重发会再次执行，因此始终不重发。
+    void maybe_retransmit() {
+        if (sent_kv_.empty()) return;
+        if (ops::op_is_priority(op_.id)) return;
+        if (!ops::op_is_query(op_.id) && !deps_->arm_cache->server_dedup.load(std::memory_order_relaxed)) return;
+        const std::uint64_t now = now_monotonic_ms();
+        if (now < next_retransmit_ms_) return;
+        next_retransmit_ms_ = now + deps_->arm_retransmit_ms;
+        if (!publish_cmd(sent_kv_)) {
+            std::cerr << "[workstation_bt_service][WRN] " << wire_op_ << " retransmit publish failed id=" << id_ << "\n";
         }
-
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = alert_schema_;
-        dto.topic = alert_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, dto_source_);
-        dto.event_id = id_;
-
-        if (alert_pub_->publish(dto)) {
-            std::cerr << "[workstation_bt_service][INF] arm alert published code=" << error_code
-                      << " op=power_on_enable node=" << name() << " id=" << id_ << "\n";
-        }
-        alert_sent_ = true;
     }
-};
 
-class ArmPathDownloadAction : public BT::StatefulActionNode {
-public:
-    ArmPathDownloadAction(const std::string& name,
-                          const BT::NodeConfiguration& config,
-                          wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                          std::string cmd_dto_topic,
-                          std::string cmd_dto_schema,
-                          wxz::workstation::EventDtoPublisher* alert_pub,
-                          std::string alert_topic,
-                          std::string alert_schema,
-                          std::string dto_source,
-                          ArmRespCache* resp_cache,
-                          std::uint64_t timeout_ms,
-                          TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          alert_pub_(alert_pub),
-          alert_topic_(std::move(alert_topic)),
-          alert_schema_(std::move(alert_schema)),
-          dto_source_(std::move(dto_source)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() {
-        return {
-            BT::InputPort<std::string>("file"),
-            BT::InputPort<std::string>("index"),
-            BT::InputPort<std::string>("moveType"),
-            BT::InputPort<std::string>("maxPoints"),
-        };
-    }
-
-    BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        deadline_ms_ = now_monotonic_ms() + timeout_ms_;
-        alert_sent_ = false;
-
-        EventDTOUtil::KvMap kv;
-        kv["op"] = "path_download";
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-        kv["file"] = getInput<std::string>("file").value_or("");
-        kv["index"] = getInput<std::string>("index").value_or("1");
-        kv["moveType"] = getInput<std::string>("moveType").value_or("1");
-        kv["maxPoints"] = getInput<std::string>("maxPoints").value_or("10000");
-
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
-        return BT::NodeStatus::RUNNING;
-    }
-
-    BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) {
-            publish_alert_once("E_ARM_TIMEOUT", "timeout waiting for /arm/status", nullptr);
-            return BT::NodeStatus::FAILURE;
+    std::uint64_t timeout_ms() const {
+        if (!op_.bt_timeout_port) return deps_->arm_timeout_ms;
+        const auto t = getInput<std::string>("timeout_ms");
+        if (!t || t->empty()) return deps_->arm_timeout_ms;
+        std::uint64_t v = 0;
+        const char* const last = t->data() + t->size();
+        const auto [ptr, ec] = std::from_chars(t->data(), last, v);
+        if (ec != std::errc{} || ptr != last) return deps_->arm_timeout_ms;
+        return v;
+    }
+
+    BT::NodeStatus take_result_fields(const ArmResp& r) {
+        std::string log_line;
+        for (const auto& f : op_.result_fields) {
+            const std::string key(f.key);
+            const std::string v = r.get_or(key, "");
+            if (f.required && v.empty()) return BT::NodeStatus::FAILURE;
+            if (f.output_port) (void)setOutput(key, v);
+            if (!v.empty()) log_line += " " + key + "=" + v;
         }
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        if (prefer_err_code_success(r->ok, r->err_code)) return BT::NodeStatus::SUCCESS;
-        publish_alert_once("E_ARM_EXEC_FAIL", "arm command failed", &(*r));
-        return BT::NodeStatus::FAILURE;
-    }
-
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
+        std::cerr << "[workstation_bt_service][INF] " << wire_op_ << log_line << "\n";
+        return BT::NodeStatus::SUCCESS;
     }
 
-private:
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    wxz::workstation::EventDtoPublisher* alert_pub_{nullptr};
-    std::string alert_topic_;
-    std::string alert_schema_;
-    std::string dto_source_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{60'000};
-    TraceContext* trace_ctx_{nullptr};
-
-    std::string id_;
-    std::uint64_t deadline_ms_{0};
-    bool alert_sent_{false};
-
     bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, dto_source_);
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
+        auto& pub = *deps_->arm_cmd_pub;
+        // v2 不携带 trace_id/request_id（arm_control 不读取；request_id 与 id 相同）。
+        wire::CommandV2 v2;
+        if (use_v2_ && build_cmd_v2(op_, id_, kv, v2)) {
+            wire::encode(v2, pub.begin(wire::kCmdSchemaV2));
+        } else {
+            pub.begin();
+            pub.write_kv(kv);
+        }
+        return pub.publish(id_);
     }
 
-    void publish_alert_once(const std::string& error_code, const std::string& message, const ArmResp* resp) {
+    void publish_alert_once(std::string_view error_code, const std::string& message, const ArmResp* resp) {
         if (alert_sent_) return;
-        if (!alert_pub_) return;
+        if (!deps_->system_alert_pub) return;
+        if (op_.alerts.timeout.empty()) return;
 
         EventDTOUtil::KvMap kv;
         kv["alert_level"] = "ERROR";
         kv["node_name"] = name();
-        kv["error_code"] = error_code;
+        kv["error_code"] = std::string(error_code);
         kv["message"] = message;
-        kv["op"] = "path_download";
+        kv["op"] = std::string(wire_op_);
         kv["id"] = id_;
         kv["ts_ms"] = std::to_string(wxz::core::now_epoch_ms());
-        fill_trace_fields(kv, trace_ctx_, id_);
+        fill_trace_fields(kv, deps_->trace_ctx, id_);
         if (resp) {
             if (!resp->sdk_code.empty()) kv["sdk_code"] = resp->sdk_code;
             if (!resp->err_code.empty()) kv["arm_err_code"] = resp->err_code;
@@ -414,926 +278,148 @@ private:
             if (!resp->code.empty()) kv["arm_code"] = resp->code;
         }
 
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = alert_schema_;
-        dto.topic = alert_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, dto_source_);
-        dto.event_id = id_;
-
-        if (alert_pub_->publish(dto)) {
+        auto& pub = *deps_->system_alert_pub;
+        pub.begin();
+        pub.write_kv(kv);
+        if (pub.publish(id_)) {
             std::cerr << "[workstation_bt_service][INF] arm alert published code=" << error_code
-                      << " op=path_download node=" << name() << " id=" << id_ << "\n";
+                      << " op=" << wire_op_ << " node=" << name() << " id=" << id_ << "\n";
         }
         alert_sent_ = true;
     }
 };
 
-class ArmMoveJAction : public BT::StatefulActionNode {
-public:
-    ArmMoveJAction(const std::string& name,
-                   const BT::NodeConfiguration& config,
-                   wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                   std::string cmd_dto_topic,
-                   std::string cmd_dto_schema,
-                   ArmRespCache* resp_cache,
-                   std::uint64_t timeout_ms,
-                   TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() {
-        return {
-            BT::InputPort<std::string>("jointpos"),
-            BT::InputPort<std::string>("speed"),
-        };
-    }
-
-    BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        deadline_ms_ = now_monotonic_ms() + timeout_ms_;
-
-        EventDTOUtil::KvMap kv;
-        kv["op"] = "moveJoint";
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-        kv["jointpos"] = getInput<std::string>("jointpos").value_or("");
-        kv["speed"] = getInput<std::string>("speed").value_or("3.14");
-
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
-        return BT::NodeStatus::RUNNING;
-    }
-
-    BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) return BT::NodeStatus::FAILURE;
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        return prefer_err_code_success(r->ok, r->err_code) ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
-    }
-
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
-    }
-
-private:
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{30'000};
-    TraceContext* trace_ctx_{nullptr};
-
-    std::string id_;
-    std::uint64_t deadline_ms_{0};
-
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, "workstation_bt_service");
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
-    }
-};
+/// 状态样本在接收后 max_age 内视为新鲜；节点可用 max_age_ms 端口覆盖默认值。
+std::uint64_t state_max_age_ms(const BT::TreeNode& node, const ArmNodeDeps& deps) {
+    const auto t = node.getInput<std::string>("max_age_ms");
+    std::uint64_t v = 0;
+    if (!t || !parse_exact(std::string_view(*t), v) || v == 0) return deps.arm_state_max_age_ms;
+    return v;
+}
 
-class ArmSimpleOpAction : public BT::StatefulActionNode {
+/// 读取 /arm/state 最新样本的条件节点：样本新鲜且 flag 与 expect 一致时 SUCCESS，否则 FAILURE。
+class ArmStateCondition : public BT::ConditionNode {
 public:
-    ArmSimpleOpAction(const std::string& name,
+    ArmStateCondition(const std::string& name,
                       const BT::NodeConfiguration& config,
-                      std::string op,
-                      wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                      std::string cmd_dto_topic,
-                      std::string cmd_dto_schema,
-                      ArmRespCache* resp_cache,
-                      std::uint64_t timeout_ms,
-                      TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          op_(std::move(op)),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() {
-        return {
-            BT::InputPort<std::string>("enable"),
-            BT::InputPort<std::string>("timeout_ms"),
-        };
-    }
-
-    BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        const std::uint64_t timeout = timeout_ms_override_or_default();
-        deadline_ms_ = now_monotonic_ms() + timeout;
-
-        EventDTOUtil::KvMap kv;
-        kv["op"] = op_;
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-        if (const auto enable = getInput<std::string>("enable")) {
-            kv["enable"] = enable.value();
-        }
-        if (const auto t = getInput<std::string>("timeout_ms")) {
-            if (!t->empty()) kv["timeout_ms"] = *t;
-        }
+                      wire::StateV1::Flag flag,
+                      bool expect,
+                      std::shared_ptr<const ArmNodeDeps> deps)
+        : BT::ConditionNode(name, config), flag_(flag), expect_(expect), deps_(std::move(deps)) {}
 
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
-        return BT::NodeStatus::RUNNING;
-    }
-
-    BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) return BT::NodeStatus::FAILURE;
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        return prefer_err_code_success(r->ok, r->err_code) ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
-    }
-
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
+    BT::NodeStatus tick() override {
+        const auto e = deps_->arm_state->get();
+        if (!e || now_monotonic_ms() - e->rx_ms > state_max_age_ms(*this, *deps_)) return BT::NodeStatus::FAILURE;
+        return e->state.has(flag_) == expect_ ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
     }
 
 private:
-    std::string op_;
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{30'000};
-    TraceContext* trace_ctx_{nullptr};
-
-    std::string id_;
-    std::uint64_t deadline_ms_{0};
-
-    std::uint64_t timeout_ms_override_or_default() const {
-        const auto t = getInput<std::string>("timeout_ms");
-        if (!t || t->empty()) return timeout_ms_;
-        try {
-            return static_cast<std::uint64_t>(std::stoull(*t));
-        } catch (...) {
-            return timeout_ms_;
-        }
-    }
-
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, "workstation_bt_service");
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
-    }
+    const wire::StateV1::Flag flag_;
+    const bool expect_;
+    std::shared_ptr<const ArmNodeDeps> deps_;
 };
 
-class ArmBoolQueryAction : public BT::StatefulActionNode {
+/// 从 /arm/state 读取关节角（弧度，格式与 GetJointActualPos 输出一致），替代一次 /arm/command 往返。
+///
+/// 只接受“最近一条 /arm/status 之后收到”的新鲜样本，避免在运动指令完成后读到运动前的位置；
+/// 暂无合适样本时保持 RUNNING，直到 timeout_ms。
+class ArmStateJointPos : public BT::StatefulActionNode {
 public:
-    ArmBoolQueryAction(const std::string& name,
-                       const BT::NodeConfiguration& config,
-                       std::string op,
-                       wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                       std::string cmd_dto_topic,
-                       std::string cmd_dto_schema,
-                       ArmRespCache* resp_cache,
-                       std::uint64_t timeout_ms,
-                       TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          op_(std::move(op)),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() {
-        return {
-            BT::InputPort<std::string>("timeout_ms"),
-        };
-    }
+    ArmStateJointPos(const std::string& name, const BT::NodeConfiguration& config, std::shared_ptr<const ArmNodeDeps> deps)
+        : BT::StatefulActionNode(name, config), deps_(std::move(deps)) {}
 
     BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        const std::uint64_t timeout = timeout_ms_override_or_default();
+        std::uint64_t timeout = deps_->arm_timeout_ms;
+        if (const auto t = getInput<std::string>("timeout_ms")) (void)parse_exact(std::string_view(*t), timeout);
         deadline_ms_ = now_monotonic_ms() + timeout;
-
-        EventDTOUtil::KvMap kv;
-        kv["op"] = op_;
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-        if (const auto t = getInput<std::string>("timeout_ms")) {
-            if (!t->empty()) kv["timeout_ms"] = *t;
-        }
-
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
-        return BT::NodeStatus::RUNNING;
+        return onRunning();
     }
 
     BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) return BT::NodeStatus::FAILURE;
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        if (!prefer_err_code_success(r->ok, r->err_code)) return BT::NodeStatus::FAILURE;
-        const std::string v = kv_get_or(r->kv, "value", "0");
-        return is_truthy(v) ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
-    }
-
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
-    }
-
-private:
-    std::string op_;
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{10'000};
-    TraceContext* trace_ctx_{nullptr};
-
-    std::string id_;
-    std::uint64_t deadline_ms_{0};
-
-    std::uint64_t timeout_ms_override_or_default() const {
-        const auto t = getInput<std::string>("timeout_ms");
-        if (!t || t->empty()) return timeout_ms_;
-        try {
-            return static_cast<std::uint64_t>(std::stoull(*t));
-        } catch (...) {
-            return timeout_ms_;
+        const std::uint64_t now = now_monotonic_ms();
+        if (const auto e = deps_->arm_state->get()) {
+            const bool fresh = now - e->rx_ms <= state_max_age_ms(*this, *deps_);
+            if (fresh && e->rx_ms >= deps_->arm_cache->last_put()) {
+                (void)setOutput("jointpos", wire::format_csv6_fixed(e->state.jointpos));
+                return BT::NodeStatus::SUCCESS;
+            }
+        }
+        if (now > deadline_ms_) {
+            std::cerr << "[workstation_bt_service][WRN] " << name() << " no fresh /arm/state sample before timeout\n";
+            return BT::NodeStatus::FAILURE;
         }
-    }
-
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, "workstation_bt_service");
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
-    }
-};
-
-class ArmGetRobotModeAction : public BT::StatefulActionNode {
-public:
-    ArmGetRobotModeAction(const std::string& name,
-                          const BT::NodeConfiguration& config,
-                          wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                          std::string cmd_dto_topic,
-                          std::string cmd_dto_schema,
-                          ArmRespCache* resp_cache,
-                          std::uint64_t timeout_ms,
-                          TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() {
-        return {
-            BT::OutputPort<std::string>("mode"),
-            BT::InputPort<std::string>("timeout_ms"),
-        };
-    }
-
-    BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        const std::uint64_t timeout = timeout_ms_override_or_default();
-        deadline_ms_ = now_monotonic_ms() + timeout;
-
-        EventDTOUtil::KvMap kv;
-        kv["op"] = "robot_mode";
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
         return BT::NodeStatus::RUNNING;
     }
 
-    BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) return BT::NodeStatus::FAILURE;
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        if (!prefer_err_code_success(r->ok, r->err_code)) return BT::NodeStatus::FAILURE;
-        const std::string mode = kv_get_or(r->kv, "mode", "");
-        (void)setOutput("mode", mode);
-        return BT::NodeStatus::SUCCESS;
-    }
-
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
-    }
+    void onHalted() override { deadline_ms_ = 0; }
 
 private:
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{5'000};
-    TraceContext* trace_ctx_{nullptr};
-
-    std::string id_;
+    std::shared_ptr<const ArmNodeDeps> deps_;
     std::uint64_t deadline_ms_{0};
-
-    std::uint64_t timeout_ms_override_or_default() const {
-        const auto t = getInput<std::string>("timeout_ms");
-        if (!t || t->empty()) return timeout_ms_;
-        try {
-            return static_cast<std::uint64_t>(std::stoull(*t));
-        } catch (...) {
-            return timeout_ms_;
-        }
-    }
-
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, "workstation_bt_service");
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
-    }
 };
 
-class ArmGetJointActualPosAction : public BT::StatefulActionNode {
-public:
-    ArmGetJointActualPosAction(const std::string& name,
-                               const BT::NodeConfiguration& config,
-                               wxz::workstation::EventDtoPublisher* cmd_dto_pub,
-                               std::string cmd_dto_topic,
-                               std::string cmd_dto_schema,
-                               ArmRespCache* resp_cache,
-                               std::uint64_t timeout_ms,
-                               TraceContext* trace_ctx)
-        : BT::StatefulActionNode(name, config),
-          cmd_dto_pub_(cmd_dto_pub),
-          cmd_dto_topic_(std::move(cmd_dto_topic)),
-          cmd_dto_schema_(std::move(cmd_dto_schema)),
-          resp_cache_(resp_cache),
-          timeout_ms_(timeout_ms),
-          trace_ctx_(trace_ctx) {}
-
-    static BT::PortsList providedPorts() {
-        return {
-            BT::OutputPort<std::string>("jointpos"),
-            BT::InputPort<std::string>("timeout_ms"),
-        };
-    }
-
-    BT::NodeStatus onStart() override {
-        if (!cmd_dto_pub_ || !resp_cache_) return BT::NodeStatus::FAILURE;
-
-        id_ = make_id();
-        const std::uint64_t timeout = timeout_ms_override_or_default();
-        deadline_ms_ = now_monotonic_ms() + timeout;
-
-        EventDTOUtil::KvMap kv;
-        kv["op"] = "get_joint_actual_pos";
-        kv["id"] = id_;
-        fill_trace_fields(kv, trace_ctx_, id_);
-
-        if (!publish_cmd(kv)) return BT::NodeStatus::FAILURE;
-        return BT::NodeStatus::RUNNING;
-    }
-
-    BT::NodeStatus onRunning() override {
-        if (now_monotonic_ms() > deadline_ms_) return BT::NodeStatus::FAILURE;
-        auto r = resp_cache_->get(id_);
-        if (!r) return BT::NodeStatus::RUNNING;
-        if (!prefer_err_code_success(r->ok, r->err_code)) return BT::NodeStatus::FAILURE;
-
-        const std::string jointpos = kv_get_or(r->kv, "jointpos", "");
-        if (jointpos.empty()) return BT::NodeStatus::FAILURE;
-        (void)setOutput("jointpos", jointpos);
-        const std::string jointpos_deg = kv_get_or(r->kv, "jointpos_deg", "");
-        std::cerr << "[workstation_bt_service][INF] get_joint_actual_pos jointpos(rad)=" << jointpos;
-        if (!jointpos_deg.empty()) std::cerr << " jointpos_deg=" << jointpos_deg;
-        std::cerr << "\n";
-        return BT::NodeStatus::SUCCESS;
-    }
-
-    void onHalted() override {
-        id_.clear();
-        deadline_ms_ = 0;
-    }
-
-private:
-    wxz::workstation::EventDtoPublisher* cmd_dto_pub_{nullptr};
-    std::string cmd_dto_topic_;
-    std::string cmd_dto_schema_;
-
-    ArmRespCache* resp_cache_{nullptr};
-    std::uint64_t timeout_ms_{5'000};
-    TraceContext* trace_ctx_{nullptr};
+struct StateConditionDesc {
+    const char* id;
+    wire::StateV1::Flag flag;
+    bool expect;
+};
 
-    std::string id_;
-    std::uint64_t deadline_ms_{0};
+inline constexpr StateConditionDesc kStateConditions[] = {
+    {"ArmStateIsMoving", wire::StateV1::kMoving, true},
+    {"ArmStateIsReady", wire::StateV1::kReady, true},
+    {"ArmStateIsPowerOn", wire::StateV1::kPowered, true},
+    {"ArmStateStartSignal", wire::StateV1::kStartDi, true},
+    {"ArmStateStopSignal", wire::StateV1::kStopDi, true},
+    {"ArmStateTrajectoryComplete", wire::StateV1::kPathRunning, false},
+};
 
-    std::uint64_t timeout_ms_override_or_default() const {
-        const auto t = getInput<std::string>("timeout_ms");
-        if (!t || t->empty()) return timeout_ms_;
-        try {
-            return static_cast<std::uint64_t>(std::stoull(*t));
-        } catch (...) {
-            return timeout_ms_;
-        }
+void register_arm_state_nodes(BT::BehaviorTreeFactory& factory, const std::shared_ptr<const ArmNodeDeps>& deps_sp) {
+    const BT::PortInfo max_age_port = BT::InputPort<std::string>("max_age_ms", "int, overrides sample max age (ms)").second;
+    for (const auto& c : kStateConditions) {
+        BT::TreeNodeManifest manifest;
+        manifest.type = BT::NodeType::CONDITION;
+        manifest.registration_ID = c.id;
+        manifest.ports.insert({"max_age_ms", max_age_port});
+        factory.registerBuilder(manifest, [deps_sp, c](const std::string& name, const BT::NodeConfiguration& config) {
+            return std::make_unique<ArmStateCondition>(name, config, c.flag, c.expect, deps_sp);
+        });
     }
 
-    bool publish_cmd(const EventDTOUtil::KvMap& kv) {
-        ::EventDTO dto;
-        dto.version = 1;
-        dto.schema_id = cmd_dto_schema_;
-        dto.topic = cmd_dto_topic_;
-        dto.payload = EventDTOUtil::buildPayloadKv(kv);
-        EventDTOUtil::fillMeta(dto, "workstation_bt_service");
-        dto.event_id = kv.count("id") ? kv.at("id") : "";
-
-        return cmd_dto_pub_->publish(dto);
-    }
-};
+    BT::TreeNodeManifest manifest;
+    manifest.type = BT::NodeType::ACTION;
+    manifest.registration_ID = "ArmStateJointPos";
+    manifest.ports.insert({"max_age_ms", max_age_port});
+    manifest.ports.insert(BT::InputPort<std::string>("timeout_ms", "int, overrides node timeout (ms)"));
+    manifest.ports.insert(BT::OutputPort<std::string>("jointpos"));
+    factory.registerBuilder(manifest, [deps_sp](const std::string& name, const BT::NodeConfiguration& config) {
+        return std::make_unique<ArmStateJointPos>(name, config, deps_sp);
+    });
+}
 
 }  // namespace
 
 void register_arm_control_nodes(BT::BehaviorTreeFactory& factory, ArmNodeDeps deps) {
-    auto deps_sp = std::make_shared<ArmNodeDeps>(std::move(deps));
-    const std::uint64_t timeout_ms = deps_sp->arm_timeout_ms;
-
-    factory.registerBuilder<ArmPowerOnAction>(
-        "ArmPowerOn",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmPowerOnAction>(name,
-                                                      config,
-                                                      deps_sp->arm_cmd_dto_pub,
-                                                      deps_sp->arm_cmd_dto_topic,
-                                                      deps_sp->arm_cmd_dto_schema,
-                                                      deps_sp->system_alert_dto_pub,
-                                                      deps_sp->system_alert_dto_topic,
-                                                      deps_sp->system_alert_dto_schema,
-                                                      deps_sp->dto_source,
-                                                      deps_sp->arm_cache,
-                                                      timeout_ms,
-                                                      deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmPowerOnAction>(
-        "PowerOn",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmPowerOnAction>(name,
-                                                      config,
-                                                      deps_sp->arm_cmd_dto_pub,
-                                                      deps_sp->arm_cmd_dto_topic,
-                                                      deps_sp->arm_cmd_dto_schema,
-                                                      deps_sp->system_alert_dto_pub,
-                                                      deps_sp->system_alert_dto_topic,
-                                                      deps_sp->system_alert_dto_schema,
-                                                      deps_sp->dto_source,
-                                                      deps_sp->arm_cache,
-                                                      timeout_ms,
-                                                      deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmPowerOnAction>(
-        "power_on_enable",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmPowerOnAction>(name,
-                                                      config,
-                                                      deps_sp->arm_cmd_dto_pub,
-                                                      deps_sp->arm_cmd_dto_topic,
-                                                      deps_sp->arm_cmd_dto_schema,
-                                                      deps_sp->system_alert_dto_pub,
-                                                      deps_sp->system_alert_dto_topic,
-                                                      deps_sp->system_alert_dto_schema,
-                                                      deps_sp->dto_source,
-                                                      deps_sp->arm_cache,
-                                                      timeout_ms,
-                                                      deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmPowerOnAction>(
-        "InitializeArm",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmPowerOnAction>(name,
-                                                      config,
-                                                      deps_sp->arm_cmd_dto_pub,
-                                                      deps_sp->arm_cmd_dto_topic,
-                                                      deps_sp->arm_cmd_dto_schema,
-                                                      deps_sp->system_alert_dto_pub,
-                                                      deps_sp->system_alert_dto_topic,
-                                                      deps_sp->system_alert_dto_schema,
-                                                      deps_sp->dto_source,
-                                                      deps_sp->arm_cache,
-                                                      timeout_ms,
-                                                      deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveLAction>(
-        "ArmMoveL",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveLAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->system_alert_dto_pub,
-                                                    deps_sp->system_alert_dto_topic,
-                                                    deps_sp->system_alert_dto_schema,
-                                                    deps_sp->dto_source,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveLAction>(
-        "MoveL",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveLAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->system_alert_dto_pub,
-                                                    deps_sp->system_alert_dto_topic,
-                                                    deps_sp->system_alert_dto_schema,
-                                                    deps_sp->dto_source,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveLAction>(
-        "moveL",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveLAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->system_alert_dto_pub,
-                                                    deps_sp->system_alert_dto_topic,
-                                                    deps_sp->system_alert_dto_schema,
-                                                    deps_sp->dto_source,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveJAction>(
-        "ArmMoveJ",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveJAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveJAction>(
-        "MoveJ",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveJAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveJAction>(
-        "moveJ",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveJAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmMoveJAction>(
-        "moveJoint",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmMoveJAction>(name,
-                                                    config,
-                                                    deps_sp->arm_cmd_dto_pub,
-                                                    deps_sp->arm_cmd_dto_topic,
-                                                    deps_sp->arm_cmd_dto_schema,
-                                                    deps_sp->arm_cache,
-                                                    timeout_ms,
-                                                    deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmPathDownloadAction>(
-        "ArmPathDownload",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmPathDownloadAction>(name,
-                                                           config,
-                                                           deps_sp->arm_cmd_dto_pub,
-                                                           deps_sp->arm_cmd_dto_topic,
-                                                           deps_sp->arm_cmd_dto_schema,
-                                                           deps_sp->system_alert_dto_pub,
-                                                           deps_sp->system_alert_dto_topic,
-                                                           deps_sp->system_alert_dto_schema,
-                                                           deps_sp->dto_source,
-                                                           deps_sp->arm_cache,
-                                                           timeout_ms,
-                                                           deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmPathDownloadAction>(
-        "path_download",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmPathDownloadAction>(name,
-                                                           config,
-                                                           deps_sp->arm_cmd_dto_pub,
-                                                           deps_sp->arm_cmd_dto_topic,
-                                                           deps_sp->arm_cmd_dto_schema,
-                                                           deps_sp->system_alert_dto_pub,
-                                                           deps_sp->system_alert_dto_topic,
-                                                           deps_sp->system_alert_dto_schema,
-                                                           deps_sp->dto_source,
-                                                           deps_sp->arm_cache,
-                                                           timeout_ms,
-                                                           deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "fault_reset",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "fault_reset",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "FaultReset",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "fault_reset",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "reset_system",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "reset_system",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "ResetSystem",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "reset_system",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "slow_speed",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "slow_speed",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "slowSpeed",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "slowSpeed",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "quick_stop",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "quick_stop",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "quickStop",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "quickStop",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "emergency_stop",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "emergency_stop",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmSimpleOpAction>(
-        "EmergencyStop",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmSimpleOpAction>(name,
-                                                       config,
-                                                       "emergency_stop",
-                                                       deps_sp->arm_cmd_dto_pub,
-                                                       deps_sp->arm_cmd_dto_topic,
-                                                       deps_sp->arm_cmd_dto_schema,
-                                                       deps_sp->arm_cache,
-                                                       timeout_ms,
-                                                       deps_sp->trace_ctx);
-        });
-
-    auto reg_bool = [&factory, deps_sp, timeout_ms](const char* name, const char* op) {
-        const std::string op_s(op);
-        factory.registerBuilder<ArmBoolQueryAction>(
-            name,
-            [deps_sp, timeout_ms, op_s](const std::string& n, const BT::NodeConfiguration& config) {
-                return std::make_unique<ArmBoolQueryAction>(n,
-                                                            config,
-                                                            op_s,
-                                                            deps_sp->arm_cmd_dto_pub,
-                                                            deps_sp->arm_cmd_dto_topic,
-                                                            deps_sp->arm_cmd_dto_schema,
-                                                            deps_sp->arm_cache,
-                                                            timeout_ms,
-                                                            deps_sp->trace_ctx);
-            });
-    };
-
-    reg_bool("IsArmReady", "is_arm_ready");
-    reg_bool("IsPowerOn", "is_power_on");
-    reg_bool("IsStartSignal", "is_start_signal");
-    reg_bool("IsStopSignal", "is_stop_signal");
-    reg_bool("IsTrajectoryComplete", "is_trajectory_complete");
-    reg_bool("IsAllTrajectoriesComplete", "is_all_trajectories_complete");
-
-    reg_bool("wait_for_start", "wait_for_start");
-    reg_bool("WaitForStart", "wait_for_start");
-
-    reg_bool("execute_trajectory", "execute_trajectory");
-    reg_bool("ExecuteTrajectory", "execute_trajectory");
-
-    factory.registerBuilder<ArmGetRobotModeAction>(
-        "get_robot_mode",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmGetRobotModeAction>(name,
-                                                           config,
-                                                           deps_sp->arm_cmd_dto_pub,
-                                                           deps_sp->arm_cmd_dto_topic,
-                                                           deps_sp->arm_cmd_dto_schema,
-                                                           deps_sp->arm_cache,
-                                                           timeout_ms,
-                                                           deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmGetRobotModeAction>(
-        "GetRobotMode",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmGetRobotModeAction>(name,
-                                                           config,
-                                                           deps_sp->arm_cmd_dto_pub,
-                                                           deps_sp->arm_cmd_dto_topic,
-                                                           deps_sp->arm_cmd_dto_schema,
-                                                           deps_sp->arm_cache,
-                                                           timeout_ms,
-                                                           deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmGetJointActualPosAction>(
-        "get_joint_actual_pos",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmGetJointActualPosAction>(name,
-                                                                config,
-                                                                deps_sp->arm_cmd_dto_pub,
-                                                                deps_sp->arm_cmd_dto_topic,
-                                                                deps_sp->arm_cmd_dto_schema,
-                                                                deps_sp->arm_cache,
-                                                                timeout_ms,
-                                                                deps_sp->trace_ctx);
-        });
-
-    factory.registerBuilder<ArmGetJointActualPosAction>(
-        "GetJointActualPos",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmGetJointActualPosAction>(name,
-                                                                config,
-                                                                deps_sp->arm_cmd_dto_pub,
-                                                                deps_sp->arm_cmd_dto_topic,
-                                                                deps_sp->arm_cmd_dto_schema,
-                                                                deps_sp->arm_cache,
-                                                                timeout_ms,
-                                                                deps_sp->trace_ctx);
-        });
+    auto deps_sp = std::make_shared<const ArmNodeDeps>(std::move(deps));
+
+    // 每个 op 的每个 BT 注册名都生成同一种节点；端口清单按 op 只构建一次。
+    for (const auto& op : ops::kOps) {
+        if (op.bt_nodes.size == 0) continue;
+        const BT::PortsList ports = make_ports(op);
+        for (const auto& node : op.bt_nodes) {
+            BT::TreeNodeManifest manifest;
+            manifest.type = BT::NodeType::ACTION;
+            manifest.registration_ID = std::string(node.id);
+            manifest.ports = ports;
+            factory.registerBuilder(
+                manifest,
+                [deps_sp, op_ptr = &op, wire_op = node.wire_op](const std::string& name,
+                                                                 const BT::NodeConfiguration& config) {
+                    return std::make_unique<ArmOpAction>(name, config, *op_ptr, wire_op, deps_sp);
+                });
+        }
+    }
 
-    factory.registerBuilder<ArmGetJointActualPosAction>(
-        "ArmGetJointActualPos",
-        [deps_sp, timeout_ms](const std::string& name, const BT::NodeConfiguration& config) {
-            return std::make_unique<ArmGetJointActualPosAction>(name,
-                                                                config,
-                                                                deps_sp->arm_cmd_dto_pub,
-                                                                deps_sp->arm_cmd_dto_topic,
-                                                                deps_sp->arm_cmd_dto_schema,
-                                                                deps_sp->arm_cache,
-                                                                timeout_ms,
-                                                                deps_sp->trace_ctx);
-        });
+    if (deps_sp->arm_state && deps_sp->arm_cache) register_arm_state_nodes(factory, deps_sp);
 }
 
 }  // namespace wxz::workstation::bt_service
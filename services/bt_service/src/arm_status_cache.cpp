@@ -9,6 +9,8 @@
 #include "strand.h"
 #include "arm_types.h"
 #include "service_common.h"
+#include "workstation/arm_wire.h"
+#include "workstation/kv_view.h"
 
 namespace wxz::workstation::bt_service {
 
@@ -30,22 +32,59 @@ std::unique_ptr<wxz::workstation::EventDtoSubscription> install_arm_status_cache
         status_dto_topic,
         status_dto_schema,
         [&](const ::EventDTO& dto) {
-        auto kv = EventDTOUtil::parsePayloadKv(dto.payload);
+        namespace wire = wxz::workstation::arm_control::wire;
+        if (dto.schema_id == wire::kStatusSchemaV2) {
+            wire::StatusV2 st;
+            if (!wire::decode(dto.payload, st)) return;
+            ArmResp r = ArmResp::from_v2(st);
+            r.ts_ms = now_monotonic_ms();
+            arm_cache.server_dedup.store(st.has(wire::StatusV2::kDedup), std::memory_order_relaxed);
+            const std::string id = st.id.view().empty() ? dto.event_id : std::string(st.id.view());
+            arm_cache.put(id, std::move(r));
+            return;
+        }
 
-        if (!kv.count("id")) kv["id"] = dto.event_id;
-        const auto it_id = kv.find("id");
-        if (it_id == kv.end()) return;
+        // 在 DTO 缓冲区上直接切分；只有写入缓存的字段才拷贝成拥有型字符串。
+        const wxz::workstation::KvView kv(dto.payload);
+        const std::string id(kv.get("id", dto.event_id));
 
         ArmResp r;
-        r.ok = kv.count("ok") ? kv["ok"] : "0";
-        r.code = kv.count("code") ? kv["code"] : "";
-        r.err_code = kv.count("err_code") ? kv["err_code"] : "";
-        r.err = kv.count("err") ? kv["err"] : "";
-        r.sdk_code = kv.count("sdk_code") ? kv["sdk_code"] : "";
+        r.ok = std::string(kv.get("ok", "0"));
+        r.code = std::string(kv.get("code"));
+        r.err_code = std::string(kv.get("err_code"));
+        r.err = std::string(kv.get("err"));
+        r.sdk_code = std::string(kv.get("sdk_code"));
         r.ts_ms = now_monotonic_ms();
-        r.kv = std::move(kv);
+        r.payload = dto.payload;
+        arm_cache.server_dedup.store(kv.get("dedup") == "1", std::memory_order_relaxed);
 
-        arm_cache.put(it_id->second, std::move(r));
+        arm_cache.put(id, std::move(r));
+        },
+        std::move(opts));
+}
+
+std::unique_ptr<wxz::workstation::EventDtoSubscription> install_arm_state_cache_updater(
+    wxz::workstation::Node& node,
+    const std::string& state_topic,
+    wxz::core::Strand& ingress_strand,
+    std::size_t dto_max_payload,
+    ArmStateCache& state_cache) {
+    namespace wire = wxz::workstation::arm_control::wire;
+
+    wxz::workstation::EventDtoSubscription::Options opts;
+    opts.qos = wxz::core::default_reliable_qos();
+    opts.dto_max_payload = dto_max_payload;
+    // 只保留最新样本：少量缓冲即可。
+    opts.pool_buffers = 8;
+
+    return node.create_subscription_eventdto_on(
+        ingress_strand,
+        state_topic,
+        std::string(wire::kStateSchemaV1),
+        [&](const ::EventDTO& dto) {
+            wire::StateV1 st;
+            if (!wire::decode(dto.payload, st)) return;
+            state_cache.put(st);
         },
         std::move(opts));
 }
@@ -5,6 +5,8 @@
 #include <iterator>
 #include <random>
 
+#include "workstation/kv_view.h"
+
 namespace wxz::workstation::bt_service {
 
 std::uint64_t now_monotonic_ms() {
@@ -46,6 +48,7 @@ void fill_trace_fields(EventDTOUtil::KvMap& kv, TraceContext* ctx, const std::st
 
 void ArmRespCache::put(const std::string& id, ArmResp r) {
     std::lock_guard<std::mutex> lock(mu);
+    last_put_ms = r.ts_ms;
     by_id[id] = std::move(r);
     if (by_id.size() > 256) {
         const std::uint64_t cutoff = now_monotonic_ms() - 30'000;
@@ -63,6 +66,23 @@ std::optional<ArmResp> ArmRespCache::get(const std::string& id) {
     return it->second;
 }
 
+std::uint64_t ArmRespCache::last_put() {
+    std::lock_guard<std::mutex> lock(mu);
+    return last_put_ms;
+}
+
+void ArmStateCache::put(const wxz::workstation::arm_control::wire::StateV1& st) {
+    std::lock_guard<std::mutex> lock(mu);
+    // arm_control 重启后 seq 从 1 重新计数，此时以更新的 ts_ms 为准。
+    if (latest && st.seq <= latest->state.seq && st.ts_ms <= latest->state.ts_ms) return;
+    latest = Entry{st, now_monotonic_ms()};
+}
+
+std::optional<ArmStateCache::Entry> ArmStateCache::get() {
+    std::lock_guard<std::mutex> lock(mu);
+    return latest;
+}
+
 bool prefer_err_code_success(const std::string& ok, const std::string& err_code) {
     if (!err_code.empty()) {
         return err_code == "0";
@@ -74,10 +94,41 @@ bool is_truthy(const std::string& v) {
     return (v == "1" || v == "true" || v == "TRUE" || v == "yes" || v == "YES");
 }
 
-std::string kv_get_or(const EventDTOUtil::KvMap& kv, const char* key, const std::string& def) {
-    auto it = kv.find(key);
-    if (it == kv.end()) return def;
-    return it->second;
+std::string ArmResp::get_or(std::string_view key, const std::string& def) const {
+    namespace wire = wxz::workstation::arm_control::wire;
+    if (v2) {
+        const wire::StatusV2& st = *v2;
+        if (key == "value") return st.has(wire::StatusV2::kHasValue) ? (st.has(wire::StatusV2::kValue) ? "1" : "0") : def;
+        if (key == "jointpos") return st.has(wire::StatusV2::kHasJoints) ? wire::format_csv6_fixed(st.jointpos) : def;
+        if (key == "jointpos_deg") {
+            return st.has(wire::StatusV2::kHasJoints) ? wire::format_csv6_fixed(st.jointpos_deg) : def;
+        }
+        if (key == "id") return st.id.view().empty() ? def : std::string(st.id.view());
+        if (key == "op") {
+            return st.has(wire::StatusV2::kHasOp) ? std::string(wxz::workstation::arm_control::ops::op_desc(st.op).name) : def;
+        }
+        if (key == "ok") return ok;
+        if (key == "code") return code.empty() ? def : code;
+        if (key == "err_code") return err_code;
+        if (key == "err") return err.empty() ? def : err;
+        if (key == "sdk_code") return sdk_code.empty() ? def : sdk_code;
+        return def;
+    }
+    const wxz::workstation::KvView kv(payload);
+    const auto v = kv.find(key);
+    return v ? std::string(*v) : def;
+}
+
+ArmResp ArmResp::from_v2(const wxz::workstation::arm_control::wire::StatusV2& st) {
+    namespace wire = wxz::workstation::arm_control::wire;
+    ArmResp r;
+    r.ok = st.has(wire::StatusV2::kOk) ? "1" : "0";
+    r.err_code = std::to_string(st.err_code);
+    r.err = std::string(st.err.view());
+    if (st.has(wire::StatusV2::kHasCode)) r.code = std::to_string(st.code);
+    if (st.has(wire::StatusV2::kHasSdkCode)) r.sdk_code = std::to_string(st.sdk_code);
+    r.v2 = st;
+    return r;
 }
 
 }  // namespace wxz::workstation::bt_service
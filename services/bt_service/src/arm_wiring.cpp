@@ -11,7 +11,7 @@
 
 namespace wxz::workstation::bt_service {
 
-std::unique_ptr<wxz::workstation::EventDtoSubscription> setup_arm_control_bt(
+ArmControlSubscriptions setup_arm_control_bt(
     BT::BehaviorTreeFactory& factory,
     const AppConfig& cfg,
     wxz::workstation::Node& node,
@@ -19,31 +19,39 @@ std::unique_ptr<wxz::workstation::EventDtoSubscription> setup_arm_control_bt(
     wxz::core::Strand& arm_status_ingress_strand,
     std::size_t arm_status_pool_buffers,
     ArmRespCache& arm_cache,
+    ArmStateCache& arm_state_cache,
     TraceContext& trace_ctx) {
-    auto arm_status_sub = install_arm_status_cache_updater(node,
-                                                           cfg.arm.status_dto_topic,
-                                                           /*status_dto_schema=*/{},
-                                                           arm_status_ingress_strand,
-                                                           cfg.dto.max_payload,
-                                                           std::max<std::size_t>(1, arm_status_pool_buffers),
-                                                           arm_cache);
+    ArmControlSubscriptions subs;
+    subs.status = install_arm_status_cache_updater(node,
+                                                   cfg.arm.status_dto_topic,
+                                                   /*status_dto_schema=*/{},
+                                                   arm_status_ingress_strand,
+                                                   cfg.dto.max_payload,
+                                                   std::max<std::size_t>(1, arm_status_pool_buffers),
+                                                   arm_cache);
+    if (!cfg.arm.state_topic.empty()) {
+        subs.state = install_arm_state_cache_updater(node,
+                                                     cfg.arm.state_topic,
+                                                     arm_status_ingress_strand,
+                                                     cfg.dto.max_payload,
+                                                     arm_state_cache);
+    }
 
     register_arm_control_nodes(
         factory,
         ArmNodeDeps{
-            .arm_cmd_dto_pub = channels.arm_cmd_dto_pub.get(),
-            .arm_cmd_dto_topic = cfg.arm.cmd_dto_topic,
-            .arm_cmd_dto_schema = cfg.arm.cmd_dto_schema,
-            .system_alert_dto_pub = channels.system_alert_dto_pub.get(),
-            .system_alert_dto_topic = cfg.system_alert.dto_topic,
-            .system_alert_dto_schema = cfg.system_alert.dto_schema,
-            .dto_source = cfg.dto.source,
+            .arm_cmd_pub = channels.arm_cmd_tpl.get(),
+            .arm_cmd_wire_v2 = cfg.arm.wire_v2 != 0,
+            .system_alert_pub = channels.system_alert_tpl.get(),
             .arm_cache = &arm_cache,
             .arm_timeout_ms = cfg.arm.timeout_ms,
+            .arm_retransmit_ms = cfg.arm.retransmit_ms,
             .trace_ctx = &trace_ctx,
+            .arm_state = subs.state ? &arm_state_cache : nullptr,
+            .arm_state_max_age_ms = cfg.arm.state_max_age_ms,
         });
 
-    return arm_status_sub;
+    return subs;
 }
 
 }  // namespace wxz::workstation::bt_service
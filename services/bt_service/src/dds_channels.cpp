@@ -10,10 +10,23 @@ DdsChannels make_dds_channels(const AppConfig& cfg, wxz::workstation::Node& node
     DdsChannels ch;
 
     ch.arm_cmd_dto_pub = node.create_publisher_eventdto(cfg.arm.cmd_dto_topic, cfg.dto.max_payload);
+    if (ch.arm_cmd_dto_pub) {
+        ch.arm_cmd_tpl = std::make_unique<wxz::workstation::EventDtoTemplate>(
+            *ch.arm_cmd_dto_pub, cfg.arm.cmd_dto_topic, cfg.arm.cmd_dto_schema, cfg.dto.source);
+    }
 
     ch.system_alert_dto_pub = node.create_publisher_eventdto(cfg.system_alert.dto_topic, cfg.dto.max_payload);
+    if (ch.system_alert_dto_pub) {
+        ch.system_alert_tpl = std::make_unique<wxz::workstation::EventDtoTemplate>(
+            *ch.system_alert_dto_pub, cfg.system_alert.dto_topic, cfg.system_alert.dto_schema, cfg.dto.source);
+    }
 
     return ch;
 }
 
+void DdsChannels::report_metrics(const std::string& scope) {
+    if (arm_cmd_tpl) arm_cmd_tpl->report_metrics("wxz.bt.arm_cmd_pub", scope);
+    if (system_alert_tpl) system_alert_tpl->report_metrics("wxz.bt.system_alert_pub", scope);
+}
+
 }  // namespace wxz::workstation::bt_service
@@ -9,8 +9,11 @@ namespace wxz::workstation::bt_service {
 
 void run_bt_main_loop(wxz::workstation::Node& node,
                       BtTreeRunner& tree_runner,
-                      int tick_ms) {
+                      int tick_ms,
+                      const std::function<void()>& on_report) {
     const auto tick_dur = std::chrono::milliseconds(tick_ms);
+    constexpr auto kReportPeriod = std::chrono::seconds(1);
+    auto next_report = std::chrono::steady_clock::now() + kReportPeriod;
     while (node.running()) {
         const auto loop_start = std::chrono::steady_clock::now();
 
@@ -19,6 +22,11 @@ void run_bt_main_loop(wxz::workstation::Node& node,
         tree_runner.maybe_reload();
         tree_runner.tick_once();
 
+        if (on_report && loop_start >= next_report) {
+            next_report = loop_start + kReportPeriod;
+            on_report();
+        }
+
         for (;;) {
             if (!node.running()) return;
             const auto now = std::chrono::steady_clock::now();
@@ -31,6 +31,7 @@ wxz::core::NodeBaseConfig make_bt_node_config(const AppConfig& cfg, const wxz::c
 
     nc.topics_pub = {cfg.arm.cmd_dto_topic, cfg.system_alert.dto_topic};
     nc.topics_sub = {cfg.arm.status_dto_topic};
+    if (!cfg.arm.state_topic.empty()) nc.topics_sub.push_back(cfg.arm.state_topic);
 
     nc.warn = [&](const std::string& m) { logger.log(wxz::core::LogLevel::Warn, m); };
 
@@ -1,5 +1,9 @@
 #include "rpc_control_plane.h"
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "app_config.h"
@@ -15,7 +19,7 @@ namespace wxz::workstation::bt_service {
 std::unique_ptr<wxz::workstation::RpcService> start_bt_rpc_control_plane(const AppConfig& cfg,
                                                                       wxz::workstation::Node& node,
                                                                       BtTreeRunner& tree_runner,
-                                                                      wxz::core::Strand& rpc_strand,
+                                                                      wxz::workstation::ExecLane& rpc_lane,
                                                                       wxz::core::Logger& logger) {
     if (!cfg.rpc.enable) return nullptr;
 
@@ -26,7 +30,7 @@ std::unique_ptr<wxz::workstation::RpcService> start_bt_rpc_control_plane(const A
         .metrics_scope(cfg.rpc.service_name);
 
     auto rpc_server = node.create_service_on(
-        rpc_strand,
+        rpc_lane.strand(),
         std::move(opts_builder).build());
 
     using Json = wxz::workstation::RpcService::Json;
@@ -43,14 +47,33 @@ std::unique_ptr<wxz::workstation::RpcService> start_bt_rpc_control_plane(const A
 
     rpc_server->add_ping_handler("bt.ping");
 
-    rpc_server->add_handler("bt.reload", [&](const Json&) {
-        const auto r = tree_runner.reload_if_changed();
-        if (r == TreeReloadResult::Ok) {
-            tree_runner.configure_groot1(cfg.bt.groot);
-        }
+    // 行为树只在主循环线程上改动：RPC 跑在独占线程时，把 reload 投递到主 executor（主循环每 ≤5ms spin 一次）并等待。
+    auto reload_on_main = [&]() -> std::optional<TreeReloadResult> {
+        auto reload = [&tree_runner, &cfg] {
+            const auto r = tree_runner.reload_if_changed();
+            if (r == TreeReloadResult::Ok) {
+                tree_runner.configure_groot1(cfg.bt.groot);
+            }
+            return r;
+        };
+        if (!rpc_lane.dedicated()) return reload();
+
+        auto task = std::make_shared<std::packaged_task<TreeReloadResult()>>(reload);
+        auto result = task->get_future();
+        if (!node.executor().post([task] { (*task)(); })) return std::nullopt;
+        if (result.wait_for(std::chrono::seconds(5)) != std::future_status::ready) return std::nullopt;
+        return result.get();
+    };
+
+    rpc_server->add_handler("bt.reload", [&, reload_on_main](const Json&) {
         wxz::workstation::RpcService::Reply rep;
+        const auto r = reload_on_main();
+        if (!r) {
+            rep.status = wxz::workstation::Status::error(1, "main_loop_unavailable");
+            return rep;
+        }
         rep.status = wxz::workstation::Status::ok_status();
-        rep.result = Json{{"result", reload_result_to_string(r)}};
+        rep.result = Json{{"result", reload_result_to_string(*r)}};
         return rep;
     });
 